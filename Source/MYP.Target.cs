@@ -10,6 +10,6 @@ public class MYPTarget : TargetRules
 		Type = TargetType.Game;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_6;
-		ExtraModuleNames.Add("MYP");
+		ExtraModuleNames.AddRange(new string[] { "MYP", "MYPCombat", "MYPPlatforming", "MYPSideScrolling" });
 	}
 }
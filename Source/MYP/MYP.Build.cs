@@ -14,30 +14,20 @@ public class MYP : ModuleRules
 			"Engine",
 			"InputCore",
 			"EnhancedInput",
-			"AIModule",
-			"StateTreeModule",
-			"GameplayStateTreeModule",
 			"UMG",
 			"Slate"
 		});
 
-		PrivateDependencyModuleNames.AddRange(new string[] { });
+		PrivateDependencyModuleNames.AddRange(new string[] {
+			"Niagara",
+			"Json",
+			"RenderCore",
+			"Sockets"
+		});
 
+		// the variant gameplay code lives in the MYPCombat, MYPPlatforming and MYPSideScrolling modules
 		PublicIncludePaths.AddRange(new string[] {
-			"MYP",
-			"MYP/Variant_Platforming",
-			"MYP/Variant_Platforming/Animation",
-			"MYP/Variant_Combat",
-			"MYP/Variant_Combat/AI",
-			"MYP/Variant_Combat/Animation",
-			"MYP/Variant_Combat/Gameplay",
-			"MYP/Variant_Combat/Interfaces",
-			"MYP/Variant_Combat/UI",
-			"MYP/Variant_SideScrolling",
-			"MYP/Variant_SideScrolling/AI",
-			"MYP/Variant_SideScrolling/Gameplay",
-			"MYP/Variant_SideScrolling/Interfaces",
-			"MYP/Variant_SideScrolling/UI"
+			"MYP"
 		});
 		
 		// 모듈 포함 경로 정리: Public/Private 및 모듈 루트(MYP.h 접근) 추가
@@ -2,7 +2,28 @@
 
 #include "MYP.h"
 #include "Modules/ModuleManager.h"
+#include "MYPFrameArena.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, MYP, "MYP" );
+/**
+ *  Primary game module. Sets up the frame arena
+ */
+class FMYPModule : public FDefaultGameModuleImpl
+{
+public:
 
-DEFINE_LOG_CATEGORY(MYPLog)
\ No newline at end of file
+	virtual void StartupModule() override
+	{
+		FMYPFrameArena::Startup();
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FMYPFrameArena::Shutdown();
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FMYPModule, MYP, "MYP" );
+
+DEFINE_LOG_CATEGORY(MYPLog)
+
+DEFINE_STAT(STAT_MYPBlueprintEvents);
\ No newline at end of file
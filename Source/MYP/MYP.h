@@ -3,9 +3,19 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
 
 /** Main log category used across the project */
-DECLARE_LOG_CATEGORY_EXTERN(MYPLog, Log, All);
+MYP_API DECLARE_LOG_CATEGORY_EXTERN(MYPLog, Log, All);
+
+/** Stat group for project-level gameplay systems. Use 'stat MYP' to display it */
+DECLARE_STATS_GROUP(TEXT("MYP"), STATGROUP_MYP, STATCAT_Advanced);
+
+/** Calls made into the Blueprint VM from native MYP code this frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Blueprint Events Called"), STAT_MYPBlueprintEvents, STATGROUP_MYP, MYP_API);
+
+/** Counts a Blueprint event call. Place it right before calling a BlueprintImplementableEvent or BlueprintNativeEvent */
+#define MYP_COUNT_BLUEPRINT_EVENT() INC_DWORD_STAT(STAT_MYPBlueprintEvents)
 
 /*
 - DECLARE_LOG_CATEGORY_EXTERN(Name, DefaultVerbosity, CompileTimeVerbosity):
@@ -10,8 +10,11 @@
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
+#include "MYPTickAudit.h"
 #include "MYP.h"
 
+MYP_AUDIT_TICK(AMYPCharacter);
+
 AMYPCharacter::AMYPCharacter()
 {
 	// Set size for collision capsule
@@ -2,12 +2,15 @@
 
 
 #include "ForBuildTest.h"
+#include "MYPTickAudit.h"
+
+MYP_AUDIT_TICK(AForBuildTest);
 
 // Sets default values
 AForBuildTest::AForBuildTest()
 {
- 	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+ 	// Nothing here needs to run every frame
+	PrimaryActorTick.bCanEverTick = false;
 
 }
 
@@ -18,13 +21,6 @@ void AForBuildTest::BeginPlay()
 	
 }
 
-// Called every frame
-void AForBuildTest::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-}
-
 // Called to bind functionality to input
 void AForBuildTest::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
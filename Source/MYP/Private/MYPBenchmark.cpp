@@ -0,0 +1,433 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPBenchmark.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "UObject/UObjectGlobals.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "MYPFrameArena.h"
+#include "MYPHeadlessWorld.h"
+#include "MYPRandomSubsystem.h"
+#include "MYP.h"
+
+#if MYP_WITH_BENCHMARKS
+
+static FAutoConsoleCommand MYPBenchmarkRunCommand(
+	TEXT("MYP.Benchmark.Run"),
+	TEXT("Runs the gameplay benchmark suites, each in its own empty world, and writes the results as JSON.\n")
+	TEXT("Suite=<filter> runs only the matching suites. Warmup=<n> and Iterations=<n> set the iteration counts.\n")
+	TEXT("Seed=<n> seeds every world's random streams, and defaults to -MYPSeed, or 0 without it.\n")
+	TEXT("Output=<file> sets the results file, which defaults to Saved/Benchmarks. Label=<text> is stored with the results, usually the commit.\n")
+	TEXT("Baseline=<file> logs the change against earlier results. Launch with -llm to also record the heap memory each benchmark keeps per iteration,\n")
+	TEXT("or with -trace=default,memory to count each benchmark's allocations in Memory Insights, between its bookmarks."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString Params = FString::Join(Args, TEXT(" "));
+
+		FMYPBenchmarkSettings Settings;
+		FParse::Value(*Params, TEXT("Warmup="), Settings.WarmupIterations);
+		FParse::Value(*Params, TEXT("Iterations="), Settings.Iterations);
+
+		// a seed on the command line applies to every world, so take it unless one was given here
+		if (!FParse::Value(*Params, TEXT("Seed="), Settings.Seed))
+		{
+			UMYPRandomSubsystem::GetCommandLineSeed(Settings.Seed);
+		}
+
+		FString SuiteFilter;
+		FParse::Value(*Params, TEXT("Suite="), SuiteFilter);
+
+		FString Label;
+		FParse::Value(*Params, TEXT("Label="), Label);
+
+		FString Output = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("MYPBenchmarks-%s.json"), *FDateTime::Now().ToString());
+		FParse::Value(*Params, TEXT("Output="), Output);
+
+		TArray<FMYPBenchmarkResult> Results;
+
+		if (!FMYPBenchmarkRunner::Run(SuiteFilter, Settings, Results))
+		{
+			UE_LOG(MYPLog, Error, TEXT("No benchmark suite matches '%s'"), *SuiteFilter);
+			return;
+		}
+
+		FMYPBenchmarkRunner::SaveResults(Output, Label, Settings, Results);
+
+		FString BaselineFile;
+
+		if (FParse::Value(*Params, TEXT("Baseline="), BaselineFile))
+		{
+			TArray<FMYPBenchmarkResult> Baseline;
+
+			if (FMYPBenchmarkRunner::LoadResults(BaselineFile, Baseline))
+			{
+				FMYPBenchmarkRunner::LogComparison(Results, Baseline);
+			}
+		}
+	}));
+
+namespace MYPBenchmark
+{
+	/** Registered suites */
+	static FMYPBenchmarkSuite* FirstSuite = nullptr;
+
+	/** Returns the value at the given fraction of the sorted samples */
+	static double Percentile(const TArray<double>& SortedSamples, double Fraction)
+	{
+		const int32 Index = FMath::Clamp(FMath::CeilToInt32(Fraction * SortedSamples.Num()) - 1, 0, SortedSamples.Num() - 1);
+		return SortedSamples[Index];
+	}
+
+	/** Returns true if heap memory is being tracked */
+	static bool IsTrackingHeap()
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		return FLowLevelMemTracker::IsEnabled();
+#else
+		return false;
+#endif
+	}
+
+	/** Returns the heap memory currently tracked by LLM, or zero if it isn't tracking */
+	static int64 GetTrackedHeapBytes()
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		if (FLowLevelMemTracker::IsEnabled())
+		{
+			// LLM gathers each thread's allocations into the tag totals when it updates, so bring them up to date first
+			FLowLevelMemTracker::Get().UpdateStatsPerFrame();
+			return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, ELLMTag::Total);
+		}
+#endif
+
+		return 0;
+	}
+}
+
+FMYPBenchmarkSuite::FMYPBenchmarkSuite(const TCHAR* InName, FRunFunction InRun)
+	: Name(InName)
+	, Run(InRun)
+{
+	Next = MYPBenchmark::FirstSuite;
+	MYPBenchmark::FirstSuite = this;
+}
+
+FMYPBenchmarkSuite::~FMYPBenchmarkSuite()
+{
+	for (FMYPBenchmarkSuite** Link = &MYPBenchmark::FirstSuite; *Link; Link = &(*Link)->Next)
+	{
+		if (*Link == this)
+		{
+			*Link = Next;
+			break;
+		}
+	}
+}
+
+FMYPBenchmarkContext::FMYPBenchmarkContext(const TCHAR* InSuiteName, UWorld* InWorld, const FMYPBenchmarkSettings& InSettings, TArray<FMYPBenchmarkResult>& InResults)
+	: SuiteName(InSuiteName)
+	, World(InWorld)
+	, Settings(InSettings)
+	, Results(InResults)
+{
+}
+
+void FMYPBenchmarkContext::Measure(const FString& Name, TFunctionRef<void()> Setup, TFunctionRef<void()> Body, TFunctionRef<void()> Teardown)
+{
+	FMYPBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+	Result.Name = FString::Printf(TEXT("%s.%s"), SuiteName, *Name);
+	Result.Iterations = FMath::Max(Settings.Iterations, 1);
+
+	UE_LOG(MYPLog, Display, TEXT("Measuring %s"), *Result.Name);
+
+	for (int32 Iteration = 0; Iteration < Settings.WarmupIterations; ++Iteration)
+	{
+		// nothing runs until the end of the frame, so rewind the frame arena after every iteration
+		FMYPFrameArenaMark ArenaMark;
+
+		Setup();
+		Body();
+		Teardown();
+	}
+
+	TArray<double> Samples;
+	Samples.Reserve(Result.Iterations);
+
+	const bool bTrackingHeap = MYPBenchmark::IsTrackingHeap();
+	int64 HeapBytes = 0;
+
+	// bracket the timed iterations, setup and teardown included, so Memory Insights can count the allocations they made
+	TRACE_BOOKMARK(TEXT("MYP.Benchmark %s"), *Result.Name);
+
+	for (int32 Iteration = 0; Iteration < Result.Iterations; ++Iteration)
+	{
+		FMYPFrameArenaMark ArenaMark;
+
+		Setup();
+
+		// sample the heap outside the timed section, updating LLM isn't free
+		const int64 StartHeapBytes = bTrackingHeap ? MYPBenchmark::GetTrackedHeapBytes() : 0;
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		Body();
+
+		const uint64 EndCycles = FPlatformTime::Cycles64();
+
+		if (bTrackingHeap)
+		{
+			HeapBytes += MYPBenchmark::GetTrackedHeapBytes() - StartHeapBytes;
+		}
+
+		Samples.Add(FPlatformTime::ToMilliseconds64(EndCycles - StartCycles) * 1000.0);
+
+		Teardown();
+	}
+
+	TRACE_BOOKMARK(TEXT("MYP.Benchmark %s done"), *Result.Name);
+
+	// summarize the samples
+	Samples.Sort();
+
+	double Sum = 0.0;
+
+	for (const double Sample : Samples)
+	{
+		Sum += Sample;
+	}
+
+	Result.MeanMicroseconds = Sum / Samples.Num();
+	Result.MedianMicroseconds = MYPBenchmark::Percentile(Samples, 0.5);
+	Result.P95Microseconds = MYPBenchmark::Percentile(Samples, 0.95);
+	Result.MinMicroseconds = Samples[0];
+	Result.MaxMicroseconds = Samples.Last();
+
+	double SquaredDeviations = 0.0;
+
+	for (const double Sample : Samples)
+	{
+		SquaredDeviations += FMath::Square(Sample - Result.MeanMicroseconds);
+	}
+
+	Result.StdDevMicroseconds = FMath::Sqrt(SquaredDeviations / Samples.Num());
+	Result.HeapBytesPerIteration = double(HeapBytes) / Samples.Num();
+
+	UE_LOG(MYPLog, Display, TEXT("  median %.2f us, p95 %.2f us, mean %.2f us +- %.2f, heap %.0f bytes"), Result.MedianMicroseconds, Result.P95Microseconds, Result.MeanMicroseconds, Result.StdDevMicroseconds, Result.HeapBytesPerIteration);
+}
+
+void FMYPBenchmarkContext::Measure(const FString& Name, TFunctionRef<void()> Body)
+{
+	Measure(Name, [](){}, Body, [](){});
+}
+
+void FMYPBenchmarkContext::TickWorld(float DeltaSeconds)
+{
+	FMYPFrameArenaMark ArenaMark;
+
+	// the engine loop isn't running, so advance the frame counter for anything that keys off it
+	++GFrameCounter;
+
+	World->Tick(LEVELTICK_All, DeltaSeconds);
+}
+
+AActor* FMYPBenchmarkContext::SpawnFloor(float HalfExtent)
+{
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+	// the engine cube is 100 units across
+	AStaticMeshActor* Floor = World->SpawnActor<AStaticMeshActor>(FVector(0.0f, 0.0f, -50.0f), FRotator::ZeroRotator);
+
+	if (Floor && Cube)
+	{
+		// static components can't change mesh once they've been registered in a game world
+		Floor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+		Floor->GetStaticMeshComponent()->SetStaticMesh(Cube);
+		Floor->SetActorScale3D(FVector(HalfExtent / 50.0f, HalfExtent / 50.0f, 1.0f));
+	}
+
+	return Floor;
+}
+
+AActor* FMYPBenchmarkContext::SpawnActor(UClass* Class, const FVector& Location, const FRotator& Rotation)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	return World->SpawnActor<AActor>(Class, Location, Rotation, SpawnParams);
+}
+
+UClass* FMYPBenchmarkContext::LoadBlueprintClass(const TCHAR* Path, UClass* BaseClass) const
+{
+	UClass* Class = ::LoadClass<UObject>(nullptr, Path);
+
+	if (!Class || !Class->IsChildOf(BaseClass))
+	{
+		UE_LOG(MYPLog, Warning, TEXT("%s: couldn't load %s as a %s, skipping the benchmarks that need it"), SuiteName, Path, *BaseClass->GetName());
+		return nullptr;
+	}
+
+	return Class;
+}
+
+bool FMYPBenchmarkRunner::Run(const FString& SuiteFilter, const FMYPBenchmarkSettings& Settings, TArray<FMYPBenchmarkResult>& OutResults)
+{
+	int32 NumSuites = 0;
+
+	for (FMYPBenchmarkSuite* Suite = MYPBenchmark::FirstSuite; Suite; Suite = Suite->Next)
+	{
+		if (!SuiteFilter.IsEmpty() && !FCString::Stristr(Suite->Name, *SuiteFilter))
+		{
+			continue;
+		}
+
+		UE_LOG(MYPLog, Display, TEXT("Running benchmark suite %s"), Suite->Name);
+
+		{
+			FMYPHeadlessWorld World(FName(*FString::Printf(TEXT("MYPBenchmark_%s"), Suite->Name)));
+
+			if (UMYPRandomSubsystem* Random = UMYPRandomSubsystem::Get(World.GetWorld()))
+			{
+				Random->SetWorldSeed(Settings.Seed);
+			}
+
+			World.BeginPlay();
+
+			FMYPBenchmarkContext Context(Suite->Name, World.GetWorld(), Settings, OutResults);
+			Suite->Run(Context);
+		}
+
+		// reclaim the suite's world before the next one is made
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		++NumSuites;
+	}
+
+	return NumSuites > 0;
+}
+
+bool FMYPBenchmarkRunner::SaveResults(const FString& Filename, const FString& Label, const FMYPBenchmarkSettings& Settings, TConstArrayView<FMYPBenchmarkResult> Results)
+{
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+
+	// describe what the results were measured on, so unlike runs aren't compared by accident
+	Root->SetStringField(TEXT("Label"), Label);
+	Root->SetStringField(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+	Root->SetStringField(TEXT("Configuration"), LexToString(FApp::GetBuildConfiguration()));
+	Root->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+	Root->SetStringField(TEXT("Machine"), FPlatformProcess::ComputerName());
+	Root->SetStringField(TEXT("CPU"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+	Root->SetNumberField(TEXT("WarmupIterations"), Settings.WarmupIterations);
+	Root->SetNumberField(TEXT("Seed"), Settings.Seed);
+	Root->SetBoolField(TEXT("TrackingHeap"), MYPBenchmark::IsTrackingHeap());
+
+	TArray<TSharedPtr<FJsonValue>> ResultValues;
+
+	for (const FMYPBenchmarkResult& Result : Results)
+	{
+		TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+		ResultObject->SetStringField(TEXT("Name"), Result.Name);
+		ResultObject->SetNumberField(TEXT("Iterations"), Result.Iterations);
+		ResultObject->SetNumberField(TEXT("MeanUs"), Result.MeanMicroseconds);
+		ResultObject->SetNumberField(TEXT("MedianUs"), Result.MedianMicroseconds);
+		ResultObject->SetNumberField(TEXT("P95Us"), Result.P95Microseconds);
+		ResultObject->SetNumberField(TEXT("MinUs"), Result.MinMicroseconds);
+		ResultObject->SetNumberField(TEXT("MaxUs"), Result.MaxMicroseconds);
+		ResultObject->SetNumberField(TEXT("StdDevUs"), Result.StdDevMicroseconds);
+		ResultObject->SetNumberField(TEXT("HeapBytesPerIteration"), Result.HeapBytesPerIteration);
+
+		ResultValues.Add(MakeShared<FJsonValueObject>(ResultObject));
+	}
+
+	Root->SetArrayField(TEXT("Results"), ResultValues);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+	if (!FJsonSerializer::Serialize(Root, Writer) || !FFileHelper::SaveStringToFile(Json, *Filename))
+	{
+		UE_LOG(MYPLog, Error, TEXT("Couldn't write the benchmark results to %s"), *Filename);
+		return false;
+	}
+
+	UE_LOG(MYPLog, Display, TEXT("Wrote %d benchmark results to %s"), Results.Num(), *FPaths::ConvertRelativePathToFull(Filename));
+	return true;
+}
+
+bool FMYPBenchmarkRunner::LoadResults(const FString& Filename, TArray<FMYPBenchmarkResult>& OutResults)
+{
+	OutResults.Reset();
+
+	FString Json;
+	TSharedPtr<FJsonObject> Root;
+
+	if (!FFileHelper::LoadFileToString(Json, *Filename) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+	{
+		UE_LOG(MYPLog, Error, TEXT("Couldn't read benchmark results from %s"), *Filename);
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* ResultValues = nullptr;
+
+	if (Root->TryGetArrayField(TEXT("Results"), ResultValues))
+	{
+		for (const TSharedPtr<FJsonValue>& ResultValue : *ResultValues)
+		{
+			const TSharedPtr<FJsonObject>* ResultObject = nullptr;
+
+			if (!ResultValue->TryGetObject(ResultObject))
+			{
+				continue;
+			}
+
+			FMYPBenchmarkResult& Result = OutResults.AddDefaulted_GetRef();
+			(*ResultObject)->TryGetStringField(TEXT("Name"), Result.Name);
+			(*ResultObject)->TryGetNumberField(TEXT("Iterations"), Result.Iterations);
+			(*ResultObject)->TryGetNumberField(TEXT("MeanUs"), Result.MeanMicroseconds);
+			(*ResultObject)->TryGetNumberField(TEXT("MedianUs"), Result.MedianMicroseconds);
+			(*ResultObject)->TryGetNumberField(TEXT("P95Us"), Result.P95Microseconds);
+			(*ResultObject)->TryGetNumberField(TEXT("MinUs"), Result.MinMicroseconds);
+			(*ResultObject)->TryGetNumberField(TEXT("MaxUs"), Result.MaxMicroseconds);
+			(*ResultObject)->TryGetNumberField(TEXT("StdDevUs"), Result.StdDevMicroseconds);
+			(*ResultObject)->TryGetNumberField(TEXT("HeapBytesPerIteration"), Result.HeapBytesPerIteration);
+		}
+	}
+
+	return true;
+}
+
+void FMYPBenchmarkRunner::LogComparison(TConstArrayView<FMYPBenchmarkResult> Results, TConstArrayView<FMYPBenchmarkResult> Baseline)
+{
+	UE_LOG(MYPLog, Display, TEXT("%-48s %12s %12s %8s %12s %12s"), TEXT("Benchmark"), TEXT("Median us"), TEXT("Baseline"), TEXT("Change"), TEXT("Heap bytes"), TEXT("Baseline"));
+
+	for (const FMYPBenchmarkResult& Result : Results)
+	{
+		const FMYPBenchmarkResult* BaselineResult = Baseline.FindByPredicate([&Result](const FMYPBenchmarkResult& Other) { return Other.Name == Result.Name; });
+
+		if (!BaselineResult)
+		{
+			UE_LOG(MYPLog, Display, TEXT("%-48s %12.2f %12s"), *Result.Name, Result.MedianMicroseconds, TEXT("new"));
+			continue;
+		}
+
+		const double Change = BaselineResult->MedianMicroseconds > 0.0 ? (Result.MedianMicroseconds / BaselineResult->MedianMicroseconds - 1.0) * 100.0 : 0.0;
+
+		UE_LOG(MYPLog, Display, TEXT("%-48s %12.2f %12.2f %+7.1f%% %12.0f %12.0f"), *Result.Name, Result.MedianMicroseconds, BaselineResult->MedianMicroseconds, Change, Result.HeapBytesPerIteration, BaselineResult->HeapBytesPerIteration);
+	}
+}
+
+#endif // MYP_WITH_BENCHMARKS
@@ -0,0 +1,9 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPBotInput.h"
+
+void IMYPBotInput::BotAction(FName Action, bool bPressed)
+{
+	// no actions by default
+}
@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPBotScript.h"
+#include "MYPBotInput.h"
+
+UMYPBotScript* UMYPBotScript::CreateWanderScript(UObject* Outer)
+{
+	UMYPBotScript* Script = NewObject<UMYPBotScript>(Outer, TEXT("WanderScript"));
+	Script->bLoop = true;
+
+	auto AddStep = [Script](EMYPBotStepType Type, const FVector2D& Input, const FVector2D& RandomInput, FName Action, float Duration, float RandomDuration)
+	{
+		FMYPBotStep& Step = Script->Steps.AddDefaulted_GetRef();
+		Step.Type = Type;
+		Step.Input = Input;
+		Step.RandomInput = RandomInput;
+		Step.Action = Action;
+		Step.Duration = Duration;
+		Step.RandomDuration = RandomDuration;
+	};
+
+	// turn somewhere between a hard left and a hard right
+	AddStep(EMYPBotStepType::Look, FVector2D::ZeroVector, FVector2D(180.0f, 0.0f), NAME_None, 0.5f, 0.0f);
+
+	// run that way for a while, drifting a little sideways
+	AddStep(EMYPBotStepType::Move, FVector2D(0.0f, 1.0f), FVector2D(0.3f, 0.0f), NAME_None, 1.5f, 2.0f);
+
+	// jump over whatever is in the way
+	AddStep(EMYPBotStepType::Press, FVector2D::ZeroVector, FVector2D::ZeroVector, MYPBotActions::Jump, 0.0f, 0.0f);
+	AddStep(EMYPBotStepType::Move, FVector2D(0.0f, 1.0f), FVector2D::ZeroVector, NAME_None, 0.3f, 0.0f);
+	AddStep(EMYPBotStepType::Release, FVector2D::ZeroVector, FVector2D::ZeroVector, MYPBotActions::Jump, 0.0f, 0.0f);
+
+	// dash forward
+	AddStep(EMYPBotStepType::Press, FVector2D::ZeroVector, FVector2D::ZeroVector, MYPBotActions::Dash, 0.0f, 0.0f);
+	AddStep(EMYPBotStepType::Release, FVector2D::ZeroVector, FVector2D::ZeroVector, MYPBotActions::Dash, 0.0f, 0.0f);
+
+	// throw a combo at whatever is in front
+	for (int32 Hit = 0; Hit < 3; ++Hit)
+	{
+		AddStep(EMYPBotStepType::Press, FVector2D::ZeroVector, FVector2D::ZeroVector, MYPBotActions::Attack, 0.0f, 0.0f);
+		AddStep(EMYPBotStepType::Release, FVector2D::ZeroVector, FVector2D::ZeroVector, MYPBotActions::Attack, 0.0f, 0.0f);
+		AddStep(EMYPBotStepType::Wait, FVector2D::ZeroVector, FVector2D::ZeroVector, NAME_None, 0.3f, 0.1f);
+	}
+
+	// idle for a moment before picking a new direction
+	AddStep(EMYPBotStepType::Wait, FVector2D::ZeroVector, FVector2D::ZeroVector, NAME_None, 0.2f, 1.0f);
+
+	return Script;
+}
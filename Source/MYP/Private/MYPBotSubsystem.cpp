@@ -0,0 +1,159 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPBotSubsystem.h"
+#include "MYPBotInput.h"
+#include "MYPBotScript.h"
+#include "MYPRandomSubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "MYP.h"
+
+UMYPBotSubsystem* UMYPBotSubsystem::Get(const UObject* WorldContextObject)
+{
+	return UMYPTickableWorldSubsystem::Get<UMYPBotSubsystem>(WorldContextObject);
+}
+
+bool UMYPBotSubsystem::IsBotClient()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("MYPBot"));
+}
+
+void UMYPBotSubsystem::TickBots(float DeltaTime)
+{
+	// nothing to play
+	if (Script->Steps.IsEmpty())
+	{
+		return;
+	}
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* Controller = It->Get();
+
+		if (!Controller || !Controller->IsLocalController())
+		{
+			continue;
+		}
+
+		IMYPBotInput* BotInput = Cast<IMYPBotInput>(Controller->GetPawn());
+
+		if (!BotInput)
+		{
+			continue;
+		}
+
+		FBotState& State = Bots.FindOrAdd(Controller);
+
+		// presses and releases take no time, so a frame can run through several steps. Stop at the first that holds the frame,
+		// or after one pass in case the script has nothing that does
+		for (int32 StepsRun = 0; !State.bFinished && State.TimeLeft <= 0.0f && StepsRun < Script->Steps.Num(); ++StepsRun)
+		{
+			StartNextStep(Controller, State);
+
+			if (State.bFinished)
+			{
+				break;
+			}
+
+			const FMYPBotStep& Step = Script->Steps[State.StepIndex];
+
+			if (Step.Type == EMYPBotStepType::Press || Step.Type == EMYPBotStepType::Release)
+			{
+				BotInput->BotAction(Step.Action, Step.Type == EMYPBotStepType::Press);
+			}
+		}
+
+		if (State.bFinished)
+		{
+			continue;
+		}
+
+		// hold the current step's input
+		const FMYPBotStep& Step = Script->Steps[State.StepIndex];
+
+		switch (Step.Type)
+		{
+		case EMYPBotStepType::Move:
+			BotInput->BotMove(State.Input.X, State.Input.Y);
+			break;
+
+		case EMYPBotStepType::Look:
+			BotInput->BotLook(State.Input.X * DeltaTime, State.Input.Y * DeltaTime);
+			break;
+
+		default:
+			break;
+		}
+
+		State.TimeLeft -= DeltaTime;
+	}
+}
+
+void UMYPBotSubsystem::StartNextStep(APlayerController* Controller, FBotState& State)
+{
+	++State.StepIndex;
+
+	if (!Script->Steps.IsValidIndex(State.StepIndex))
+	{
+		if (!Script->bLoop || Script->Steps.IsEmpty())
+		{
+			State.bFinished = true;
+			return;
+		}
+
+		State.StepIndex = 0;
+	}
+
+	const FMYPBotStep& Step = Script->Steps[State.StepIndex];
+
+	// each bot rolls from its controller's stream, so bots launched with different seeds don't move in lockstep
+	FRandomStream& Random = UMYPRandomSubsystem::GetStream(Controller);
+
+	State.Input.X = Step.Input.X + Random.FRandRange(-Step.RandomInput.X, Step.RandomInput.X);
+	State.Input.Y = Step.Input.Y + Random.FRandRange(-Step.RandomInput.Y, Step.RandomInput.Y);
+	State.TimeLeft = Step.Duration + Random.FRandRange(0.0f, Step.RandomDuration);
+}
+
+bool UMYPBotSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return IsBotClient() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UMYPBotSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FString ScriptPath;
+
+	if (FParse::Value(FCommandLine::Get(), TEXT("MYPBotScript="), ScriptPath))
+	{
+		Script = LoadObject<UMYPBotScript>(nullptr, *ScriptPath);
+
+		if (!Script)
+		{
+			UE_LOG(MYPLog, Error, TEXT("Couldn't load bot script %s, falling back to the wander script"), *ScriptPath);
+		}
+	}
+
+	if (!Script)
+	{
+		Script = UMYPBotScript::CreateWanderScript(this);
+	}
+
+	UE_LOG(MYPLog, Log, TEXT("%s running bot script %s"), *GetWorld()->GetName(), *Script->GetPathName());
+
+	// feed the input before the pawns move, like player input
+	SetupTick(&UMYPBotSubsystem::TickBots, TG_PrePhysics, TEXT("MYPBotSubsystem::TickBots"));
+}
+
+void UMYPBotSubsystem::Deinitialize()
+{
+	Bots.Empty();
+	Script = nullptr;
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,350 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPFXSubsystem.h"
+#include "MYPFeedbackEffect.h"
+#include "Engine/World.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraDataChannel.h"
+#include "NiagaraDataChannelAccessor.h"
+#include "NiagaraDataChannelFunctionLibrary.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "MYP.h"
+
+DECLARE_CYCLE_STAT(TEXT("FX Dispatch"), STAT_MYPFXDispatch, STATGROUP_MYP);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Records Written"), STAT_MYPFXRecordsWritten, STATGROUP_MYP);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Records Dropped"), STAT_MYPFXRecordsDropped, STATGROUP_MYP);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Pooled Spawns"), STAT_MYPFXPooledSpawns, STATGROUP_MYP);
+
+static TAutoConsoleVariable<int32> CVarMYPFXMaxRecordsPerFrame(
+	TEXT("MYP.FX.MaxRecordsPerFrame"),
+	512,
+	TEXT("Maximum number of data channel records, hits and trail samples combined, written per frame. Anything past it is dropped."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMYPFXMaxSpawnsPerFrame(
+	TEXT("MYP.FX.MaxSpawnsPerFrame"),
+	16,
+	TEXT("Maximum number of pooled particle systems spawned per frame, for effects without a data channel. Anything past it is dropped."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarMYPFXWriteToGPU(
+	TEXT("MYP.FX.WriteToGPU"),
+	true,
+	TEXT("If true, data channel records are made visible to GPU emitters as well as CPU ones. Always off when nothing can be rendered."),
+	ECVF_Default);
+
+/** Variables every data channel used by the FX subsystem must declare */
+namespace MYPFXChannelVariables
+{
+	static const FName Position(TEXT("Position"));
+	static const FName Direction(TEXT("Direction"));
+	static const FName Scale(TEXT("Scale"));
+	static const FName Color(TEXT("Color"));
+}
+
+UMYPFXSubsystem* UMYPFXSubsystem::Get(const UObject* WorldContextObject)
+{
+	return UMYPTickableWorldSubsystem::Get<UMYPFXSubsystem>(WorldContextObject);
+}
+
+void UMYPFXSubsystem::QueueEffect(const FMYPFeedbackEffect& Effect, const FVector& Location, const FRotator& Rotation)
+{
+	if (Effect.DataChannel)
+	{
+		QueueRecord(Effect.DataChannel, Location, Rotation.Vector(), Effect.EffectScale.GetMax(), Effect.EffectColor);
+	}
+	else if (Effect.Effect)
+	{
+		QueueSpawn(Effect.Effect, Location, Rotation, Effect.EffectScale);
+	}
+}
+
+void UMYPFXSubsystem::QueueRecord(UNiagaraDataChannelAsset* Channel, const FVector& Location, const FVector& Direction, float Scale, const FLinearColor& Color)
+{
+	if (!Channel)
+	{
+		return;
+	}
+
+	if (!HasRecordBudget())
+	{
+		INC_DWORD_STAT(STAT_MYPFXRecordsDropped);
+		return;
+	}
+
+	FEffectRecord& Record = Records.AddDefaulted_GetRef();
+	Record.Location = Location;
+	Record.Direction = FVector3f(Direction);
+	Record.Scale = Scale;
+	Record.Color = Color.ToFColor(true);
+	Record.ChannelIndex = GetChannelIndex(Channel);
+
+	EnableDispatch();
+}
+
+void UMYPFXSubsystem::QueueSpawn(UNiagaraSystem* System, const FVector& Location, const FRotator& Rotation, const FVector& Scale)
+{
+	if (!System)
+	{
+		return;
+	}
+
+	if (SpawnRequests.Num() >= CVarMYPFXMaxSpawnsPerFrame.GetValueOnGameThread())
+	{
+		INC_DWORD_STAT(STAT_MYPFXRecordsDropped);
+		return;
+	}
+
+	// systems are few, so a linear lookup is fine
+	int32 SystemIndex = SystemTable.Find(System);
+
+	if (SystemIndex == INDEX_NONE)
+	{
+		SystemIndex = SystemTable.Add(System);
+	}
+
+	FSpawnRequest& Request = SpawnRequests.AddDefaulted_GetRef();
+	Request.SystemIndex = SystemIndex;
+	Request.Location = Location;
+	Request.Rotation = Rotation;
+	Request.Scale = Scale;
+
+	EnableDispatch();
+}
+
+FMYPFXTrailHandle UMYPFXSubsystem::StartTrail(USceneComponent* Component, FName Socket, UNiagaraDataChannelAsset* Channel, const FLinearColor& Color)
+{
+	if (!Component || !Channel)
+	{
+		return FMYPFXTrailHandle();
+	}
+
+	// reuse a free slot if we have one
+	const int32 TrailIndex = FreeTrails.Num() > 0 ? FreeTrails.Pop(EAllowShrinking::No) : Trails.AddDefaulted();
+
+	FTrail& Trail = Trails[TrailIndex];
+	Trail.Component = Component;
+	Trail.Socket = Socket;
+	Trail.Color = Color.ToFColor(true);
+	Trail.ChannelIndex = GetChannelIndex(Channel);
+	Trail.bActive = true;
+
+	++NumActiveTrails;
+
+	EnableDispatch();
+
+	FMYPFXTrailHandle Handle;
+	Handle.Index = TrailIndex;
+	Handle.Serial = Trail.Serial;
+
+	return Handle;
+}
+
+void UMYPFXSubsystem::StopTrail(FMYPFXTrailHandle& Handle)
+{
+	if (Trails.IsValidIndex(Handle.Index))
+	{
+		FTrail& Trail = Trails[Handle.Index];
+
+		// make sure the handle still refers to this trail
+		if (Trail.bActive && Trail.Serial == Handle.Serial)
+		{
+			Trail.bActive = false;
+			Trail.Component.Reset();
+			++Trail.Serial;
+
+			FreeTrails.Add(Handle.Index);
+			--NumActiveTrails;
+		}
+	}
+
+	Handle.Invalidate();
+}
+
+int32 UMYPFXSubsystem::GetChannelIndex(UNiagaraDataChannelAsset* Channel)
+{
+	// only a handful of channels are ever used, so a linear lookup is fine
+	const int32 ChannelIndex = ChannelTable.Find(Channel);
+
+	return ChannelIndex != INDEX_NONE ? ChannelIndex : ChannelTable.Add(Channel);
+}
+
+bool UMYPFXSubsystem::HasRecordBudget() const
+{
+	return Records.Num() < CVarMYPFXMaxRecordsPerFrame.GetValueOnGameThread();
+}
+
+void UMYPFXSubsystem::EnableDispatch()
+{
+	SetTickEnabled(true);
+}
+
+void UMYPFXSubsystem::GatherTrailRecords()
+{
+	for (int32 TrailIndex = 0; TrailIndex < Trails.Num(); ++TrailIndex)
+	{
+		FTrail& Trail = Trails[TrailIndex];
+
+		if (!Trail.bActive)
+		{
+			continue;
+		}
+
+		// the component is gone, so free the slot. Its handle goes stale through the serial
+		const USceneComponent* Component = Trail.Component.Get();
+
+		if (!Component)
+		{
+			Trail.bActive = false;
+			++Trail.Serial;
+
+			FreeTrails.Add(TrailIndex);
+			--NumActiveTrails;
+			continue;
+		}
+
+		if (!HasRecordBudget())
+		{
+			INC_DWORD_STAT(STAT_MYPFXRecordsDropped);
+			continue;
+		}
+
+		// point the sample along the owner's travel direction
+		const AActor* Owner = Component->GetOwner();
+		const FVector Velocity = Owner ? Owner->GetVelocity() : FVector::ZeroVector;
+
+		FEffectRecord& Record = Records.AddDefaulted_GetRef();
+		Record.Location = Component->GetSocketLocation(Trail.Socket);
+		Record.Direction = FVector3f(Velocity.GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector));
+		Record.Color = Trail.Color;
+		Record.ChannelIndex = Trail.ChannelIndex;
+	}
+}
+
+void UMYPFXSubsystem::WriteRecords()
+{
+	if (Records.IsEmpty())
+	{
+		return;
+	}
+
+	const int32 NumChannels = ChannelTable.Num();
+
+	// count the records for each channel, and remember where each channel's first record is so its writer can find the right island
+	ChannelCounts.Reset();
+	ChannelCounts.SetNumZeroed(NumChannels);
+
+	ChannelCursors.Reset();
+	ChannelCursors.Init(INDEX_NONE, NumChannels);
+
+	for (int32 RecordIndex = 0; RecordIndex < Records.Num(); ++RecordIndex)
+	{
+		const int32 ChannelIndex = Records[RecordIndex].ChannelIndex;
+
+		if (ChannelCounts[ChannelIndex]++ == 0)
+		{
+			ChannelCursors[ChannelIndex] = RecordIndex;
+		}
+	}
+
+	// CPU emitters always see the records, so effects keep simulating when running without a renderer
+	const bool bVisibleToGPU = CVarMYPFXWriteToGPU.GetValueOnGameThread() && FApp::CanEverRender();
+
+	// open a single writer per channel for the whole frame
+	TArray<UNiagaraDataChannelWriter*, TInlineAllocator<8>> Writers;
+	Writers.SetNumZeroed(NumChannels);
+
+	for (int32 ChannelIndex = 0; ChannelIndex < NumChannels; ++ChannelIndex)
+	{
+		if (ChannelCounts[ChannelIndex] == 0 || !ChannelTable[ChannelIndex])
+		{
+			continue;
+		}
+
+		FNiagaraDataChannelSearchParameters SearchParams;
+		SearchParams.Location = Records[ChannelCursors[ChannelIndex]].Location;
+
+		Writers[ChannelIndex] = UNiagaraDataChannelLibrary::WriteToNiagaraDataChannel(this, ChannelTable[ChannelIndex], SearchParams, ChannelCounts[ChannelIndex], false, true, bVisibleToGPU, TEXT("MYPFXSubsystem"));
+
+		// the cursor now tracks the next free element in the writer
+		ChannelCursors[ChannelIndex] = 0;
+	}
+
+	// fill in the records
+	for (const FEffectRecord& Record : Records)
+	{
+		UNiagaraDataChannelWriter* Writer = Writers[Record.ChannelIndex];
+
+		if (!Writer)
+		{
+			continue;
+		}
+
+		const int32 ElementIndex = ChannelCursors[Record.ChannelIndex]++;
+
+		Writer->WritePosition(MYPFXChannelVariables::Position, ElementIndex, Record.Location);
+		Writer->WriteVector(MYPFXChannelVariables::Direction, ElementIndex, FVector(Record.Direction));
+		Writer->WriteFloat(MYPFXChannelVariables::Scale, ElementIndex, Record.Scale);
+		Writer->WriteLinearColor(MYPFXChannelVariables::Color, ElementIndex, FLinearColor(Record.Color));
+	}
+
+	INC_DWORD_STAT_BY(STAT_MYPFXRecordsWritten, Records.Num());
+}
+
+void UMYPFXSubsystem::SpawnQueued()
+{
+	for (const FSpawnRequest& Request : SpawnRequests)
+	{
+		if (UNiagaraSystem* System = SystemTable[Request.SystemIndex])
+		{
+			UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, System, Request.Location, Request.Rotation, Request.Scale, true, true, ENCPoolMethod::AutoRelease);
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_MYPFXPooledSpawns, SpawnRequests.Num());
+}
+
+void UMYPFXSubsystem::TickDispatch(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYPFXDispatch);
+
+	GatherTrailRecords();
+
+	WriteRecords();
+
+	SpawnQueued();
+
+	Records.Reset();
+	SpawnRequests.Reset();
+
+	// sleep until something else is queued
+	if (NumActiveTrails == 0)
+	{
+		SetTickEnabled(false);
+	}
+}
+
+void UMYPFXSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// dispatch at the end of the frame, once hits are resolved and meshes are posed for the trail sockets.
+	// The tick wakes up when something is queued
+	SetupTick(&UMYPFXSubsystem::TickDispatch, TG_PostUpdateWork, TEXT("MYPFXSubsystem::TickDispatch"), 0.0f, false);
+}
+
+void UMYPFXSubsystem::Deinitialize()
+{
+	// drop anything still queued
+	Records.Empty();
+	SpawnRequests.Empty();
+	Trails.Empty();
+	FreeTrails.Empty();
+	NumActiveTrails = 0;
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPFeedbackEffect.h"
+#include "MYPFXSubsystem.h"
+#include "NiagaraFunctionLibrary.h"
+#include "Kismet/GameplayStatics.h"
+#include "Sound/SoundBase.h"
+
+void FMYPFeedbackEffect::Play(const UObject* WorldContextObject, const FVector& Location, const FRotator& Rotation) const
+{
+	if (!WorldContextObject)
+	{
+		return;
+	}
+
+	// batch the particles with everything else played this frame
+	if (UMYPFXSubsystem* FX = UMYPFXSubsystem::Get(WorldContextObject))
+	{
+		FX->QueueEffect(*this, Location, Rotation);
+	}
+	else if (Effect)
+	{
+		// outside of game worlds there's no dispatcher, so spawn directly
+		UNiagaraFunctionLibrary::SpawnSystemAtLocation(WorldContextObject, Effect, Location, Rotation, EffectScale, true, true, ENCPoolMethod::AutoRelease);
+	}
+
+	if (Sound)
+	{
+		UGameplayStatics::PlaySoundAtLocation(WorldContextObject, Sound, Location, Rotation, VolumeMultiplier, PitchMultiplier);
+	}
+}
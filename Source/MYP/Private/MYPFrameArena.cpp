@@ -0,0 +1,40 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPFrameArena.h"
+#include "Misc/CoreDelegates.h"
+#include "MYP.h"
+
+DECLARE_MEMORY_STAT(TEXT("Frame Arena Bytes"), STAT_MYPFrameArenaBytes, STATGROUP_MYP);
+
+FDelegateHandle FMYPFrameArena::EndFrameHandle;
+
+void FMYPFrameArena::Startup()
+{
+	check(IsInGameThread());
+
+	// everything the game thread allocates until the end of the frame goes above this mark
+	FMYPFrameArena& Arena = Get();
+	Arena.FrameMark.Emplace(Arena);
+
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FMYPFrameArena::EndFrame);
+}
+
+void FMYPFrameArena::Shutdown()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+
+	Get().FrameMark.Reset();
+}
+
+void FMYPFrameArena::EndFrame()
+{
+	FMYPFrameArena& Arena = Get();
+
+	SET_MEMORY_STAT(STAT_MYPFrameArenaBytes, Arena.GetByteCount());
+
+	// rewind, and open the mark for the next frame
+	Arena.FrameMark.Reset();
+	Arena.FrameMark.Emplace(Arena);
+}
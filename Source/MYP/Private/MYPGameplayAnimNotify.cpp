@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPGameplayAnimNotify.h"
+#include "MYPGameplayTimelineComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Actor.h"
+
+void UMYPGameplayAnimNotify::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+{
+	// is there a gameplay timeline driving this animation?
+	if (const AActor* Owner = MeshComp->GetOwner())
+	{
+		if (const UMYPGameplayTimelineComponent* Timeline = Owner->FindComponentByClass<UMYPGameplayTimelineComponent>())
+		{
+			if (Timeline->IsDrivingAnimation(Animation))
+			{
+				// the timeline fires this notify on its own schedule
+				return;
+			}
+		}
+	}
+
+	// run the gameplay logic
+	FireGameplayNotify(MeshComp);
+}
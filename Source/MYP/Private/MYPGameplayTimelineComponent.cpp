@@ -0,0 +1,228 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPGameplayTimelineComponent.h"
+#include "MYPGameplayTimelineSubsystem.h"
+#include "MYPGameplayAnimNotify.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimInstance.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "MYPTickAudit.h"
+
+MYP_AUDIT_TICK(UMYPGameplayTimelineComponent);
+
+UMYPGameplayTimelineComponent::UMYPGameplayTimelineComponent()
+{
+	// the timeline is driven by scheduled events, so it never needs to tick
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UMYPGameplayTimelineComponent::PlayMontage(UAnimMontage* Montage, USkeletalMeshComponent* Mesh, float InPlayRate, float StartPosition)
+{
+	// stop driving the previous montage
+	Stop();
+
+	if (!Montage || !Mesh || InPlayRate <= 0.0f)
+	{
+		return;
+	}
+
+	// get the timeline subsystem
+	UMYPGameplayTimelineSubsystem* Subsystem = GetWorld()->GetSubsystem<UMYPGameplayTimelineSubsystem>();
+
+	if (!Subsystem)
+	{
+		return;
+	}
+
+	// get the precomputed timeline for this montage
+	TSharedPtr<const FMYPMontageTimeline> Timeline = Subsystem->GetMontageTimeline(Montage);
+
+	if (!Timeline.IsValid() || Timeline->Sections.IsEmpty())
+	{
+		return;
+	}
+
+	ActiveMontage = Montage;
+	ActiveMesh = Mesh;
+	ActiveTimeline = Timeline;
+	PlayRate = InPlayRate;
+
+	// start at the section containing the start position
+	SectionIndex = FMath::Max(0, Montage->GetSectionIndexFromPosition(StartPosition));
+
+	const FMYPMontageTimelineSection& Section = ActiveTimeline->Sections[SectionIndex];
+
+	// skip any notifies before the start position
+	NextNotifyIndex = Section.FirstNotify;
+
+	while (NextNotifyIndex < Section.FirstNotify + Section.NumNotifies && ActiveTimeline->Notifies[NextNotifyIndex].Time < StartPosition)
+	{
+		++NextNotifyIndex;
+	}
+
+	AnchorPosition = StartPosition;
+	AnchorTime = GetCurrentTime();
+
+	ScheduleNextEvent();
+}
+
+void UMYPGameplayTimelineComponent::JumpToSection(FName SectionName)
+{
+	if (!ActiveMontage)
+	{
+		return;
+	}
+
+	// find the section in the montage
+	const int32 NewSectionIndex = ActiveMontage->GetSectionIndex(SectionName);
+
+	if (ActiveTimeline->Sections.IsValidIndex(NewSectionIndex))
+	{
+		EnterSection(NewSectionIndex, GetCurrentTime());
+	}
+}
+
+void UMYPGameplayTimelineComponent::Stop(const UAnimMontage* Montage)
+{
+	if (Montage)
+	{
+		// ignore if we're driving a different montage
+		if (Montage != ActiveMontage)
+		{
+			return;
+		}
+
+		// montage end events can arrive after the same montage was played again, so only stop if it's really done
+		const USkeletalMeshComponent* Mesh = ActiveMesh.Get();
+		const UAnimInstance* AnimInstance = Mesh ? Mesh->GetAnimInstance() : nullptr;
+
+		if (AnimInstance && AnimInstance->Montage_IsPlaying(ActiveMontage))
+		{
+			return;
+		}
+	}
+
+	// cancel any scheduled event
+	if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+	{
+		Timers->ClearTimer(EventTimer);
+	}
+
+	ActiveMontage = nullptr;
+	ActiveMesh.Reset();
+	ActiveTimeline.Reset();
+	SectionIndex = INDEX_NONE;
+}
+
+bool UMYPGameplayTimelineComponent::IsDrivingAnimation(const UAnimSequenceBase* Animation) const
+{
+	return ActiveMontage && ActiveMontage == Animation;
+}
+
+void UMYPGameplayTimelineComponent::ScheduleNextEvent()
+{
+	UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this);
+
+	if (!Timers || !GetOwner())
+	{
+		Stop();
+		return;
+	}
+
+	const FMYPMontageTimelineSection& Section = ActiveTimeline->Sections[SectionIndex];
+
+	// the next event is either the next notify in this section, or the end of the section
+	const float TargetPosition = NextNotifyIndex < Section.FirstNotify + Section.NumNotifies ? ActiveTimeline->Notifies[NextNotifyIndex].Time : Section.EndTime;
+
+	ScheduledTime = AnchorTime + FMath::Max(0.0f, TargetPosition - AnchorPosition) / PlayRate;
+
+	// replace any previously scheduled event. The timer is owned by our actor so it goes away with it
+	Timers->ClearTimer(EventTimer);
+	EventTimer = Timers->SetTimer(GetOwner(), float(ScheduledTime - GetWorld()->GetTimeSeconds()), FSimpleDelegate::CreateUObject(this, &UMYPGameplayTimelineComponent::HandleEvent));
+}
+
+void UMYPGameplayTimelineComponent::HandleEvent()
+{
+	if (!ActiveMontage)
+	{
+		return;
+	}
+
+	// remember which event we're handling so we can tell if the notify schedules another one
+	const FMYPTimerHandle HandledTimer = EventTimer;
+
+	// stop if the montage is no longer playing, e.g. it was interrupted without telling us
+	USkeletalMeshComponent* Mesh = ActiveMesh.Get();
+	UAnimInstance* AnimInstance = Mesh ? Mesh->GetAnimInstance() : nullptr;
+
+	if (!AnimInstance || !AnimInstance->Montage_IsPlaying(ActiveMontage))
+	{
+		Stop();
+		return;
+	}
+
+	TGuardValue<bool> EventGuard(bHandlingEvent, true);
+
+	const FMYPMontageTimelineSection& Section = ActiveTimeline->Sections[SectionIndex];
+
+	// do we have a notify to fire?
+	if (NextNotifyIndex < Section.FirstNotify + Section.NumNotifies)
+	{
+		const FMYPMontageTimelineNotify& NextNotify = ActiveTimeline->Notifies[NextNotifyIndex];
+
+		// advance the timeline to the notify
+		AnchorPosition = NextNotify.Time;
+		AnchorTime = ScheduledTime;
+		++NextNotifyIndex;
+
+		// fire the gameplay logic. This may jump to another section or stop the timeline
+		NextNotify.Notify->FireGameplayNotify(Mesh);
+
+		// schedule the next event unless the notify already rescheduled or stopped us
+		if (EventTimer == HandledTimer && ActiveMontage)
+		{
+			ScheduleNextEvent();
+		}
+
+		return;
+	}
+
+	// we've reached the end of the section. Is there another section linked after it?
+	if (Section.NextSectionIndex == INDEX_NONE)
+	{
+		// the montage is done as far as gameplay is concerned
+		Stop();
+		return;
+	}
+
+	EnterSection(Section.NextSectionIndex, ScheduledTime);
+}
+
+void UMYPGameplayTimelineComponent::EnterSection(int32 NewSectionIndex, double Time)
+{
+	const FMYPMontageTimelineSection& Section = ActiveTimeline->Sections[NewSectionIndex];
+
+	// move to the start of the section
+	SectionIndex = NewSectionIndex;
+	NextNotifyIndex = Section.FirstNotify;
+	AnchorPosition = Section.StartTime;
+	AnchorTime = Time;
+
+	ScheduleNextEvent();
+}
+
+double UMYPGameplayTimelineComponent::GetCurrentTime() const
+{
+	// while handling an event, use its exact time so scheduling doesn't drift with the wheel resolution
+	return bHandlingEvent ? ScheduledTime : GetWorld()->GetTimeSeconds();
+}
+
+void UMYPGameplayTimelineComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// stop driving the montage
+	Stop();
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPGameplayTimelineSubsystem.h"
+#include "MYPGameplayAnimNotify.h"
+#include "Animation/AnimMontage.h"
+
+TSharedPtr<const FMYPMontageTimeline> UMYPGameplayTimelineSubsystem::GetMontageTimeline(const UAnimMontage* Montage)
+{
+	if (!Montage)
+	{
+		return nullptr;
+	}
+
+	// build the timeline the first time the montage is played
+	TSharedPtr<const FMYPMontageTimeline>& Timeline = MontageTimelines.FindOrAdd(Montage);
+
+	if (!Timeline.IsValid())
+	{
+		Timeline = BuildMontageTimeline(Montage);
+	}
+
+	return Timeline;
+}
+
+TSharedPtr<const FMYPMontageTimeline> UMYPGameplayTimelineSubsystem::BuildMontageTimeline(const UAnimMontage* Montage)
+{
+	TSharedPtr<FMYPMontageTimeline> Timeline = MakeShared<FMYPMontageTimeline>();
+
+	const int32 NumSections = Montage->CompositeSections.Num();
+
+	// collect the gameplay notifies per section
+	TArray<TArray<FMYPMontageTimelineNotify>> SectionNotifies;
+	SectionNotifies.SetNum(NumSections);
+
+	for (const FAnimNotifyEvent& NotifyEvent : Montage->Notifies)
+	{
+		if (UMYPGameplayAnimNotify* GameplayNotify = Cast<UMYPGameplayAnimNotify>(NotifyEvent.Notify))
+		{
+			const float TriggerTime = NotifyEvent.GetTriggerTime();
+			const int32 SectionIndex = Montage->GetSectionIndexFromPosition(TriggerTime);
+
+			if (SectionNotifies.IsValidIndex(SectionIndex))
+			{
+				SectionNotifies[SectionIndex].Add({ TriggerTime, GameplayNotify });
+			}
+		}
+	}
+
+	// flatten the sections and their sorted notifies
+	Timeline->Sections.SetNum(NumSections);
+
+	for (int32 SectionIndex = 0; SectionIndex < NumSections; ++SectionIndex)
+	{
+		FMYPMontageTimelineSection& Section = Timeline->Sections[SectionIndex];
+
+		Montage->GetSectionStartAndEndTime(SectionIndex, Section.StartTime, Section.EndTime);
+		Section.NextSectionIndex = Montage->GetSectionIndex(Montage->CompositeSections[SectionIndex].NextSectionName);
+
+		TArray<FMYPMontageTimelineNotify>& Notifies = SectionNotifies[SectionIndex];
+		Notifies.StableSort([](const FMYPMontageTimelineNotify& A, const FMYPMontageTimelineNotify& B) { return A.Time < B.Time; });
+
+		Section.FirstNotify = Timeline->Notifies.Num();
+		Section.NumNotifies = Notifies.Num();
+
+		Timeline->Notifies.Append(Notifies);
+	}
+
+	return Timeline;
+}
+
+void UMYPGameplayTimelineSubsystem::Deinitialize()
+{
+	// release the cached timelines
+	MontageTimelines.Empty();
+
+	Super::Deinitialize();
+}
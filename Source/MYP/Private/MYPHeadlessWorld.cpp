@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPHeadlessWorld.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/WorldSettings.h"
+#include "Engine/LevelStreamingDynamic.h"
+#include "MYPFrameArena.h"
+#include "MYP.h"
+
+FMYPHeadlessWorld::FMYPHeadlessWorld(FName Name, const FString& LevelPath)
+{
+	World = UWorld::CreateWorld(EWorldType::Game, false, Name);
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	if (LevelPath.IsEmpty())
+	{
+		return;
+	}
+
+	// stream the level in as an instance, which gives it a package name unique to this world
+	bool bLoaded = false;
+	LevelInstance = ULevelStreamingDynamic::LoadLevelInstance(World, LevelPath, FVector::ZeroVector, FRotator::ZeroRotator, bLoaded);
+
+	if (!LevelInstance)
+	{
+		UE_LOG(MYPLog, Error, TEXT("%s: couldn't load the level %s"), *Name.ToString(), *LevelPath);
+		return;
+	}
+
+	// finish loading now, so the level's actors are there to be adjusted before play begins
+	World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+}
+
+FMYPHeadlessWorld::~FMYPHeadlessWorld()
+{
+	World->BeginTearingDown();
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+}
+
+bool FMYPHeadlessWorld::HasLevel() const
+{
+	return LevelInstance && LevelInstance->GetLoadedLevel();
+}
+
+void FMYPHeadlessWorld::BeginPlay()
+{
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	// there's no game mode to start the match, so begin play ourselves
+	if (!World->GetBegunPlay())
+	{
+		World->GetWorldSettings()->NotifyBeginPlay();
+	}
+}
+
+void FMYPHeadlessWorld::Tick(float DeltaSeconds)
+{
+	// the engine loop won't rewind the frame arena for us
+	FMYPFrameArenaMark ArenaMark;
+
+	World->Tick(LEVELTICK_All, DeltaSeconds);
+}
@@ -0,0 +1,370 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPLoadTestSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetConnection.h"
+#include "IPAddress.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "RenderTimer.h"
+#include "MYP.h"
+
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommandWithWorldAndArgs MYPLoadTestRunCommand(
+	TEXT("MYP.LoadTest.Run"),
+	TEXT("Ramps headless bot clients up against this server and measures its tick time and bandwidth at every client count.\n")
+	TEXT("Must run on a listen server, or a dedicated server started from the game or editor binary. Bots=<n> sets the bots to end with (default 100), Step=<n> the bots launched per step (default 1),\n")
+	TEXT("Interval=<s> the time between steps (default 10) and Settle=<s> the time to wait after the client count changes before sampling (default 2).\n")
+	TEXT("Script=<asset path> sets the bot script, Output=<file> the results file, which defaults to Saved/LoadTests."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UMYPLoadTestSubsystem* LoadTest = UMYPLoadTestSubsystem::Get(World);
+
+		if (!LoadTest)
+		{
+			UE_LOG(MYPLog, Error, TEXT("Load tests need a game world"));
+			return;
+		}
+
+		const FString Params = FString::Join(Args, TEXT(" "));
+
+		FMYPLoadTestSettings Settings;
+		FParse::Value(*Params, TEXT("Bots="), Settings.MaxBots);
+		FParse::Value(*Params, TEXT("Step="), Settings.BotsPerStep);
+		FParse::Value(*Params, TEXT("Interval="), Settings.StepInterval);
+		FParse::Value(*Params, TEXT("Settle="), Settings.SettleTime);
+		FParse::Value(*Params, TEXT("Script="), Settings.Script);
+
+		Settings.Output = FPaths::ProjectSavedDir() / TEXT("LoadTests") / FString::Printf(TEXT("MYPLoadTest-%s.json"), *FDateTime::Now().ToString());
+		FParse::Value(*Params, TEXT("Output="), Settings.Output);
+
+		LoadTest->StartTest(Settings);
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs MYPLoadTestStopCommand(
+	TEXT("MYP.LoadTest.Stop"),
+	TEXT("Ends the running load test early, closes its bot clients and reports what was measured so far."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UMYPLoadTestSubsystem* LoadTest = UMYPLoadTestSubsystem::Get(World))
+		{
+			LoadTest->StopTest();
+		}
+	}));
+
+#endif // !UE_BUILD_SHIPPING
+
+UMYPLoadTestSubsystem* UMYPLoadTestSubsystem::Get(const UObject* WorldContextObject)
+{
+	return UMYPTickableWorldSubsystem::Get<UMYPLoadTestSubsystem>(WorldContextObject);
+}
+
+bool UMYPLoadTestSubsystem::StartTest(const FMYPLoadTestSettings& InSettings)
+{
+	if (bRunning)
+	{
+		UE_LOG(MYPLog, Error, TEXT("A load test is already running"));
+		return false;
+	}
+
+#if UE_SERVER
+	// bots are launched from our own executable, and a server build can't run as a client
+	UE_LOG(MYPLog, Error, TEXT("Load tests can't run on a dedicated server build. Run the game or editor binary with -server instead"));
+	return false;
+#endif
+
+	// the bots need a server to join
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+
+	if (!NetDriver || !NetDriver->IsServer())
+	{
+		UE_LOG(MYPLog, Error, TEXT("Load tests must run on a listen or dedicated server. Open the map with ?listen, or run with -server"));
+		return false;
+	}
+
+	// the port the driver actually bound, which may not be the one the URL asked for if that was taken
+	const TSharedPtr<const FInternetAddr> LocalAddr = NetDriver->GetLocalAddr();
+
+	if (!LocalAddr.IsValid() || LocalAddr->GetPort() == 0)
+	{
+		UE_LOG(MYPLog, Error, TEXT("Couldn't find the port the server is listening on"));
+		return false;
+	}
+
+	ServerPort = LocalAddr->GetPort();
+
+	Settings = InSettings;
+	Settings.MaxBots = FMath::Max(Settings.MaxBots, 1);
+	Settings.BotsPerStep = FMath::Clamp(Settings.BotsPerStep, 1, Settings.MaxBots);
+
+	Samples.Reset();
+	TimeSinceStep = 0.0f;
+	TimeSinceClientsChanged = 0.0f;
+	LastClientCount = INDEX_NONE;
+	bRunning = true;
+
+	UE_LOG(MYPLog, Display, TEXT("Starting load test: %d bots, %d every %.1f s"), Settings.MaxBots, Settings.BotsPerStep, Settings.StepInterval);
+
+	LaunchBots(Settings.BotsPerStep);
+
+	SetTickEnabled(true);
+
+	return true;
+}
+
+void UMYPLoadTestSubsystem::StopTest()
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	bRunning = false;
+
+	SetTickEnabled(false);
+
+	CloseClients();
+
+	TArray<FMYPLoadTestStep> Steps;
+	Summarize(Steps);
+
+	UE_LOG(MYPLog, Display, TEXT("Load test results:"));
+	UE_LOG(MYPLog, Display, TEXT("  Clients  Frames  Mean ms   P95 ms   Max ms  Out KB/s   In KB/s  Out B/s per client"));
+
+	for (const FMYPLoadTestStep& Step : Steps)
+	{
+		UE_LOG(MYPLog, Display, TEXT("  %7d  %6d  %7.2f  %7.2f  %7.2f  %8.1f  %8.1f  %18.0f"),
+			Step.Clients, Step.Frames, Step.MeanTickMs, Step.P95TickMs, Step.MaxTickMs,
+			Step.MeanOutBytesPerSecond / 1024.0, Step.MeanInBytesPerSecond / 1024.0,
+			Step.Clients > 0 ? Step.MeanOutBytesPerSecond / Step.Clients : 0.0);
+	}
+
+	SaveResults(Settings.Output, Steps);
+}
+
+void UMYPLoadTestSubsystem::LaunchBots(int32 Count)
+{
+	// the editor binary needs to be told which project to run, and to run it as a game
+	FString BaseParams;
+
+#if WITH_EDITOR
+	BaseParams = FString::Printf(TEXT("\"%s\" -game "), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()));
+#endif
+
+	// join this server. A hundred clients share the machine with it, so cap their frame rate to leave the server its cores
+	BaseParams += FString::Printf(TEXT("127.0.0.1:%d -nullrhi -nosound -nosplash -unattended -MYPBot -ExecCmds=\"t.MaxFPS 30\""), ServerPort);
+
+	if (!Settings.Script.IsEmpty())
+	{
+		BaseParams += FString::Printf(TEXT(" -MYPBotScript=%s"), *Settings.Script);
+	}
+
+	Count = FMath::Min(Count, Settings.MaxBots - Clients.Num());
+
+	for (int32 Launched = 0; Launched < Count; ++Launched)
+	{
+		const int32 Bot = Clients.Num();
+
+		// give every bot its own seed and log, so their scripts play out differently and each run can be followed
+		const FString Params = FString::Printf(TEXT("%s -MYPSeed=%d -log=LoadTestBot%d.log"), *BaseParams, Bot + 1, Bot);
+
+		FProcHandle Handle = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Params, false, true, true, nullptr, 0, nullptr, nullptr);
+
+		if (!Handle.IsValid())
+		{
+			UE_LOG(MYPLog, Error, TEXT("Couldn't launch load test bot %d"), Bot);
+			continue;
+		}
+
+		Clients.Add(Handle);
+	}
+
+	UE_LOG(MYPLog, Display, TEXT("Launched %d of %d load test bots"), Clients.Num(), Settings.MaxBots);
+}
+
+void UMYPLoadTestSubsystem::TickTest(float DeltaTime)
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+
+	if (!NetDriver)
+	{
+		UE_LOG(MYPLog, Error, TEXT("The server's net driver went away, ending the load test"));
+		StopTest();
+		return;
+	}
+
+	// don't sample while bots are joining or leaving, the connection handshakes and map loads would skew the numbers
+	const int32 ClientCount = NetDriver->ClientConnections.Num();
+
+	if (ClientCount != LastClientCount)
+	{
+		LastClientCount = ClientCount;
+		TimeSinceClientsChanged = 0.0f;
+	}
+	else
+	{
+		TimeSinceClientsChanged += DeltaTime;
+	}
+
+	if (TimeSinceClientsChanged >= Settings.SettleTime)
+	{
+		FSamples& CountSamples = Samples.FindOrAdd(ClientCount);
+
+		// game thread time covers the whole server frame, without the wait for the next tick
+		CountSamples.TickMs.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+		CountSamples.OutBytesPerSecond += NetDriver->OutBytesPerSecond;
+		CountSamples.InBytesPerSecond += NetDriver->InBytesPerSecond;
+	}
+
+	TimeSinceStep += DeltaTime;
+
+	if (TimeSinceStep < Settings.StepInterval)
+	{
+		return;
+	}
+
+	TimeSinceStep = 0.0f;
+
+	// the last step has had its interval, so the ramp is done
+	if (Clients.Num() >= Settings.MaxBots)
+	{
+		StopTest();
+		return;
+	}
+
+	LaunchBots(Settings.BotsPerStep);
+}
+
+void UMYPLoadTestSubsystem::Summarize(TArray<FMYPLoadTestStep>& OutSteps) const
+{
+	OutSteps.Reset();
+
+	TArray<double> SortedTickMs;
+
+	for (const TPair<int32, FSamples>& CountSamples : Samples)
+	{
+		const FSamples& Sampled = CountSamples.Value;
+
+		if (Sampled.TickMs.IsEmpty())
+		{
+			continue;
+		}
+
+		FMYPLoadTestStep& Step = OutSteps.AddDefaulted_GetRef();
+		Step.Clients = CountSamples.Key;
+		Step.Frames = Sampled.TickMs.Num();
+
+		SortedTickMs = Sampled.TickMs;
+		SortedTickMs.Sort();
+
+		for (const double TickMs : SortedTickMs)
+		{
+			Step.MeanTickMs += TickMs;
+		}
+
+		Step.MeanTickMs /= Step.Frames;
+		Step.P95TickMs = SortedTickMs[FMath::Clamp(FMath::CeilToInt32(0.95 * Step.Frames) - 1, 0, Step.Frames - 1)];
+		Step.MaxTickMs = SortedTickMs.Last();
+		Step.MeanOutBytesPerSecond = Sampled.OutBytesPerSecond / Step.Frames;
+		Step.MeanInBytesPerSecond = Sampled.InBytesPerSecond / Step.Frames;
+	}
+
+	OutSteps.Sort([](const FMYPLoadTestStep& A, const FMYPLoadTestStep& B) { return A.Clients < B.Clients; });
+}
+
+bool UMYPLoadTestSubsystem::SaveResults(const FString& Filename, TConstArrayView<FMYPLoadTestStep> Steps) const
+{
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+	Root->SetStringField(TEXT("Machine"), FPlatformProcess::ComputerName());
+	Root->SetStringField(TEXT("Map"), GetWorld()->GetMapName());
+	Root->SetStringField(TEXT("NetMode"), GetWorld()->GetNetMode() == NM_DedicatedServer ? TEXT("DedicatedServer") : TEXT("ListenServer"));
+	Root->SetStringField(TEXT("Script"), Settings.Script);
+	Root->SetNumberField(TEXT("MaxBots"), Settings.MaxBots);
+	Root->SetNumberField(TEXT("BotsPerStep"), Settings.BotsPerStep);
+	Root->SetNumberField(TEXT("StepInterval"), Settings.StepInterval);
+
+	TArray<TSharedPtr<FJsonValue>> StepValues;
+
+	for (const FMYPLoadTestStep& Step : Steps)
+	{
+		TSharedRef<FJsonObject> StepObject = MakeShared<FJsonObject>();
+		StepObject->SetNumberField(TEXT("Clients"), Step.Clients);
+		StepObject->SetNumberField(TEXT("Frames"), Step.Frames);
+		StepObject->SetNumberField(TEXT("MeanTickMs"), Step.MeanTickMs);
+		StepObject->SetNumberField(TEXT("P95TickMs"), Step.P95TickMs);
+		StepObject->SetNumberField(TEXT("MaxTickMs"), Step.MaxTickMs);
+		StepObject->SetNumberField(TEXT("MeanOutBytesPerSecond"), Step.MeanOutBytesPerSecond);
+		StepObject->SetNumberField(TEXT("MeanInBytesPerSecond"), Step.MeanInBytesPerSecond);
+
+		StepValues.Add(MakeShared<FJsonValueObject>(StepObject));
+	}
+
+	Root->SetArrayField(TEXT("Steps"), StepValues);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+	if (!FJsonSerializer::Serialize(Root, Writer) || !FFileHelper::SaveStringToFile(Json, *Filename))
+	{
+		UE_LOG(MYPLog, Error, TEXT("Couldn't write the load test results to %s"), *Filename);
+		return false;
+	}
+
+	UE_LOG(MYPLog, Display, TEXT("Wrote load test results to %s"), *FPaths::ConvertRelativePathToFull(Filename));
+	return true;
+}
+
+void UMYPLoadTestSubsystem::CloseClients()
+{
+	for (FProcHandle& Client : Clients)
+	{
+		if (FPlatformProcess::IsProcRunning(Client))
+		{
+			FPlatformProcess::TerminateProc(Client, true);
+		}
+
+		FPlatformProcess::CloseProc(Client);
+	}
+
+	Clients.Empty();
+}
+
+bool UMYPLoadTestSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+	return false;
+#else
+	return Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+void UMYPLoadTestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// sample at the end of the frame, once the server has done its work. Only ticks while a test runs
+	SetupTick(&UMYPLoadTestSubsystem::TickTest, TG_PostUpdateWork, TEXT("MYPLoadTestSubsystem::TickTest"), 0.0f, false);
+}
+
+void UMYPLoadTestSubsystem::Deinitialize()
+{
+	// don't leave the bots running after the server goes away, and keep what was measured
+	StopTest();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPMapLoadStatsSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreGlobals.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "MYP.h"
+
+CSV_DEFINE_CATEGORY(MYPMaps, true);
+
+void UMYPMapLoadStatsSubsystem::HandlePreLoadMap(const FString& MapName)
+{
+	LoadStartTime = FPlatformTime::Seconds();
+	LoadStartUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	LoadingMapName = MapName;
+}
+
+void UMYPMapLoadStatsSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+	if (!LoadedWorld)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+
+	// maps loaded without a matching pre load event, e.g. in PIE, only report resident memory
+	const bool bHasLoadStart = !LoadingMapName.IsEmpty();
+	const double LoadTime = bHasLoadStart ? Now - LoadStartTime : 0.0;
+	const double MemoryDeltaMB = bHasLoadStart ? (double(MemoryStats.UsedPhysical) - double(LoadStartUsedPhysical)) / (1024.0 * 1024.0) : 0.0;
+
+	UE_LOG(MYPLog, Log, TEXT("Map %s loaded in %.2fs. Used physical %.1f MB (%+.1f MB), peak %.1f MB, %d UObjects"),
+		*LoadedWorld->GetMapName(),
+		LoadTime,
+		MemoryStats.UsedPhysical / (1024.0 * 1024.0),
+		MemoryDeltaMB,
+		MemoryStats.PeakUsedPhysical / (1024.0 * 1024.0),
+		GUObjectArray.GetObjectArrayNumMinusAvailable());
+
+	// the first map marks the end of startup
+	if (bFirstMap)
+	{
+		bFirstMap = false;
+
+		UE_LOG(MYPLog, Log, TEXT("Startup to first map took %.2fs"), Now - GStartTime);
+	}
+
+	CSV_EVENT(MYPMaps, TEXT("Loaded %s in %.2fs"), *LoadedWorld->GetMapName(), LoadTime);
+
+	LoadingMapName.Reset();
+}
+
+void UMYPMapLoadStatsSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &UMYPMapLoadStatsSubsystem::HandlePreLoadMap);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UMYPMapLoadStatsSubsystem::HandlePostLoadMap);
+}
+
+void UMYPMapLoadStatsSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	Super::Deinitialize();
+}
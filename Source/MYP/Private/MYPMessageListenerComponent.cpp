@@ -0,0 +1,43 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPMessageListenerComponent.h"
+#include "MYPMessageSubsystem.h"
+#include "MYPTickAudit.h"
+
+MYP_AUDIT_TICK(UMYPMessageListenerComponent);
+
+UMYPMessageListenerComponent::UMYPMessageListenerComponent()
+{
+	// messages are pushed to the component, so it never needs to tick
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UMYPMessageListenerComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UMYPMessageSubsystem* Messages = UMYPMessageSubsystem::Get(this))
+	{
+		// listen for the base message type, so any message on the channel gets through
+		for (const FName& Channel : Channels)
+		{
+			Messages->Subscribe<FMYPMessage>(Channel, this, &UMYPMessageListenerComponent::HandleMessage);
+		}
+	}
+}
+
+void UMYPMessageListenerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UMYPMessageSubsystem* Messages = UMYPMessageSubsystem::Get(this))
+	{
+		Messages->UnsubscribeAll(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UMYPMessageListenerComponent::HandleMessage(FName Channel, const FMYPMessage& Message)
+{
+	OnMessageReceived.Broadcast(Channel, Message.Instigator.Get());
+}
@@ -0,0 +1,272 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPMessageSubsystem.h"
+#include "Engine/World.h"
+#include "MYP.h"
+
+DECLARE_CYCLE_STAT(TEXT("Message Delivery"), STAT_MYPMessageDelivery, STATGROUP_MYP);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Messages Broadcast"), STAT_MYPMessagesBroadcast, STATGROUP_MYP);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Deferred Messages Delivered"), STAT_MYPDeferredMessages, STATGROUP_MYP);
+
+UMYPMessageSubsystem* UMYPMessageSubsystem::Get(const UObject* WorldContextObject)
+{
+	return UMYPTickableWorldSubsystem::Get<UMYPMessageSubsystem>(WorldContextObject);
+}
+
+FMYPMessageHandle UMYPMessageSubsystem::SubscribeMessage(FName Channel, const UScriptStruct* MessageType, UObject* Owner, FMYPMessageDelegate&& Callback)
+{
+	if (!MessageType || !Owner || !Callback.IsBound())
+	{
+		return FMYPMessageHandle();
+	}
+
+	FListener Listener;
+	Listener.Callback = MoveTemp(Callback);
+	Listener.MessageType = MessageType;
+	Listener.Owner = Owner;
+	Listener.Id = NextListenerId++;
+
+	FMYPMessageHandle Handle;
+	Handle.Channel = Channel;
+	Handle.Id = Listener.Id;
+
+	// don't grow a listener array while a broadcast may be walking it
+	if (BroadcastDepth > 0)
+	{
+		PendingListeners.Emplace(Channel, MoveTemp(Listener));
+	}
+	else
+	{
+		Channels.FindOrAdd(Channel).Add(MoveTemp(Listener));
+	}
+
+	return Handle;
+}
+
+void UMYPMessageSubsystem::Unsubscribe(FMYPMessageHandle& Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	const FName Channel = Handle.Channel;
+	const int32 Id = Handle.Id;
+	Handle.Invalidate();
+
+	// the subscription may still be waiting for the current broadcast to end
+	for (TPair<FName, FListener>& Pending : PendingListeners)
+	{
+		if (Pending.Value.Id == Id)
+		{
+			Pending.Value.Id = INDEX_NONE;
+			return;
+		}
+	}
+
+	if (TArray<FListener>* Listeners = Channels.Find(Channel))
+	{
+		const int32 ListenerIndex = Listeners->IndexOfByPredicate([Id](const FListener& Listener) { return Listener.Id == Id; });
+
+		if (ListenerIndex == INDEX_NONE)
+		{
+			return;
+		}
+
+		// the callback may be the one running right now, so only mark it while broadcasting
+		if (BroadcastDepth > 0)
+		{
+			(*Listeners)[ListenerIndex].Id = INDEX_NONE;
+			bNeedsCompaction = true;
+		}
+		else
+		{
+			Listeners->RemoveAt(ListenerIndex);
+		}
+	}
+}
+
+void UMYPMessageSubsystem::UnsubscribeAll(const UObject* Owner)
+{
+	const TObjectKey<UObject> OwnerKey(Owner);
+
+	for (TPair<FName, FListener>& Pending : PendingListeners)
+	{
+		if (Pending.Value.Owner == OwnerKey)
+		{
+			Pending.Value.Id = INDEX_NONE;
+		}
+	}
+
+	for (TPair<FName, TArray<FListener>>& Channel : Channels)
+	{
+		for (FListener& Listener : Channel.Value)
+		{
+			if (Listener.Owner == OwnerKey)
+			{
+				Listener.Id = INDEX_NONE;
+				bNeedsCompaction = true;
+			}
+		}
+	}
+
+	// compact right away unless a broadcast is running
+	if (BroadcastDepth == 0)
+	{
+		FlushListenerChanges();
+	}
+}
+
+void UMYPMessageSubsystem::BroadcastMessage(FName Channel, const UScriptStruct* MessageType, const FMYPMessage& Message)
+{
+	check(MessageType);
+
+	INC_DWORD_STAT(STAT_MYPMessagesBroadcast);
+
+	TArray<FListener>* Listeners = Channels.Find(Channel);
+
+	if (!Listeners)
+	{
+		return;
+	}
+
+	++BroadcastDepth;
+
+	// walk the listeners in place. New subscriptions are held back until the outermost broadcast ends, so the array can't move
+	for (int32 ListenerIndex = 0; ListenerIndex < Listeners->Num(); ++ListenerIndex)
+	{
+		FListener& Listener = (*Listeners)[ListenerIndex];
+
+		if (Listener.Id == INDEX_NONE)
+		{
+			continue;
+		}
+
+		if (!ensureMsgf(MessageType->IsChildOf(Listener.MessageType), TEXT("Message %s broadcast on channel %s, which has a listener for %s"), *MessageType->GetName(), *Channel.ToString(), *Listener.MessageType->GetName()))
+		{
+			continue;
+		}
+
+		// the owner is gone, so drop the listener
+		if (!Listener.Callback.ExecuteIfBound(Channel, Message))
+		{
+			Listener.Id = INDEX_NONE;
+			bNeedsCompaction = true;
+		}
+	}
+
+	--BroadcastDepth;
+
+	if (BroadcastDepth == 0 && (bNeedsCompaction || !PendingListeners.IsEmpty()))
+	{
+		FlushListenerChanges();
+	}
+}
+
+void UMYPMessageSubsystem::QueueMessage(FName Channel, const UScriptStruct* MessageType, const FMYPMessage& Message)
+{
+	check(MessageType);
+	check(MessageType->GetMinAlignment() <= 16);
+
+	// copy the message into the buffer, aligned for its type
+	const int32 Offset = Align(DeferredBuffer.Num(), MessageType->GetMinAlignment());
+	DeferredBuffer.SetNumUninitialized(Offset + MessageType->GetStructureSize(), EAllowShrinking::No);
+
+	uint8* MessageMemory = DeferredBuffer.GetData() + Offset;
+	MessageType->InitializeStruct(MessageMemory);
+	MessageType->CopyScriptStruct(MessageMemory, &Message);
+
+	FDeferredMessage& Deferred = DeferredMessages.AddDefaulted_GetRef();
+	Deferred.Channel = Channel;
+	Deferred.MessageType = MessageType;
+	Deferred.Offset = Offset;
+
+	// make sure the messages get delivered
+	SetTickEnabled(true);
+}
+
+void UMYPMessageSubsystem::FlushListenerChanges()
+{
+	// drop the removed listeners, keeping the subscription order
+	if (bNeedsCompaction)
+	{
+		for (auto It = Channels.CreateIterator(); It; ++It)
+		{
+			It.Value().RemoveAll([](const FListener& Listener) { return Listener.Id == INDEX_NONE; });
+
+			if (It.Value().IsEmpty())
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		bNeedsCompaction = false;
+	}
+
+	// add the listeners that subscribed during the broadcast
+	for (TPair<FName, FListener>& Pending : PendingListeners)
+	{
+		if (Pending.Value.Id != INDEX_NONE)
+		{
+			Channels.FindOrAdd(Pending.Key).Add(MoveTemp(Pending.Value));
+		}
+	}
+
+	PendingListeners.Reset();
+}
+
+void UMYPMessageSubsystem::ResetDeferred(TArray<FDeferredMessage>& Messages, FMessageBuffer& Buffer)
+{
+	for (const FDeferredMessage& Deferred : Messages)
+	{
+		Deferred.MessageType->DestroyStruct(Buffer.GetData() + Deferred.Offset);
+	}
+
+	Messages.Reset();
+	Buffer.Reset();
+}
+
+void UMYPMessageSubsystem::TickDeliver(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYPMessageDelivery);
+
+	// take the queue, so messages deferred by the listeners go out next frame
+	Swap(DeferredMessages, DeliveringMessages);
+	Swap(DeferredBuffer, DeliveringBuffer);
+
+	INC_DWORD_STAT_BY(STAT_MYPDeferredMessages, DeliveringMessages.Num());
+
+	for (const FDeferredMessage& Deferred : DeliveringMessages)
+	{
+		BroadcastMessage(Deferred.Channel, Deferred.MessageType, *reinterpret_cast<const FMYPMessage*>(DeliveringBuffer.GetData() + Deferred.Offset));
+	}
+
+	ResetDeferred(DeliveringMessages, DeliveringBuffer);
+
+	// sleep until something else is deferred
+	if (DeferredMessages.IsEmpty())
+	{
+		SetTickEnabled(false);
+	}
+}
+
+void UMYPMessageSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// deliver at the end of the frame, after damage and timers have had their say. Only tick while messages are deferred
+	SetupTick(&UMYPMessageSubsystem::TickDeliver, TG_PostUpdateWork, TEXT("MYPMessageSubsystem::TickDeliver"), 0.0f, false);
+}
+
+void UMYPMessageSubsystem::Deinitialize()
+{
+	// drop anything still queued, and all listeners
+	ResetDeferred(DeferredMessages, DeferredBuffer);
+	ResetDeferred(DeliveringMessages, DeliveringBuffer);
+
+	Channels.Empty();
+	PendingListeners.Empty();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPRandomSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Crc.h"
+#include "Misc/Parse.h"
+#include "MYP.h"
+
+UMYPRandomSubsystem* UMYPRandomSubsystem::Get(const UObject* WorldContextObject)
+{
+	return UMYPTickableWorldSubsystem::Get<UMYPRandomSubsystem>(WorldContextObject);
+}
+
+bool UMYPRandomSubsystem::GetCommandLineSeed(int32& OutSeed)
+{
+	return FParse::Value(FCommandLine::Get(), TEXT("MYPSeed="), OutSeed);
+}
+
+FRandomStream& UMYPRandomSubsystem::GetStream(const AActor* Actor)
+{
+	if (UMYPRandomSubsystem* Random = Get(Actor))
+	{
+		return Random->GetActorStream(Actor);
+	}
+
+	// editor preview worlds and the like don't need to be reproducible
+	static FRandomStream FallbackStream(FMath::Rand());
+	return FallbackStream;
+}
+
+void UMYPRandomSubsystem::SetWorldSeed(int32 NewSeed)
+{
+	WorldSeed = NewSeed;
+
+	// restart the existing streams from the new seed
+	for (TPair<TObjectKey<AActor>, FRandomStream>& Stream : Streams)
+	{
+		if (const AActor* Actor = Stream.Key.ResolveObjectPtr())
+		{
+			Stream.Value.Initialize(int32(HashCombineFast(uint32(WorldSeed), GetStableActorId(Actor))));
+		}
+	}
+}
+
+FRandomStream& UMYPRandomSubsystem::GetActorStream(const AActor* Actor)
+{
+	if (FRandomStream* Stream = Streams.Find(Actor))
+	{
+		return *Stream;
+	}
+
+	return Streams.Add(Actor, FRandomStream(int32(HashCombineFast(uint32(WorldSeed), GetStableActorId(Actor)))));
+}
+
+uint32 UMYPRandomSubsystem::GetStableActorId(const AActor* Actor)
+{
+	uint32* SpawnedId = SpawnedActorIds.Find(Actor);
+
+	// actors that were there before play began keep their names from run to run. Hash the string, FName indices aren't stable between processes
+	if (!SpawnedId)
+	{
+		return FCrc::StrCrc32(*Actor->GetName());
+	}
+
+	if (*SpawnedId != 0)
+	{
+		return *SpawnedId;
+	}
+
+	// number the actor among the spawns of its owner, which is stable as long as the owner's decisions are
+	const AActor* Owner = Actor->GetOwner();
+	const uint32 ParentId = Owner ? GetStableActorId(Owner) : FCrc::StrCrc32(*Actor->GetClass()->GetName());
+
+	uint32& SpawnCount = SpawnCounts.FindOrAdd(ParentId);
+
+	// zero means unassigned
+	const uint32 Id = FMath::Max(HashCombineFast(ParentId, SpawnCount++), 1u);
+
+	// getting the owner's ID may have grown the map, so don't write through the pointer found earlier
+	SpawnedActorIds.Add(Actor, Id);
+
+	return Id;
+}
+
+void UMYPRandomSubsystem::HandleActorPreSpawn(AActor* Actor)
+{
+	// an actor spawned while another is being initialized may take it over, as a pawn's controller does when it possesses it.
+	// Number the outer spawns first, while their owner is still the one they were spawned with
+	for (const TWeakObjectPtr<AActor>& SpawningActor : SpawningActors)
+	{
+		if (const AActor* OuterActor = SpawningActor.Get())
+		{
+			GetStableActorId(OuterActor);
+		}
+	}
+
+	SpawnedActorIds.Add(Actor, 0);
+	SpawningActors.Add(Actor);
+}
+
+void UMYPRandomSubsystem::HandleActorSpawned(AActor* Actor)
+{
+	SpawningActors.Remove(Actor);
+
+	// assigns the ID now, unless the actor already asked for a stream during its BeginPlay, or spawned something while it was initialized
+	GetStableActorId(Actor);
+}
+
+void UMYPRandomSubsystem::HandleActorDestroyed(AActor* Actor)
+{
+	SpawningActors.Remove(Actor);
+	SpawnedActorIds.Remove(Actor);
+	Streams.Remove(Actor);
+}
+
+void UMYPRandomSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// runs meant to be repeated pass the seed in. Otherwise pick one, and log it in case the run needs repeating after all
+	if (!GetCommandLineSeed(WorldSeed))
+	{
+		WorldSeed = int32(FPlatformTime::Cycles());
+	}
+
+	UWorld* World = GetWorld();
+
+	UE_LOG(MYPLog, Log, TEXT("%s random seed %d"), *World->GetName(), WorldSeed);
+
+	ActorPreSpawnHandle = World->AddOnActorPreSpawnInitialization(FOnActorSpawned::FDelegate::CreateUObject(this, &UMYPRandomSubsystem::HandleActorPreSpawn));
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UMYPRandomSubsystem::HandleActorSpawned));
+	ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &UMYPRandomSubsystem::HandleActorDestroyed));
+}
+
+void UMYPRandomSubsystem::Deinitialize()
+{
+	UWorld* World = GetWorld();
+
+	World->RemoveOnActorPreSpawnInitialization(ActorPreSpawnHandle);
+	World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+
+	SpawnedActorIds.Reset();
+	SpawnCounts.Reset();
+	SpawningActors.Reset();
+	Streams.Reset();
+
+	Super::Deinitialize();
+}
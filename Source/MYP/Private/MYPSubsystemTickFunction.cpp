@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPSubsystemTickFunction.h"
+
+void FMYPSubsystemTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	// pass the tick to the owning subsystem
+	TickDelegate.ExecuteIfBound(DeltaTime);
+
+	// keep a running average of the cost so tick dumps can show it
+	const double CostMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	AverageCostMs = FMath::Lerp(AverageCostMs, CostMs, 0.1);
+}
+
+FString FMYPSubsystemTickFunction::DiagnosticMessage()
+{
+	return FString::Printf(TEXT("%s (%.3f ms)"), *DiagnosticName, AverageCostMs);
+}
+
+FName FMYPSubsystemTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(*DiagnosticName);
+}
@@ -0,0 +1,338 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPTickAuditSubsystem.h"
+#include "MYPTickAudit.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Character.h"
+#include "Components/ActorComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "TickTaskManagerInterface.h"
+#include "HAL/IConsoleManager.h"
+#include "MYP.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Redundant Ticks Disabled"), STAT_MYPRedundantTicksDisabled, STATGROUP_MYP);
+
+static TAutoConsoleVariable<bool> CVarMYPTicksAutoDisable(
+	TEXT("MYP.Ticks.AutoDisable"),
+	false,
+	TEXT("If true, actor and component tick functions that do no work are unregistered once their actors have begun play."),
+	ECVF_Default);
+
+static FAutoConsoleCommandWithWorldAndArgs MYPTicksAuditCommand(
+	TEXT("MYP.Ticks.Audit"),
+	TEXT("Lists the actor and component tick functions registered in the current world and flags the ones that do no work. Pass 'all' to also dump every registered tick function with its diagnostics."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (const UMYPTickAuditSubsystem* TickAudit = World ? World->GetSubsystem<UMYPTickAuditSubsystem>() : nullptr)
+		{
+			TickAudit->LogAudit(Args.Contains(TEXT("all")));
+		}
+	}));
+
+namespace MYPNativeTicks
+{
+	/** A class registered with MYP_AUDIT_TICK. Registration runs during static init, before classes can be resolved */
+	struct FRegistration
+	{
+		UClass* (*StaticClassFunc)();
+		bool bOverridesTick;
+	};
+
+	static TArray<FRegistration>& GetRegistrations()
+	{
+		static TArray<FRegistration> Registrations;
+		return Registrations;
+	}
+}
+
+FMYPNativeTickRegistration::FMYPNativeTickRegistration(UClass* (*StaticClassFunc)(), bool bOverridesTick)
+{
+	MYPNativeTicks::GetRegistrations().Add({ StaticClassFunc, bOverridesTick });
+}
+
+bool FMYPNativeTickRegistration::FindOverridesTick(const UClass* Class, bool& bOutOverridesTick)
+{
+	// resolve the classes on first use, once the UObject system is up
+	static TMap<const UClass*, bool> RegisteredClasses;
+	static int32 NumResolved = 0;
+
+	TArray<MYPNativeTicks::FRegistration>& Registrations = MYPNativeTicks::GetRegistrations();
+
+	for (; NumResolved < Registrations.Num(); ++NumResolved)
+	{
+		RegisteredClasses.Add(Registrations[NumResolved].StaticClassFunc(), Registrations[NumResolved].bOverridesTick);
+	}
+
+	if (const bool* bOverridesTick = RegisteredClasses.Find(Class))
+	{
+		bOutOverridesTick = *bOverridesTick;
+		return true;
+	}
+
+	return false;
+}
+
+void UMYPTickAuditSubsystem::Audit(TArray<FMYPTickAuditEntry>& OutEntries) const
+{
+	OutEntries.Reset();
+
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		AActor* Actor = *It;
+
+		// add the actor tick
+		if (Actor->PrimaryActorTick.IsTickFunctionRegistered())
+		{
+			FillEntry(OutEntries.AddDefaulted_GetRef(), Actor, Actor->PrimaryActorTick);
+		}
+
+		// add the component ticks
+		TInlineComponentArray<UActorComponent*> Components(Actor);
+
+		for (UActorComponent* Component : Components)
+		{
+			if (Component->PrimaryComponentTick.IsTickFunctionRegistered())
+			{
+				FillEntry(OutEntries.AddDefaulted_GetRef(), Component, Component->PrimaryComponentTick);
+			}
+		}
+	}
+}
+
+void UMYPTickAuditSubsystem::LogAudit(bool bIncludeAllTickFunctions) const
+{
+	TArray<FMYPTickAuditEntry> Entries;
+	Audit(Entries);
+
+	// group the entries by class so the log stays readable in busy levels
+	Entries.Sort([](const FMYPTickAuditEntry& A, const FMYPTickAuditEntry& B)
+	{
+		const UObject* ObjectA = A.Object.Get();
+		const UObject* ObjectB = B.Object.Get();
+
+		return ObjectA->GetClass()->GetName() < ObjectB->GetClass()->GetName();
+	});
+
+	int32 NumEnabled = 0;
+	int32 NumRedundant = 0;
+
+	for (const FMYPTickAuditEntry& Entry : Entries)
+	{
+		const UObject* Object = Entry.Object.Get();
+
+		NumEnabled += Entry.bEnabled ? 1 : 0;
+		NumRedundant += Entry.IsRedundant() ? 1 : 0;
+
+		UE_LOG(MYPLog, Log, TEXT("%s%-40s %-48s %-20s interval %.3fs %s"),
+			Entry.IsRedundant() ? TEXT("[REDUNDANT] ") : TEXT(""),
+			*Object->GetClass()->GetName(),
+			*Object->GetPathName(GetWorld()),
+			*UEnum::GetValueAsString(Entry.TickGroup.GetValue()),
+			Entry.TickInterval,
+			Entry.bEnabled ? TEXT("enabled") : TEXT("disabled"));
+	}
+
+	UE_LOG(MYPLog, Log, TEXT("Tick audit for %s: %d registered actor and component ticks, %d enabled, %d redundant, %d unregistered after begin play"),
+		*GetWorld()->GetMapName(), Entries.Num(), NumEnabled, NumRedundant, NumDisabledTicks);
+
+	// the engine dump covers every tick function, including subsystem ticks and their measured cost
+	if (bIncludeAllTickFunctions)
+	{
+		FTickTaskManagerInterface::Get().DumpAllTickFunctions(*GLog, GetWorld(), true, true, false);
+	}
+}
+
+int32 UMYPTickAuditSubsystem::DisableRedundantTicks(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return 0;
+	}
+
+	int32 NumDisabled = 0;
+
+	// remove the actor tick if it does nothing
+	if (Actor->PrimaryActorTick.IsTickFunctionRegistered() && !HasNativeTick(Actor->GetClass()) && !HasScriptTick(Actor->GetClass()))
+	{
+		Actor->PrimaryActorTick.UnRegisterTickFunction();
+		++NumDisabled;
+	}
+
+	// remove the component ticks that do nothing
+	TInlineComponentArray<UActorComponent*> Components(Actor);
+
+	for (UActorComponent* Component : Components)
+	{
+		if (Component->PrimaryComponentTick.IsTickFunctionRegistered() && !HasNativeTick(Component->GetClass()) && !HasScriptTick(Component->GetClass()))
+		{
+			Component->PrimaryComponentTick.UnRegisterTickFunction();
+			++NumDisabled;
+		}
+	}
+
+	NumDisabledTicks += NumDisabled;
+	INC_DWORD_STAT_BY(STAT_MYPRedundantTicksDisabled, NumDisabled);
+
+	return NumDisabled;
+}
+
+void UMYPTickAuditSubsystem::FillEntry(FMYPTickAuditEntry& Entry, UObject* Object, const FTickFunction& TickFunction) const
+{
+	Entry.Object = Object;
+	Entry.TickGroup = TickFunction.TickGroup;
+	Entry.TickInterval = TickFunction.TickInterval;
+	Entry.bEnabled = TickFunction.IsTickFunctionEnabled();
+	Entry.bHasNativeTick = HasNativeTick(Object->GetClass());
+	Entry.bHasScriptTick = HasScriptTick(Object->GetClass());
+}
+
+bool UMYPTickAuditSubsystem::HasNativeTick(const UClass* Class)
+{
+	// find the native class the object is built on
+	const UClass* NativeClass = Class;
+
+	while (NativeClass && !NativeClass->HasAnyClassFlags(CLASS_Native))
+	{
+		NativeClass = NativeClass->GetSuperClass();
+	}
+
+	if (!NativeClass)
+	{
+		return false;
+	}
+
+	// classes registered with MYP_AUDIT_TICK were checked for an override at compile time
+	bool bOverridesTick;
+
+	if (FMYPNativeTickRegistration::FindOverridesTick(NativeClass, bOverridesTick))
+	{
+		return bOverridesTick;
+	}
+
+	// these engine classes only forward their tick to the Blueprint event
+	if (NativeClass == AActor::StaticClass() || NativeClass == APawn::StaticClass() || NativeClass == ACharacter::StaticClass()
+		|| NativeClass == UActorComponent::StaticClass() || NativeClass == USceneComponent::StaticClass())
+	{
+		return false;
+	}
+
+	// for anything else, guess that a native class only turns its tick on in its constructor when it overrides Tick or TickComponent.
+	// If only a Blueprint child turns it on, the native parent has nothing to run
+	const UObject* NativeDefaults = NativeClass->GetDefaultObject();
+
+	if (const AActor* ActorDefaults = Cast<AActor>(NativeDefaults))
+	{
+		return ActorDefaults->PrimaryActorTick.bCanEverTick;
+	}
+
+	if (const UActorComponent* ComponentDefaults = Cast<UActorComponent>(NativeDefaults))
+	{
+		return ComponentDefaults->PrimaryComponentTick.bCanEverTick;
+	}
+
+	return true;
+}
+
+bool UMYPTickAuditSubsystem::HasScriptTick(const UClass* Class)
+{
+	// actors and components share the same Blueprint tick event name
+	static const FName ReceiveTickName(TEXT("ReceiveTick"));
+
+	return Class->IsFunctionImplementedInScript(ReceiveTickName);
+}
+
+void UMYPTickAuditSubsystem::HandleActorSpawned(AActor* Actor)
+{
+	if (!CVarMYPTicksAutoDisable.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	// deferred spawns haven't begun play yet when this runs, so leave the actor for the next pass
+	PendingActors.Add(Actor);
+
+	SetTickEnabled(true);
+}
+
+void UMYPTickAuditSubsystem::DisablePendingTicks(float DeltaTime)
+{
+	if (CVarMYPTicksAutoDisable.GetValueOnGameThread())
+	{
+		// the level actors have begun play by the first frame, and registered their tick functions
+		if (!bLevelActorsProcessed)
+		{
+			bLevelActorsProcessed = true;
+
+			for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+			{
+				DisableRedundantTicks(*It);
+			}
+
+			UE_LOG(MYPLog, Log, TEXT("Unregistered %d redundant tick functions in %s"), NumDisabledTicks, *GetWorld()->GetMapName());
+		}
+
+		for (const TWeakObjectPtr<AActor>& PendingActor : PendingActors)
+		{
+			// a deferred spawn that still hasn't finished goes in the next pass
+			AActor* Actor = PendingActor.Get();
+
+			if (Actor && !Actor->HasActorBegunPlay())
+			{
+				continue;
+			}
+
+			DisableRedundantTicks(Actor);
+		}
+
+		PendingActors.RemoveAll([](const TWeakObjectPtr<AActor>& PendingActor)
+		{
+			return !PendingActor.IsValid() || PendingActor->HasActorBegunPlay();
+		});
+	}
+	else
+	{
+		PendingActors.Reset();
+	}
+
+	// sleep until the next spawn
+	if (PendingActors.IsEmpty())
+	{
+		SetTickEnabled(false);
+	}
+}
+
+void UMYPTickAuditSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// run at the end of the frame, after every actor ticking this frame is done
+	SetupTick(&UMYPTickAuditSubsystem::DisablePendingTicks, TG_PostUpdateWork, TEXT("MYPTickAuditSubsystem::DisablePendingTicks"), 0.0f, CVarMYPTicksAutoDisable.GetValueOnGameThread());
+}
+
+void UMYPTickAuditSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// catch actors spawned after begin play
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UMYPTickAuditSubsystem::HandleActorSpawned));
+}
+
+void UMYPTickAuditSubsystem::Deinitialize()
+{
+	PendingActors.Empty();
+
+	// stop listening for spawned actors
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+
+	ActorSpawnedHandle.Reset();
+
+	DEC_DWORD_STAT_BY(STAT_MYPRedundantTicksDisabled, NumDisabledTicks);
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPTickableWorldSubsystem.h"
+#include "Engine/Level.h"
+
+void UMYPTickableWorldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// subsystems that never set up a tick don't need one registered
+	if (!SubsystemTickFunction.TickDelegate.IsBound())
+	{
+		return;
+	}
+
+	SubsystemTickFunction.bCanEverTick = true;
+	SubsystemTickFunction.bStartWithTickEnabled = bTickEnabled;
+	SubsystemTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UMYPTickableWorldSubsystem::Deinitialize()
+{
+	// unregister the tick function
+	if (SubsystemTickFunction.IsTickFunctionRegistered())
+	{
+		SubsystemTickFunction.UnRegisterTickFunction();
+	}
+
+	SubsystemTickFunction.TickDelegate.Unbind();
+
+	Super::Deinitialize();
+}
+
+bool UMYPTickableWorldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMYPTickableWorldSubsystem::SetTickEnabled(bool bEnabled)
+{
+	bTickEnabled = bEnabled;
+
+	// before begin play, the requested state is picked up when the tick function registers
+	if (SubsystemTickFunction.IsTickFunctionRegistered())
+	{
+		SubsystemTickFunction.SetTickFunctionEnable(bEnabled);
+	}
+}
@@ -0,0 +1,437 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPTimerSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "MYP.h"
+
+DECLARE_CYCLE_STAT(TEXT("Timer Wheel Advance"), STAT_MYPTimerAdvance, STATGROUP_MYP);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pending Timers"), STAT_MYPPendingTimers, STATGROUP_MYP);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Timers Fired"), STAT_MYPTimersFired, STATGROUP_MYP);
+
+UMYPTimerSubsystem::UMYPTimerSubsystem()
+{
+	// start with all slots empty
+	for (int32& SlotHead : SlotHeads)
+	{
+		SlotHead = INDEX_NONE;
+	}
+}
+
+UMYPTimerSubsystem* UMYPTimerSubsystem::Get(const UObject* WorldContextObject)
+{
+	UMYPTimerSubsystem* Timers = UMYPTickableWorldSubsystem::Get<UMYPTimerSubsystem>(WorldContextObject);
+
+	// callers have no fallback, so a missing subsystem in a running game would silently drop despawns, respawns and waves
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	ensureMsgf(Timers || !World || !World->IsGameWorld() || World->bIsTearingDown, TEXT("No timer subsystem in %s, timers scheduled by %s will never fire"), *World->GetName(), *GetNameSafe(WorldContextObject));
+
+	return Timers;
+}
+
+FMYPTimerHandle UMYPTimerSubsystem::SetTimer(AActor* Owner, float Delay, FSimpleDelegate&& Callback, bool bLoop)
+{
+	if (!Owner || !Callback.IsBound())
+	{
+		return FMYPTimerHandle();
+	}
+
+	const int64 CurrentTick = TimeToTick(GetCurrentTime());
+
+	// if the wheel is idle, skip ahead so we don't have to walk the ticks we missed
+	if (NumActiveTimers == 0)
+	{
+		NextTick = FMath::Max(NextTick, CurrentTick + 1);
+	}
+
+	// get a free node
+	int32 NodeIndex;
+
+	if (FreeNodes.Num() > 0)
+	{
+		NodeIndex = FreeNodes.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		NodeIndex = Nodes.AddDefaulted();
+	}
+
+	// fill in the timer. Round up so timers never fire early
+	const int64 DelayTicks = FMath::Max<int64>(1, FMath::CeilToInt64(Delay * TicksPerSecond));
+
+	FTimerNode& Node = Nodes[NodeIndex];
+	Node.Callback = MoveTemp(Callback);
+	Node.Owner = Owner;
+	Node.ExpireTick = CurrentTick + DelayTicks;
+	Node.LoopTicks = bLoop ? DelayTicks : 0;
+	Node.bActive = true;
+
+	// link the node into the wheel and its owner's list
+	LinkToSlot(NodeIndex);
+	LinkToOwner(NodeIndex, Owner);
+
+	++NumActiveTimers;
+	INC_DWORD_STAT(STAT_MYPPendingTimers);
+
+	// make sure the wheel is advancing
+	SetTickEnabled(true);
+
+	FMYPTimerHandle Handle;
+	Handle.Index = NodeIndex;
+	Handle.Serial = Node.Serial;
+
+	return Handle;
+}
+
+void UMYPTimerSubsystem::ClearTimer(FMYPTimerHandle& Handle)
+{
+	if (FindNode(Handle))
+	{
+		FreeNode(Handle.Index);
+	}
+
+	Handle.Invalidate();
+}
+
+void UMYPTimerSubsystem::ClearAllTimersForOwner(const AActor* Owner)
+{
+	const TObjectKey<AActor> OwnerKey(Owner);
+
+	// free every node in the owner's list. Freeing the head unlinks it, so keep freeing the head until the list is gone
+	while (const int32* Head = OwnerHeads.Find(OwnerKey))
+	{
+		FreeNode(*Head);
+	}
+}
+
+bool UMYPTimerSubsystem::IsTimerActive(const FMYPTimerHandle& Handle) const
+{
+	return FindNode(Handle) != nullptr;
+}
+
+float UMYPTimerSubsystem::GetTimerRemaining(const FMYPTimerHandle& Handle) const
+{
+	if (const FTimerNode* Node = FindNode(Handle))
+	{
+		return FMath::Max(0.0f, float(Node->ExpireTick / TicksPerSecond - GetCurrentTime()));
+	}
+
+	return -1.0f;
+}
+
+double UMYPTimerSubsystem::GetCurrentTime() const
+{
+	return GetWorld()->GetTimeSeconds();
+}
+
+const UMYPTimerSubsystem::FTimerNode* UMYPTimerSubsystem::FindNode(const FMYPTimerHandle& Handle) const
+{
+	if (Nodes.IsValidIndex(Handle.Index))
+	{
+		const FTimerNode& Node = Nodes[Handle.Index];
+
+		if (Node.bActive && Node.Serial == Handle.Serial)
+		{
+			return &Node;
+		}
+	}
+
+	return nullptr;
+}
+
+void UMYPTimerSubsystem::LinkToSlot(int32 NodeIndex)
+{
+	FTimerNode& Node = Nodes[NodeIndex];
+
+	const int64 Delta = Node.ExpireTick - NextTick;
+
+	int32 Level;
+	int64 SlotTick;
+
+	if (Delta < 0)
+	{
+		// already due, so fire on the next processed tick
+		Level = 0;
+		SlotTick = NextTick;
+	}
+	else if (Delta < (int64(1) << SlotBits))
+	{
+		Level = 0;
+		SlotTick = Node.ExpireTick;
+	}
+	else if (Delta < (int64(1) << (SlotBits * 2)))
+	{
+		Level = 1;
+		SlotTick = Node.ExpireTick >> SlotBits;
+	}
+	else if (Delta < (int64(1) << (SlotBits * 3)))
+	{
+		Level = 2;
+		SlotTick = Node.ExpireTick >> (SlotBits * 2);
+	}
+	else
+	{
+		// timers past the wheel's range wait in the last slot of the top level and get placed again when it cascades
+		Level = 3;
+		SlotTick = FMath::Min(Node.ExpireTick, NextTick + (int64(1) << (SlotBits * 4)) - 1) >> (SlotBits * 3);
+	}
+
+	const int32 SlotList = Level * NumSlots + int32(SlotTick & SlotMask);
+
+	// push the node at the head of the slot list
+	Node.SlotList = SlotList;
+	Node.SlotPrev = INDEX_NONE;
+	Node.SlotNext = SlotHeads[SlotList];
+
+	if (Node.SlotNext != INDEX_NONE)
+	{
+		Nodes[Node.SlotNext].SlotPrev = NodeIndex;
+	}
+
+	SlotHeads[SlotList] = NodeIndex;
+}
+
+void UMYPTimerSubsystem::UnlinkFromSlot(int32 NodeIndex)
+{
+	FTimerNode& Node = Nodes[NodeIndex];
+
+	if (Node.SlotList == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (Node.SlotPrev != INDEX_NONE)
+	{
+		Nodes[Node.SlotPrev].SlotNext = Node.SlotNext;
+	}
+	else
+	{
+		SlotHeads[Node.SlotList] = Node.SlotNext;
+	}
+
+	if (Node.SlotNext != INDEX_NONE)
+	{
+		Nodes[Node.SlotNext].SlotPrev = Node.SlotPrev;
+	}
+
+	Node.SlotList = INDEX_NONE;
+	Node.SlotPrev = INDEX_NONE;
+	Node.SlotNext = INDEX_NONE;
+}
+
+void UMYPTimerSubsystem::LinkToOwner(int32 NodeIndex, AActor* Owner)
+{
+	FTimerNode& Node = Nodes[NodeIndex];
+
+	int32* Head = OwnerHeads.Find(Node.Owner);
+
+	if (!Head)
+	{
+		// first timer for this owner. Clear its timers automatically when it ends play
+		Owner->OnEndPlay.AddUniqueDynamic(this, &UMYPTimerSubsystem::HandleOwnerEndPlay);
+
+		Head = &OwnerHeads.Add(Node.Owner, INDEX_NONE);
+	}
+
+	// push the node at the head of the owner list
+	Node.OwnerPrev = INDEX_NONE;
+	Node.OwnerNext = *Head;
+
+	if (Node.OwnerNext != INDEX_NONE)
+	{
+		Nodes[Node.OwnerNext].OwnerPrev = NodeIndex;
+	}
+
+	*Head = NodeIndex;
+}
+
+void UMYPTimerSubsystem::UnlinkFromOwner(int32 NodeIndex)
+{
+	FTimerNode& Node = Nodes[NodeIndex];
+
+	if (Node.OwnerPrev != INDEX_NONE)
+	{
+		Nodes[Node.OwnerPrev].OwnerNext = Node.OwnerNext;
+	}
+	else if (Node.OwnerNext != INDEX_NONE)
+	{
+		OwnerHeads.FindChecked(Node.Owner) = Node.OwnerNext;
+	}
+	else
+	{
+		// this was the owner's last timer
+		OwnerHeads.Remove(Node.Owner);
+	}
+
+	if (Node.OwnerNext != INDEX_NONE)
+	{
+		Nodes[Node.OwnerNext].OwnerPrev = Node.OwnerPrev;
+	}
+
+	Node.OwnerPrev = INDEX_NONE;
+	Node.OwnerNext = INDEX_NONE;
+}
+
+void UMYPTimerSubsystem::FreeNode(int32 NodeIndex)
+{
+	UnlinkFromSlot(NodeIndex);
+	UnlinkFromOwner(NodeIndex);
+
+	FTimerNode& Node = Nodes[NodeIndex];
+
+	// invalidate any outstanding handles
+	++Node.Serial;
+	Node.bActive = false;
+	Node.Callback.Unbind();
+	Node.Owner = TObjectKey<AActor>();
+
+	FreeNodes.Add(NodeIndex);
+
+	--NumActiveTimers;
+	DEC_DWORD_STAT(STAT_MYPPendingTimers);
+}
+
+void UMYPTimerSubsystem::CascadeSlot(int32 Level, int32 Slot)
+{
+	const int32 SlotList = Level * NumSlots + Slot;
+
+	// detach the slot list and place each of its timers again relative to the current tick
+	int32 NodeIndex = SlotHeads[SlotList];
+	SlotHeads[SlotList] = INDEX_NONE;
+
+	while (NodeIndex != INDEX_NONE)
+	{
+		FTimerNode& Node = Nodes[NodeIndex];
+		const int32 NextNode = Node.SlotNext;
+
+		Node.SlotList = INDEX_NONE;
+		Node.SlotPrev = INDEX_NONE;
+		Node.SlotNext = INDEX_NONE;
+
+		LinkToSlot(NodeIndex);
+
+		NodeIndex = NextNode;
+	}
+}
+
+void UMYPTimerSubsystem::ProcessTick(int64 Tick)
+{
+	// when a lower level wraps around, cascade the matching slot of the level above it
+	for (int32 Level = 1; Level < NumLevels; ++Level)
+	{
+		if ((Tick & ((int64(1) << (SlotBits * Level)) - 1)) != 0)
+		{
+			break;
+		}
+
+		CascadeSlot(Level, int32((Tick >> (SlotBits * Level)) & SlotMask));
+	}
+
+	// timers scheduled while firing go to the next tick, not the slot we're processing
+	NextTick = Tick + 1;
+
+	// move the slot's timers to the firing list, so timers cleared by a callback are unlinked safely
+	const int32 SlotList = int32(Tick & SlotMask);
+
+	SlotHeads[FiringList] = SlotHeads[SlotList];
+	SlotHeads[SlotList] = INDEX_NONE;
+
+	for (int32 NodeIndex = SlotHeads[FiringList]; NodeIndex != INDEX_NONE; NodeIndex = Nodes[NodeIndex].SlotNext)
+	{
+		Nodes[NodeIndex].SlotList = FiringList;
+	}
+
+	// fire every timer in the firing list
+	while (SlotHeads[FiringList] != INDEX_NONE)
+	{
+		const int32 NodeIndex = SlotHeads[FiringList];
+		FTimerNode& Node = Nodes[NodeIndex];
+
+		UnlinkFromSlot(NodeIndex);
+
+		// a timer placed at the top level past the wheel's range may not be due yet
+		if (Node.ExpireTick > Tick)
+		{
+			LinkToSlot(NodeIndex);
+			continue;
+		}
+
+		INC_DWORD_STAT(STAT_MYPTimersFired);
+
+		if (Node.LoopTicks > 0)
+		{
+			// reschedule looping timers before firing, so the callback is free to clear them
+			Node.ExpireTick = Tick + Node.LoopTicks;
+			LinkToSlot(NodeIndex);
+
+			// copy the delegate, since the callback may schedule timers and grow the node pool
+			const FSimpleDelegate Callback = Node.Callback;
+			Callback.ExecuteIfBound();
+		}
+		else
+		{
+			// free one-shot timers before firing, so their handles read as inactive during the callback
+			const FSimpleDelegate Callback = MoveTemp(Node.Callback);
+			FreeNode(NodeIndex);
+
+			Callback.ExecuteIfBound();
+		}
+	}
+}
+
+void UMYPTimerSubsystem::TickWheel(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MYPTimerAdvance);
+
+	const int64 TargetTick = TimeToTick(GetCurrentTime());
+
+	// process every tick up to the current time. Empty slots cost a single check
+	while (NextTick <= TargetTick && NumActiveTimers > 0)
+	{
+		ProcessTick(NextTick);
+	}
+
+	// stop ticking while there are no timers
+	if (NumActiveTimers == 0)
+	{
+		SetTickEnabled(false);
+	}
+}
+
+void UMYPTimerSubsystem::HandleOwnerEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	// the owner is gone, so its timers are no longer needed
+	ClearAllTimersForOwner(Actor);
+}
+
+void UMYPTimerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// gameplay timers run after physics, like world timers. The wheel only advances while timers are scheduled
+	SetupTick(&UMYPTimerSubsystem::TickWheel, TG_PostPhysics, TEXT("MYPTimerSubsystem::TickWheel"), 0.0f, false);
+}
+
+void UMYPTimerSubsystem::Deinitialize()
+{
+	SET_DWORD_STAT(STAT_MYPPendingTimers, 0);
+
+	// drop all timers
+	Nodes.Empty();
+	FreeNodes.Empty();
+	OwnerHeads.Empty();
+	NumActiveTimers = 0;
+
+	for (int32& SlotHead : SlotHeads)
+	{
+		SlotHead = INDEX_NONE;
+	}
+
+	Super::Deinitialize();
+}
+
+bool UMYPTimerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE || WorldType == EWorldType::GamePreview || WorldType == EWorldType::GameRPC;
+}
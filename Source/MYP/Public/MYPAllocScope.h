@@ -0,0 +1,14 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+/**
+ *  Tags the heap allocations made on the calling thread, until the end of the enclosing block, as MYP/<Name>.
+ *  Tagging goes through the Low Level Memory Tracker, which the engine hooks into the allocator before anything else runs.
+ *  Launch with -llm to see each scope's memory under 'stat LLMFULL', or with -trace=default,memory to count its allocations in Memory Insights.
+ *  Compiles out along with LLM, so it costs nothing in Shipping.
+ */
+#define MYP_ALLOC_SCOPE(Name) LLM_SCOPE_BYNAME(TEXT("MYP/" #Name))
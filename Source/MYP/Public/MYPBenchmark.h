@@ -0,0 +1,182 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+#include "Templates/SubclassOf.h"
+#include "Templates/Casts.h"
+
+class UWorld;
+class AActor;
+
+#ifndef MYP_WITH_BENCHMARKS
+	#define MYP_WITH_BENCHMARKS !UE_BUILD_SHIPPING
+#endif
+
+#if MYP_WITH_BENCHMARKS
+
+/**
+ *  Timing statistics for a single benchmark
+ */
+struct MYP_API FMYPBenchmarkResult
+{
+	/** Benchmark name, prefixed by its suite as in "Combat.DoAttackTrace.Props8" */
+	FString Name;
+
+	/** Number of timed iterations */
+	int32 Iterations = 0;
+
+	/** Mean time per iteration */
+	double MeanMicroseconds = 0.0;
+
+	/** Median time per iteration. The figure to compare between builds, since it ignores the occasional hitch */
+	double MedianMicroseconds = 0.0;
+
+	/** 95th percentile time per iteration */
+	double P95Microseconds = 0.0;
+
+	/** Fastest iteration */
+	double MinMicroseconds = 0.0;
+
+	/** Slowest iteration */
+	double MaxMicroseconds = 0.0;
+
+	/** Standard deviation of the iteration times */
+	double StdDevMicroseconds = 0.0;
+
+	/**
+	 *  Mean heap memory the timed body left allocated, per iteration, as tracked by the Low Level Memory Tracker.
+	 *  Only measured when launched with -llm. Scratch memory freed before the body returns doesn't show up here,
+	 *  use the Memory Insights bookmarks for that
+	 */
+	double HeapBytesPerIteration = 0.0;
+};
+
+/**
+ *  Iteration counts shared by every benchmark in a run
+ */
+struct FMYPBenchmarkSettings
+{
+	/** Untimed iterations run first, so lazily created state and cold caches don't skew the results */
+	int32 WarmupIterations = 16;
+
+	/** Timed iterations */
+	int32 Iterations = 256;
+
+	/** Random seed for every suite's world, so enemies make the same decisions from one run to the next */
+	int32 Seed = 0;
+};
+
+/**
+ *  Passed to a benchmark suite. Owns the suite's world and measures benchmarks in it.
+ */
+class MYP_API FMYPBenchmarkContext
+{
+	/** Name of the suite being run */
+	const TCHAR* SuiteName;
+
+	/** World the suite runs in */
+	UWorld* World;
+
+	/** Iteration counts */
+	FMYPBenchmarkSettings Settings;
+
+	/** Results are appended here */
+	TArray<FMYPBenchmarkResult>& Results;
+
+public:
+
+	FMYPBenchmarkContext(const TCHAR* InSuiteName, UWorld* InWorld, const FMYPBenchmarkSettings& InSettings, TArray<FMYPBenchmarkResult>& InResults);
+
+	/** Returns the suite's world */
+	UWorld* GetWorld() const { return World; }
+
+	/**
+	 *  Measures a benchmark.
+	 *  @param Name      Benchmark name, unique within the suite
+	 *  @param Setup     Untimed, runs before every iteration
+	 *  @param Body      Timed
+	 *  @param Teardown  Untimed, runs after every iteration
+	 */
+	void Measure(const FString& Name, TFunctionRef<void()> Setup, TFunctionRef<void()> Body, TFunctionRef<void()> Teardown);
+
+	/** Measures a benchmark that needs no per iteration setup or teardown */
+	void Measure(const FString& Name, TFunctionRef<void()> Body);
+
+	/** Advances the world by a frame, running its tick functions, timers and subsystems */
+	void TickWorld(float DeltaSeconds = 1.0f / 60.0f);
+
+	/** Spawns a flat blocking floor with its top at the origin */
+	AActor* SpawnFloor(float HalfExtent = 5000.0f);
+
+	/** Spawns an actor, regardless of what it overlaps at the spawn location */
+	AActor* SpawnActor(UClass* Class, const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator);
+
+	template<typename T>
+	T* SpawnActor(UClass* Class, const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator)
+	{
+		return Cast<T>(SpawnActor(Class, Location, Rotation));
+	}
+
+	/** Loads a Blueprint class. Logs and returns null if it's missing, so the suite can skip the benchmarks that need it */
+	UClass* LoadBlueprintClass(const TCHAR* Path, UClass* BaseClass) const;
+
+	template<typename T>
+	TSubclassOf<T> LoadBlueprintClass(const TCHAR* Path) const
+	{
+		return LoadBlueprintClass(Path, T::StaticClass());
+	}
+};
+
+/**
+ *  Registers a benchmark suite. Declare one as a static in the module that owns the benchmarked code.
+ *  Every suite runs in its own empty game world, created for it and destroyed once it's done.
+ */
+class MYP_API FMYPBenchmarkSuite
+{
+public:
+
+	using FRunFunction = void(*)(FMYPBenchmarkContext& Context);
+
+	/** Suite name */
+	const TCHAR* Name;
+
+	/** Sets up the suite's world and measures its benchmarks */
+	FRunFunction Run;
+
+	/** Next suite in the registry */
+	FMYPBenchmarkSuite* Next = nullptr;
+
+	/** Adds the suite to the registry */
+	FMYPBenchmarkSuite(const TCHAR* InName, FRunFunction InRun);
+
+	/** Removes the suite from the registry when its module unloads */
+	~FMYPBenchmarkSuite();
+
+	UE_NONCOPYABLE(FMYPBenchmarkSuite);
+};
+
+/**
+ *  Runs the registered benchmark suites and reads and writes their results as JSON, so runs can be compared between builds.
+ *  Run with MYP.Benchmark.Run, usually from the command line of a game launch:
+ *    -game -nullrhi -unattended -ExecCmds="MYP.Benchmark.Run Label=<commit> Baseline=<previous results>,quit"
+ */
+class MYP_API FMYPBenchmarkRunner
+{
+public:
+
+	/** Runs every suite whose name contains the filter, or every suite if it's empty. Returns false if no suite ran */
+	static bool Run(const FString& SuiteFilter, const FMYPBenchmarkSettings& Settings, TArray<FMYPBenchmarkResult>& OutResults);
+
+	/** Writes the results, along with the build and machine they were measured on */
+	static bool SaveResults(const FString& Filename, const FString& Label, const FMYPBenchmarkSettings& Settings, TConstArrayView<FMYPBenchmarkResult> Results);
+
+	/** Reads results written by SaveResults */
+	static bool LoadResults(const FString& Filename, TArray<FMYPBenchmarkResult>& OutResults);
+
+	/** Logs each result's change in median time against a baseline */
+	static void LogComparison(TConstArrayView<FMYPBenchmarkResult> Results, TConstArrayView<FMYPBenchmarkResult> Baseline);
+};
+
+#endif // MYP_WITH_BENCHMARKS
@@ -0,0 +1,52 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "MYPBotInput.generated.h"
+
+/**
+ *  Action names bot scripts can press and release.
+ *  Pawns ignore the actions they don't have.
+ */
+namespace MYPBotActions
+{
+	/** Melee combo attack */
+	const FName Attack(TEXT("Attack"));
+
+	/** Press and hold charged attack */
+	const FName ChargedAttack(TEXT("ChargedAttack"));
+
+	/** Jump, held for a higher jump where the pawn supports it */
+	const FName Jump(TEXT("Jump"));
+
+	/** Dash */
+	const FName Dash(TEXT("Dash"));
+}
+
+/**
+ *  BotInput Interface
+ *  Lets a bot script drive a pawn through the same entry points its player input goes through
+ */
+UINTERFACE(MinimalAPI, NotBlueprintable)
+class UMYPBotInput : public UInterface
+{
+	GENERATED_BODY()
+};
+
+class MYP_API IMYPBotInput
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Moves the pawn, relative to the control rotation */
+	virtual void BotMove(float Right, float Forward) = 0;
+
+	/** Turns the control rotation */
+	virtual void BotLook(float Yaw, float Pitch) = 0;
+
+	/** Presses or releases one of the MYPBotActions */
+	virtual void BotAction(FName Action, bool bPressed);
+};
@@ -0,0 +1,85 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "MYPBotScript.generated.h"
+
+/**
+ *  What a bot script step does
+ */
+UENUM(BlueprintType)
+enum class EMYPBotStepType : uint8
+{
+	/** Holds a move input for the step's duration */
+	Move,
+
+	/** Holds a look input for the step's duration */
+	Look,
+
+	/** Presses an action */
+	Press,
+
+	/** Releases an action */
+	Release,
+
+	/** Does nothing for the step's duration */
+	Wait
+};
+
+/**
+ *  A single step of a bot script
+ */
+USTRUCT(BlueprintType)
+struct MYP_API FMYPBotStep
+{
+	GENERATED_BODY()
+
+	/** What the step does */
+	UPROPERTY(EditAnywhere, Category="Step")
+	EMYPBotStepType Type = EMYPBotStepType::Wait;
+
+	/** Move input as (Right, Forward), or look input as (Yaw, Pitch) per second */
+	UPROPERTY(EditAnywhere, Category="Step", meta = (EditCondition = "Type == EMYPBotStepType::Move || Type == EMYPBotStepType::Look", EditConditionHides))
+	FVector2D Input = FVector2D::ZeroVector;
+
+	/** Random amount added to each input axis, up to this much either way */
+	UPROPERTY(EditAnywhere, Category="Step", meta = (EditCondition = "Type == EMYPBotStepType::Move || Type == EMYPBotStepType::Look", EditConditionHides))
+	FVector2D RandomInput = FVector2D::ZeroVector;
+
+	/** Action to press or release. One of the MYPBotActions */
+	UPROPERTY(EditAnywhere, Category="Step", meta = (EditCondition = "Type == EMYPBotStepType::Press || Type == EMYPBotStepType::Release", EditConditionHides))
+	FName Action;
+
+	/** Time the step lasts. Presses and releases take a frame */
+	UPROPERTY(EditAnywhere, Category="Step", meta = (ClampMin = 0, Units = "s"))
+	float Duration = 1.0f;
+
+	/** Random time added to the duration, up to this much */
+	UPROPERTY(EditAnywhere, Category="Step", meta = (ClampMin = 0, Units = "s"))
+	float RandomDuration = 0.0f;
+};
+
+/**
+ *  A sequence of inputs a bot plays on its pawn, for load tests and soak tests.
+ *  Random ranges are drawn from the bot's own random stream, so bots with different seeds spread out.
+ */
+UCLASS(BlueprintType)
+class MYP_API UMYPBotScript : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Steps, played in order */
+	UPROPERTY(EditAnywhere, Category="Script")
+	TArray<FMYPBotStep> Steps;
+
+	/** If true, the script starts over once it's done. Otherwise the bot stands still */
+	UPROPERTY(EditAnywhere, Category="Script")
+	bool bLoop = true;
+
+	/** Creates the script bots play when none is given: wander around, turning at random, attacking and jumping now and then */
+	static UMYPBotScript* CreateWanderScript(UObject* Outer);
+};
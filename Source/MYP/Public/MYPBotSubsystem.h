@@ -0,0 +1,80 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "MYPBotSubsystem.generated.h"
+
+class APlayerController;
+class UMYPBotScript;
+
+/**
+ *  Plays a bot script on the pawns of the local players, in place of their input.
+ *  Only created when the game runs with -MYPBot, usually as a headless client joining a load test server.
+ *  The script is loaded from -MYPBotScript=<asset path>. Without one, bots wander and fight at random.
+ *  Pawns take the script's input through IMYPBotInput. Pawns without it are left alone.
+ */
+UCLASS()
+class MYP_API UMYPBotSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Where a controller is in the script */
+	struct FBotState
+	{
+		/** Index of the current step */
+		int32 StepIndex = INDEX_NONE;
+
+		/** Time left on the current step */
+		float TimeLeft = 0.0f;
+
+		/** Input rolled for the current step */
+		FVector2D Input = FVector2D::ZeroVector;
+
+		/** If true, the script has ended and won't loop */
+		bool bFinished = false;
+	};
+
+	/** Script the bots play */
+	UPROPERTY()
+	TObjectPtr<UMYPBotScript> Script;
+
+	/** Script progress of each local controller */
+	TMap<TObjectKey<APlayerController>, FBotState> Bots;
+
+public:
+
+	/** Returns the bot subsystem for the world the context object lives in, if the game is running bots */
+	static UMYPBotSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Returns true if the game was started with -MYPBot */
+	static bool IsBotClient();
+
+	/** Returns the script the bots play */
+	UMYPBotScript* GetScript() const { return Script; }
+
+protected:
+
+	/** Plays the script for every local controller with a pawn */
+	void TickBots(float DeltaTime);
+
+	/** Moves the bot on to its next step and rolls the step's random ranges */
+	void StartNextStep(APlayerController* Controller, FBotState& State);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Only creates the subsystem on bot clients */
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/** Loads the script and sets up the bot tick */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Releases the script */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
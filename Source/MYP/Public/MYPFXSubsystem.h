@@ -0,0 +1,185 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "MYPFXSubsystem.generated.h"
+
+class UNiagaraSystem;
+class UNiagaraDataChannelAsset;
+class USceneComponent;
+struct FMYPFeedbackEffect;
+
+/**
+ *  Handle to a trail driven by the MYP FX Subsystem.
+ *  Handles become stale once their trail is stopped or its component is destroyed.
+ */
+struct FMYPFXTrailHandle
+{
+	/** Index of the trail slot */
+	int32 Index = INDEX_NONE;
+
+	/** Serial number of the trail slot when the handle was issued */
+	uint32 Serial = 0;
+
+	/** Returns true if this handle was ever assigned a trail */
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	/** Resets the handle */
+	void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+};
+
+/**
+ *  Batches gameplay effects into as few Niagara calls as possible.
+ *  - Effects with a data channel are queued as compact records and written once per channel per frame, so a single system instance can render all of them
+ *  - Effects without one are spawned from the Niagara component pool, up to a per frame limit
+ *  - Trails write a record from their socket every frame while active, instead of keeping a component per trail
+ *  - Records past the per frame budget are dropped, so a busy frame costs a bounded amount of CPU
+ *
+ *  Data channels used with this subsystem must declare Position (position), Direction (vector), Scale (float) and Color (linear color) variables.
+ */
+UCLASS()
+class MYP_API UMYPFXSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** A single effect event, waiting to be written into its data channel */
+	struct FEffectRecord
+	{
+		/** World location */
+		FVector Location = FVector::ZeroVector;
+
+		/** Unit direction. Impact normal for hits, travel direction for trails */
+		FVector3f Direction = FVector3f::UpVector;
+
+		/** Uniform effect scale */
+		float Scale = 1.0f;
+
+		/** Effect tint */
+		FColor Color = FColor::White;
+
+		/** Index of the data channel in the channel table */
+		int32 ChannelIndex = INDEX_NONE;
+	};
+
+	/** A pooled particle system spawn, for effects without a data channel */
+	struct FSpawnRequest
+	{
+		/** Index of the system in the system table */
+		int32 SystemIndex = INDEX_NONE;
+
+		/** World location */
+		FVector Location = FVector::ZeroVector;
+
+		/** World rotation */
+		FRotator Rotation = FRotator::ZeroRotator;
+
+		/** Component scale */
+		FVector Scale = FVector::OneVector;
+	};
+
+	/** A trail that writes a record from a socket every frame */
+	struct FTrail
+	{
+		/** Component the trail follows */
+		TWeakObjectPtr<USceneComponent> Component;
+
+		/** Socket on the component */
+		FName Socket;
+
+		/** Trail tint */
+		FColor Color = FColor::White;
+
+		/** Index of the data channel in the channel table */
+		int32 ChannelIndex = INDEX_NONE;
+
+		/** Serial number, incremented every time the slot is freed */
+		uint32 Serial = 1;
+
+		/** If true, the slot holds a running trail */
+		bool bActive = false;
+	};
+
+	/** Data channels seen so far. Records refer to them by index */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UNiagaraDataChannelAsset>> ChannelTable;
+
+	/** Particle systems seen so far. Spawn requests refer to them by index */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UNiagaraSystem>> SystemTable;
+
+	/** Effect records queued this frame */
+	TArray<FEffectRecord> Records;
+
+	/** Pooled spawns queued this frame */
+	TArray<FSpawnRequest> SpawnRequests;
+
+	/** Trail slots */
+	TArray<FTrail> Trails;
+
+	/** Free trail slots */
+	TArray<int32> FreeTrails;
+
+	/** Number of running trails */
+	int32 NumActiveTrails = 0;
+
+	/** Scratch per channel record counts and write cursors. Kept around to reuse the allocations */
+	TArray<int32> ChannelCounts;
+	TArray<int32> ChannelCursors;
+
+public:
+
+	/** Returns the FX subsystem for the world the context object lives in */
+	static UMYPFXSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Queues a feedback effect's particles. Written to its data channel if it has one, otherwise spawned from the pool */
+	void QueueEffect(const FMYPFeedbackEffect& Effect, const FVector& Location, const FRotator& Rotation);
+
+	/** Queues a record into a data channel */
+	void QueueRecord(UNiagaraDataChannelAsset* Channel, const FVector& Location, const FVector& Direction, float Scale = 1.0f, const FLinearColor& Color = FLinearColor::White);
+
+	/** Queues a pooled particle system spawn */
+	void QueueSpawn(UNiagaraSystem* System, const FVector& Location, const FRotator& Rotation, const FVector& Scale = FVector::OneVector);
+
+	/** Starts a trail that follows a component's socket, writing into a data channel every frame */
+	FMYPFXTrailHandle StartTrail(USceneComponent* Component, FName Socket, UNiagaraDataChannelAsset* Channel, const FLinearColor& Color = FLinearColor::White);
+
+	/** Stops a trail and invalidates the handle */
+	void StopTrail(FMYPFXTrailHandle& Handle);
+
+protected:
+
+	/** Returns the table index of a data channel, adding it if needed */
+	int32 GetChannelIndex(UNiagaraDataChannelAsset* Channel);
+
+	/** Returns true if another record fits in this frame's budget */
+	bool HasRecordBudget() const;
+
+	/** Wakes up the dispatch tick */
+	void EnableDispatch();
+
+	/** Adds a record for every running trail */
+	void GatherTrailRecords();
+
+	/** Writes the queued records into their data channels, one writer per channel */
+	void WriteRecords();
+
+	/** Spawns the queued systems from the pool */
+	void SpawnQueued();
+
+	/** Dispatches everything queued this frame */
+	void TickDispatch(float DeltaTime);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Sets up the dispatch tick */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Drops anything still queued */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
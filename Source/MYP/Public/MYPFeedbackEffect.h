@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MYPFeedbackEffect.generated.h"
+
+class UNiagaraSystem;
+class UNiagaraDataChannelAsset;
+class USoundBase;
+
+/**
+ *  A one-shot visual and audio effect, played natively at a world location.
+ *  Lets data assets describe hit and pickup feedback without a Blueprint event per occurrence.
+ *  Particles go through the MYP FX Subsystem, batched into a data channel if one is set.
+ */
+USTRUCT(BlueprintType)
+struct MYP_API FMYPFeedbackEffect
+{
+	GENERATED_BODY()
+
+	/** Data channel to write a record into. A single system reading the channel renders every occurrence. Takes priority over the particle system */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Feedback")
+	TObjectPtr<UNiagaraDataChannelAsset> DataChannel;
+
+	/** Particle system to spawn when there's no data channel. Components are taken from the Niagara pool */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Feedback")
+	TObjectPtr<UNiagaraSystem> Effect;
+
+	/** Tint written into the data channel record */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Feedback")
+	FLinearColor EffectColor = FLinearColor::White;
+
+	/** Scale applied to the spawned particle system */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Feedback")
+	FVector EffectScale = FVector::OneVector;
+
+	/** Sound to play */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Feedback")
+	TObjectPtr<USoundBase> Sound;
+
+	/** Volume multiplier for the sound */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Feedback", meta = (ClampMin = 0, ClampMax = 4))
+	float VolumeMultiplier = 1.0f;
+
+	/** Pitch multiplier for the sound */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Feedback", meta = (ClampMin = 0.1, ClampMax = 4))
+	float PitchMultiplier = 1.0f;
+
+	/** Returns true if there's anything to play */
+	bool IsSet() const { return DataChannel || Effect || Sound; }
+
+	/** Spawns the effect and plays the sound at the given location */
+	void Play(const UObject* WorldContextObject, const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator) const;
+};
@@ -0,0 +1,151 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/MemStack.h"
+#include "HAL/ThreadSingleton.h"
+#include "Misc/Optional.h"
+
+/**
+ *  Per-thread linear arena for gameplay scratch containers.
+ *  - Allocating is a pointer bump, and memory is never freed individually
+ *  - The game thread arena is rewound at the end of every frame, so anything allocated from it must not outlive the frame
+ *  - Other threads are never rewound automatically. Work on them must open an FMYPFrameArenaMark around its scratch containers
+ *  Containers opt in through TMYPFrameAllocator, usually as the secondary allocator of a TInlineAllocator.
+ */
+class MYP_API FMYPFrameArena : public TThreadSingleton<FMYPFrameArena>, public FMemStackBase
+{
+	/** Rewinds the game thread arena at the end of each frame. Only set on the game thread's arena */
+	TOptional<FMemMark> FrameMark;
+
+	/** End of frame delegate handle */
+	static FDelegateHandle EndFrameHandle;
+
+	/** Rewinds the game thread arena */
+	static void EndFrame();
+
+public:
+
+	/** Opens the game thread's frame mark and starts rewinding it every frame. Called on module startup */
+	static void Startup();
+
+	/** Stops rewinding the game thread arena. Called on module shutdown */
+	static void Shutdown();
+};
+
+/**
+ *  Rewinds the calling thread's frame arena when it goes out of scope.
+ *  Required around scratch containers on worker threads, and useful on the game thread to release memory before the frame ends.
+ */
+class FMYPFrameArenaMark : public FMemMark
+{
+public:
+
+	FMYPFrameArenaMark()
+		: FMemMark(FMYPFrameArena::Get())
+	{}
+};
+
+/**
+ *  Container allocator that takes its memory from the calling thread's frame arena.
+ *  Growing a container leaves the old block in the arena until it's rewound.
+ */
+template<uint32 Alignment = DEFAULT_ALIGNMENT>
+class TMYPFrameAllocator
+{
+public:
+
+	using SizeType = int32;
+
+	enum { NeedsElementType = true };
+	enum { RequireRangeCheck = true };
+
+	static constexpr bool ShrinkByDefault = false;
+
+	template<typename ElementType>
+	class ForElementType
+	{
+		/** Current allocation */
+		ElementType* Data = nullptr;
+
+	public:
+
+		ForElementType() = default;
+
+		FORCEINLINE void MoveToEmpty(ForElementType& Other)
+		{
+			checkSlow(this != &Other);
+
+			Data = Other.Data;
+			Other.Data = nullptr;
+		}
+
+		FORCEINLINE ElementType* GetAllocation() const
+		{
+			return Data;
+		}
+
+		void ResizeAllocation(SizeType CurrentNum, SizeType NewMax, SIZE_T NumBytesPerElement)
+		{
+			ElementType* OldData = Data;
+
+			if (NewMax == 0)
+			{
+				Data = nullptr;
+				return;
+			}
+
+			Data = reinterpret_cast<ElementType*>(FMYPFrameArena::Get().PushBytes(static_cast<size_t>(NewMax) * NumBytesPerElement, FMath::Max<size_t>(Alignment, alignof(ElementType))));
+
+			// carry the elements over. The old block stays in the arena until it's rewound
+			if (OldData && CurrentNum)
+			{
+				FMemory::Memcpy(Data, OldData, static_cast<size_t>(FMath::Min(NewMax, CurrentNum)) * NumBytesPerElement);
+			}
+		}
+
+		FORCEINLINE SizeType CalculateSlackReserve(SizeType NewMax, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackReserve(NewMax, NumBytesPerElement, false, Alignment);
+		}
+
+		FORCEINLINE SizeType CalculateSlackShrink(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackShrink(NewMax, CurrentMax, NumBytesPerElement, false, Alignment);
+		}
+
+		FORCEINLINE SizeType CalculateSlackGrow(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackGrow(NewMax, CurrentMax, NumBytesPerElement, false, Alignment);
+		}
+
+		SIZE_T GetAllocatedSize(SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+		{
+			return static_cast<SIZE_T>(CurrentMax) * NumBytesPerElement;
+		}
+
+		bool HasAllocation() const
+		{
+			return Data != nullptr;
+		}
+
+		SizeType GetInitialCapacity() const
+		{
+			return 0;
+		}
+	};
+
+	typedef ForElementType<FScriptContainerElement> ForAnyElementType;
+};
+
+/** Set and map allocator that keeps elements, bits and hash buckets in the frame arena */
+using FMYPFrameSetAllocator = TSetAllocator<TSparseArrayAllocator<TMYPFrameAllocator<>, TMYPFrameAllocator<>>, TMYPFrameAllocator<>>;
+
+/** Inline array allocator that spills into the frame arena instead of the heap */
+template<uint32 NumInlineElements>
+using TMYPInlineFrameAllocator = TInlineAllocator<NumInlineElements, TMYPFrameAllocator<>>;
+
+/** Inline set and map allocator that spills into the frame arena instead of the heap */
+template<uint32 NumInlineElements>
+using TMYPInlineFrameSetAllocator = TInlineSetAllocator<NumInlineElements, FMYPFrameSetAllocator>;
@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifies/AnimNotify.h"
+#include "MYPGameplayAnimNotify.generated.h"
+
+/**
+ *  Base class for AnimNotifies that drive gameplay logic.
+ *  When the owning actor has a Gameplay Timeline Component playing the montage, the notify is fired
+ *  by the timeline at its precomputed time instead of by the animation update, so gameplay doesn't
+ *  depend on the mesh's animation update rate.
+ */
+UCLASS(abstract)
+class MYP_API UMYPGameplayAnimNotify : public UAnimNotify
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Runs the gameplay logic for this notify */
+	virtual void FireGameplayNotify(USkeletalMeshComponent* MeshComp) {}
+
+	/** Fires the gameplay logic, unless a gameplay timeline is already driving this animation */
+	virtual void Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
+};
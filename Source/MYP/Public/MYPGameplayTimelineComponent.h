@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "MYPTimerSubsystem.h"
+#include "MYPGameplayTimelineComponent.generated.h"
+
+class UAnimMontage;
+class UAnimSequenceBase;
+class USkeletalMeshComponent;
+struct FMYPMontageTimeline;
+
+/**
+ *  Fires the gameplay notifies of a playing montage from precomputed section and notify times.
+ *  Gameplay code starts, jumps and stops the timeline alongside the montage, so gameplay notifies
+ *  fire on time regardless of how often the mesh's animation is updated.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class MYP_API UMYPGameplayTimelineComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+	/** Montage currently driven by this timeline */
+	UPROPERTY(Transient)
+	TObjectPtr<UAnimMontage> ActiveMontage;
+
+	/** Mesh playing the montage */
+	TWeakObjectPtr<USkeletalMeshComponent> ActiveMesh;
+
+	/** Precomputed timeline for the active montage */
+	TSharedPtr<const FMYPMontageTimeline> ActiveTimeline;
+
+	/** Montage play rate */
+	float PlayRate = 1.0f;
+
+	/** Index of the section currently playing */
+	int32 SectionIndex = INDEX_NONE;
+
+	/** Index of the next notify to fire */
+	int32 NextNotifyIndex = 0;
+
+	/** Montage position at the anchor time */
+	float AnchorPosition = 0.0f;
+
+	/** Timeline time at which the montage was at the anchor position */
+	double AnchorTime = 0.0;
+
+	/** Timeline time of the scheduled event */
+	double ScheduledTime = 0.0;
+
+	/** Timer for the scheduled event */
+	FMYPTimerHandle EventTimer;
+
+	/** If true, the timeline is currently handling an event */
+	bool bHandlingEvent = false;
+
+public:
+
+	/** Constructor */
+	UMYPGameplayTimelineComponent();
+
+	/** Starts driving the gameplay notifies of a montage that was just played on the given mesh */
+	void PlayMontage(UAnimMontage* Montage, USkeletalMeshComponent* Mesh, float InPlayRate = 1.0f, float StartPosition = 0.0f);
+
+	/** Mirrors a montage section jump */
+	void JumpToSection(FName SectionName);
+
+	/** Stops driving the montage. If a montage is provided, only stops if it's the active one */
+	void Stop(const UAnimMontage* Montage = nullptr);
+
+	/** Returns true if this timeline is driving the gameplay notifies of the given animation */
+	bool IsDrivingAnimation(const UAnimSequenceBase* Animation) const;
+
+protected:
+
+	/** Schedules the next notify or section end */
+	void ScheduleNextEvent();
+
+	/** Handles a scheduled timeline event */
+	void HandleEvent();
+
+	/** Moves the timeline to the start of a section */
+	void EnterSection(int32 NewSectionIndex, double Time);
+
+	/** Returns the current timeline time, or the exact event time while handling an event */
+	double GetCurrentTime() const;
+
+	/** Cleanup */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+};
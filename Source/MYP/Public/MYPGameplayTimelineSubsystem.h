@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "MYPGameplayTimelineSubsystem.generated.h"
+
+class UAnimMontage;
+class UMYPGameplayAnimNotify;
+
+/**
+ *  Precomputed gameplay notify timing for a single montage section
+ */
+struct FMYPMontageTimelineSection
+{
+	/** Section start time in the montage */
+	float StartTime = 0.0f;
+
+	/** Section end time in the montage */
+	float EndTime = 0.0f;
+
+	/** Index of the section that plays after this one, or INDEX_NONE if the montage ends here */
+	int32 NextSectionIndex = INDEX_NONE;
+
+	/** Index of this section's first notify in the timeline's notify list */
+	int32 FirstNotify = 0;
+
+	/** Number of gameplay notifies in this section */
+	int32 NumNotifies = 0;
+};
+
+/**
+ *  A single gameplay notify in a montage timeline
+ */
+struct FMYPMontageTimelineNotify
+{
+	/** Trigger time in the montage */
+	float Time = 0.0f;
+
+	/** Notify to fire. Owned by the montage */
+	UMYPGameplayAnimNotify* Notify = nullptr;
+};
+
+/**
+ *  Precomputed gameplay notify timing for a montage, grouped by section and sorted by time
+ */
+struct FMYPMontageTimeline
+{
+	/** Montage sections, in the montage's section order */
+	TArray<FMYPMontageTimelineSection> Sections;
+
+	/** Gameplay notifies, grouped by section */
+	TArray<FMYPMontageTimelineNotify> Notifies;
+};
+
+/**
+ *  Caches the gameplay notify timing of montages for Gameplay Timeline Components.
+ *  Timeline events themselves are scheduled on the MYP Timer Subsystem.
+ */
+UCLASS()
+class MYP_API UMYPGameplayTimelineSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Cached montage timelines */
+	TMap<TObjectKey<UAnimMontage>, TSharedPtr<const FMYPMontageTimeline>> MontageTimelines;
+
+public:
+
+	/** Returns the precomputed timeline for a montage, building it on first use */
+	TSharedPtr<const FMYPMontageTimeline> GetMontageTimeline(const UAnimMontage* Montage);
+
+protected:
+
+	/** Builds the timeline for a montage */
+	static TSharedPtr<const FMYPMontageTimeline> BuildMontageTimeline(const UAnimMontage* Montage);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Releases the cached timelines */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
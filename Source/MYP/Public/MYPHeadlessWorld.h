@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+class ULevelStreamingDynamic;
+
+/**
+ *  A game world that lives outside the engine loop, for benchmarks and simulations.
+ *  - Starts empty, or with a level streamed in as an instance, so several copies of the same level can exist side by side
+ *  - Play doesn't begin until BeginPlay is called, so the level's actors can be adjusted before they start
+ *  - Only ticks when told to, at whatever time step the owner wants
+ *  The world is torn down when this is destroyed. Collect garbage afterwards to reclaim it.
+ */
+class MYP_API FMYPHeadlessWorld
+{
+	/** World we own */
+	UWorld* World = nullptr;
+
+	/** Streaming level holding the loaded level. The world references it, so it lives as long as the world does */
+	ULevelStreamingDynamic* LevelInstance = nullptr;
+
+public:
+
+	/**
+	 *  Creates the world.
+	 *  @param Name       Unique name for the world
+	 *  @param LevelPath  Long package name of a level to load into it, as in /Game/Maps/MyLevel. May be empty
+	 */
+	explicit FMYPHeadlessWorld(FName Name, const FString& LevelPath = FString());
+
+	/** Tears the world down */
+	~FMYPHeadlessWorld();
+
+	UE_NONCOPYABLE(FMYPHeadlessWorld);
+
+	/** Returns the world */
+	UWorld* GetWorld() const { return World; }
+
+	/** Returns true if the level was requested and made it into the world */
+	bool HasLevel() const;
+
+	/** Initializes the actors and begins play. Actors spawned from here on begin play as they're spawned */
+	void BeginPlay();
+
+	/** Advances the world by one step. The frame counter is left alone, so several worlds can share a frame */
+	void Tick(float DeltaSeconds);
+};
@@ -0,0 +1,147 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "MYPLoadTestSubsystem.generated.h"
+
+/**
+ *  How a load test ramps up its bots
+ */
+struct MYP_API FMYPLoadTestSettings
+{
+	/** Bots to end the ramp with */
+	int32 MaxBots = 100;
+
+	/** Bots launched at each step of the ramp */
+	int32 BotsPerStep = 1;
+
+	/** Time between steps, in seconds */
+	float StepInterval = 10.0f;
+
+	/** Time to let the server settle after the client count changes before sampling it, in seconds */
+	float SettleTime = 2.0f;
+
+	/** Bot script asset the clients play. Empty for the built-in wander script */
+	FString Script;
+
+	/** File the results are written to */
+	FString Output;
+};
+
+/**
+ *  Server cost measured at one client count
+ */
+struct MYP_API FMYPLoadTestStep
+{
+	/** Clients connected while sampling */
+	int32 Clients = 0;
+
+	/** Frames sampled */
+	int32 Frames = 0;
+
+	/** Game thread time per frame, in milliseconds */
+	double MeanTickMs = 0.0;
+	double P95TickMs = 0.0;
+	double MaxTickMs = 0.0;
+
+	/** Bandwidth sent to and received from all clients, in bytes per second */
+	double MeanOutBytesPerSecond = 0.0;
+	double MeanInBytesPerSecond = 0.0;
+};
+
+/**
+ *  Measures how the server scales with the number of players.
+ *  Run MYP.LoadTest.Run on a listen or dedicated server. It launches headless bot clients on this machine (see UMYPBotSubsystem),
+ *  a few at a time, and samples the server's game thread time and bandwidth at every client count.
+ *  The results are logged as a table and written as JSON once the ramp is done.
+ *  Bots are launched from this process's own executable, so the server must be a game or editor binary. Cooked dedicated server builds can't run load tests.
+ */
+UCLASS()
+class MYP_API UMYPLoadTestSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Samples taken at one client count */
+	struct FSamples
+	{
+		/** Game thread time of each frame, in milliseconds */
+		TArray<double> TickMs;
+
+		/** Total bandwidth over the sampled frames, in bytes per second */
+		double OutBytesPerSecond = 0.0;
+		double InBytesPerSecond = 0.0;
+	};
+
+	/** Settings of the running test */
+	FMYPLoadTestSettings Settings;
+
+	/** Bot client processes launched so far */
+	TArray<FProcHandle> Clients;
+
+	/** Samples for each client count */
+	TMap<int32, FSamples> Samples;
+
+	/** Time since the last step of the ramp */
+	float TimeSinceStep = 0.0f;
+
+	/** Time since the client count last changed */
+	float TimeSinceClientsChanged = 0.0f;
+
+	/** Client count last frame */
+	int32 LastClientCount = INDEX_NONE;
+
+	/** Port the server is listening on, for the bots to join */
+	int32 ServerPort = 0;
+
+	/** If true, a test is running */
+	bool bRunning = false;
+
+public:
+
+	/** Returns the load test subsystem for the world the context object lives in */
+	static UMYPLoadTestSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Starts a load test. Fails if one is already running, the world isn't a server, or this is a dedicated server build */
+	bool StartTest(const FMYPLoadTestSettings& InSettings);
+
+	/** Ends the running test, closes the bot clients and reports the results */
+	void StopTest();
+
+	/** Returns true if a test is running */
+	bool IsRunning() const { return bRunning; }
+
+protected:
+
+	/** Launches the next bots of the ramp */
+	void LaunchBots(int32 Count);
+
+	/** Ramps the bots up and samples the server */
+	void TickTest(float DeltaTime);
+
+	/** Reduces the samples to one step per client count, in client order */
+	void Summarize(TArray<FMYPLoadTestStep>& OutSteps) const;
+
+	/** Writes the results as JSON */
+	bool SaveResults(const FString& Filename, TConstArrayView<FMYPLoadTestStep> Steps) const;
+
+	/** Closes every bot client */
+	void CloseClients();
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Load tests are a development tool */
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/** Sets up the sampling tick */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Stops the running test */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
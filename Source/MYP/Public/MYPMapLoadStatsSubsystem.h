@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "MYPMapLoadStatsSubsystem.generated.h"
+
+/**
+ *  Logs how long each map takes to load and how much memory and how many UObjects are resident once it's up.
+ *  The first map also reports the time since process start, to compare startup cost between builds.
+ */
+UCLASS()
+class MYP_API UMYPMapLoadStatsSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+	/** Time when the current map load started */
+	double LoadStartTime = 0.0;
+
+	/** Physical memory in use when the current map load started */
+	uint64 LoadStartUsedPhysical = 0;
+
+	/** Name of the map being loaded */
+	FString LoadingMapName;
+
+	/** If true, the first map load hasn't been reported yet */
+	bool bFirstMap = true;
+
+	/** Delegate handles */
+	FDelegateHandle PreLoadMapHandle;
+	FDelegateHandle PostLoadMapHandle;
+
+protected:
+
+	/** Records the load start time and memory */
+	void HandlePreLoadMap(const FString& MapName);
+
+	/** Logs the load time and resident memory for the loaded map */
+	void HandlePostLoadMap(UWorld* LoadedWorld);
+
+public:
+
+	// ~begin USubsystem interface
+
+	/** Subscribes to map load events */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Unsubscribes from map load events */
+	virtual void Deinitialize() override;
+
+	// ~end USubsystem interface
+};
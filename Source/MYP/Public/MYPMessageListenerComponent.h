@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "MYPMessageListenerComponent.generated.h"
+
+struct FMYPMessage;
+
+/** Message received delegate for Blueprint listeners */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FMYPMessageReceivedDelegate, FName, Channel, AActor*, Instigator);
+
+/**
+ *  Thin Blueprint adapter for the MYP Message Subsystem.
+ *  Listens on a list of channels for any message type, and forwards the channel and instigator to a Blueprint event.
+ *  Native code should subscribe to the subsystem directly instead.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class MYP_API UMYPMessageListenerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Channels to listen on */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Messages")
+	TArray<FName> Channels;
+
+public:
+
+	/** Called for every message received on the listened channels */
+	UPROPERTY(BlueprintAssignable, Category="Messages")
+	FMYPMessageReceivedDelegate OnMessageReceived;
+
+	/** Constructor */
+	UMYPMessageListenerComponent();
+
+protected:
+
+	/** Subscribes to the channels */
+	virtual void BeginPlay() override;
+
+	/** Removes the subscriptions */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Forwards a message to the Blueprint delegate */
+	void HandleMessage(FName Channel, const FMYPMessage& Message);
+};
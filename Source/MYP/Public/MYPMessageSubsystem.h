@@ -0,0 +1,198 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "MYPMessageSubsystem.generated.h"
+
+/**
+ *  Base for all gameplay messages sent through the MYP Message Subsystem.
+ *  Derived messages must be USTRUCTs so they can be type checked and copied into the deferred queue.
+ */
+USTRUCT(BlueprintType)
+struct MYP_API FMYPMessage
+{
+	GENERATED_BODY()
+
+	/** Actor that caused the message */
+	UPROPERTY(BlueprintReadOnly, Category="Message")
+	TWeakObjectPtr<AActor> Instigator;
+};
+
+/** Type-erased message callback. The message is guaranteed to be of the type the listener subscribed with */
+DECLARE_DELEGATE_TwoParams(FMYPMessageDelegate, FName /*Channel*/, const FMYPMessage& /*Message*/);
+
+/**
+ *  Handle to a message subscription
+ */
+struct FMYPMessageHandle
+{
+	/** Channel the subscription listens on */
+	FName Channel;
+
+	/** Unique subscription id */
+	int32 Id = INDEX_NONE;
+
+	/** Returns true if this handle was ever assigned a subscription */
+	bool IsValid() const { return Id != INDEX_NONE; }
+
+	/** Resets the handle */
+	void Invalidate() { Channel = NAME_None; Id = INDEX_NONE; }
+};
+
+/**
+ *  Typed gameplay message bus.
+ *  - Listeners subscribe to a named channel for a message type, and are called natively without reflection
+ *  - Immediate broadcasts walk the channel's listener array in place and don't allocate
+ *  - Deferred broadcasts are copied into a reused buffer and delivered together once per frame
+ *  - Listeners are weakly bound to their owning object, and are dropped once it's gone
+ */
+UCLASS()
+class MYP_API UMYPMessageSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** A single subscription */
+	struct FListener
+	{
+		/** Callback to run for each message */
+		FMYPMessageDelegate Callback;
+
+		/** Message type the listener expects. Messages of derived types are delivered too */
+		const UScriptStruct* MessageType = nullptr;
+
+		/** Object that owns the subscription */
+		TObjectKey<UObject> Owner;
+
+		/** Unique subscription id */
+		int32 Id = INDEX_NONE;
+	};
+
+	/** A message waiting in the deferred queue */
+	struct FDeferredMessage
+	{
+		/** Channel to deliver the message on */
+		FName Channel;
+
+		/** Type of the message */
+		const UScriptStruct* MessageType = nullptr;
+
+		/** Offset of the message in the deferred buffer */
+		int32 Offset = 0;
+	};
+
+	/** Byte buffer holding deferred messages. Aligned for any message type */
+	using FMessageBuffer = TArray<uint8, TAlignedHeapAllocator<16>>;
+
+	/** Listeners for each channel */
+	TMap<FName, TArray<FListener>> Channels;
+
+	/** Subscriptions made while a broadcast was running. Added once it's done, so listener arrays don't move under it */
+	TArray<TPair<FName, FListener>> PendingListeners;
+
+	/** Deferred messages, in broadcast order */
+	TArray<FDeferredMessage> DeferredMessages;
+
+	/** Storage for the deferred messages */
+	FMessageBuffer DeferredBuffer;
+
+	/** Deferred messages being delivered. Kept around to reuse the allocations */
+	TArray<FDeferredMessage> DeliveringMessages;
+
+	/** Storage for the messages being delivered */
+	FMessageBuffer DeliveringBuffer;
+
+	/** Id for the next subscription */
+	int32 NextListenerId = 0;
+
+	/** Number of broadcasts currently running */
+	int32 BroadcastDepth = 0;
+
+	/** If true, some listeners were removed during a broadcast and the arrays need compacting */
+	bool bNeedsCompaction = false;
+
+public:
+
+	/** Returns the message subsystem for the world the context object lives in */
+	static UMYPMessageSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Subscribes a functor taking (FName Channel, const TMessage& Message). The functor is dropped when the owner is destroyed */
+	template<typename TMessage, typename FunctorType>
+	FMYPMessageHandle Subscribe(FName Channel, UObject* Owner, FunctorType&& Functor)
+	{
+		static_assert(TIsDerivedFrom<TMessage, FMYPMessage>::Value, "Messages must derive from FMYPMessage");
+
+		return SubscribeMessage(Channel, TMessage::StaticStruct(), Owner, FMYPMessageDelegate::CreateWeakLambda(Owner, [Functor = Forward<FunctorType>(Functor)](FName InChannel, const FMYPMessage& Message)
+		{
+			Functor(InChannel, static_cast<const TMessage&>(Message));
+		}));
+	}
+
+	/** Subscribes a member function taking (FName Channel, const TMessage& Message) */
+	template<typename TMessage, typename UserClass>
+	FMYPMessageHandle Subscribe(FName Channel, UserClass* Owner, void (UserClass::*Function)(FName, const TMessage&))
+	{
+		return Subscribe<TMessage>(Channel, Owner, [Owner, Function](FName InChannel, const TMessage& Message)
+		{
+			(Owner->*Function)(InChannel, Message);
+		});
+	}
+
+	/** Subscribes a type-erased callback. Used by adapters that don't know the message type at compile time */
+	FMYPMessageHandle SubscribeMessage(FName Channel, const UScriptStruct* MessageType, UObject* Owner, FMYPMessageDelegate&& Callback);
+
+	/** Removes a subscription and invalidates the handle */
+	void Unsubscribe(FMYPMessageHandle& Handle);
+
+	/** Removes all subscriptions owned by an object */
+	void UnsubscribeAll(const UObject* Owner);
+
+	/** Delivers a message to the channel's listeners right away */
+	template<typename TMessage>
+	void Broadcast(FName Channel, const TMessage& Message)
+	{
+		static_assert(TIsDerivedFrom<TMessage, FMYPMessage>::Value, "Messages must derive from FMYPMessage");
+
+		BroadcastMessage(Channel, TMessage::StaticStruct(), Message);
+	}
+
+	/** Queues a copy of a message, to be delivered with the rest of this frame's deferred messages */
+	template<typename TMessage>
+	void BroadcastDeferred(FName Channel, const TMessage& Message)
+	{
+		static_assert(TIsDerivedFrom<TMessage, FMYPMessage>::Value, "Messages must derive from FMYPMessage");
+
+		QueueMessage(Channel, TMessage::StaticStruct(), Message);
+	}
+
+	/** Type-erased immediate broadcast. The message must be of the given type */
+	void BroadcastMessage(FName Channel, const UScriptStruct* MessageType, const FMYPMessage& Message);
+
+	/** Type-erased deferred broadcast. The message must be of the given type */
+	void QueueMessage(FName Channel, const UScriptStruct* MessageType, const FMYPMessage& Message);
+
+protected:
+
+	/** Adds the listeners subscribed during a broadcast, and removes the unsubscribed ones */
+	void FlushListenerChanges();
+
+	/** Destroys the messages in a deferred buffer and empties it */
+	static void ResetDeferred(TArray<FDeferredMessage>& Messages, FMessageBuffer& Buffer);
+
+	/** Delivers the deferred messages */
+	void TickDeliver(float DeltaTime);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Sets up the deliver tick */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Drops any undelivered messages and all listeners */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
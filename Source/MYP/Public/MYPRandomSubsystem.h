@@ -0,0 +1,94 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "UObject/ObjectKey.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "MYPRandomSubsystem.generated.h"
+
+/**
+ *  Deterministic random numbers for gameplay decisions.
+ *  Every actor draws from a stream of its own, seeded from the world seed and an ID that's the same from run to run:
+ *  - Actors placed in the level are identified by their name
+ *  - Spawned actors are identified by the owner they were spawned with, or their class if they had none, and their order among its spawns.
+ *    A pawn possessed while it spawns is numbered before its controller takes ownership, so enemies stay tied to their spawner
+ *  An actor's draws then only depend on its own history, not on how other actors' decisions interleave with it.
+ *  The world seed comes from -MYPSeed=<n> on the command line. Without it, each world picks one and logs it so the run can be repeated.
+ */
+UCLASS()
+class MYP_API UMYPRandomSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Seed every stream in the world is derived from */
+	int32 WorldSeed = 0;
+
+	/** Stable IDs of the actors spawned so far. Zero until the ID is assigned, once the spawn has finished or the actor first asks for a stream */
+	TMap<TObjectKey<AActor>, uint32> SpawnedActorIds;
+
+	/** Spawns counted so far for each owner or class ID */
+	TMap<uint32, uint32> SpawnCounts;
+
+	/** Actors whose spawn is in progress, outermost first. Spawns nest when an actor spawns others, like its controller, while it's initialized */
+	TArray<TWeakObjectPtr<AActor>, TInlineAllocator<4>> SpawningActors;
+
+	/** Streams handed out so far */
+	TMap<TObjectKey<AActor>, FRandomStream> Streams;
+
+	/** Handler marking actors as spawned before they're initialized */
+	FDelegateHandle ActorPreSpawnHandle;
+
+	/** Handler numbering actors once their spawn has finished */
+	FDelegateHandle ActorSpawnedHandle;
+
+	/** Destroyed actor handler */
+	FDelegateHandle ActorDestroyedHandle;
+
+public:
+
+	/** Returns the random subsystem for the world the context object lives in */
+	static UMYPRandomSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Returns the seed passed with -MYPSeed, if there is one */
+	static bool GetCommandLineSeed(int32& OutSeed);
+
+	/** Returns the actor's stream, creating it on first use. Falls back to a stream seeded from the global RNG if there's no subsystem for the actor's world. Draw from it right away rather than keeping the reference */
+	static FRandomStream& GetStream(const AActor* Actor);
+
+	/** Returns the world seed */
+	int32 GetWorldSeed() const { return WorldSeed; }
+
+	/** Sets the world seed. Streams already handed out are reseeded, so call it before play begins to make the whole run reproducible */
+	void SetWorldSeed(int32 NewSeed);
+
+	/** Returns the actor's stream, creating it on first use */
+	FRandomStream& GetActorStream(const AActor* Actor);
+
+	/** Returns the ID the actor's stream is seeded from, assigning it if the actor was spawned and doesn't have one yet */
+	uint32 GetStableActorId(const AActor* Actor);
+
+protected:
+
+	/** Marks an actor as spawned, before its owner is known. Numbers the spawns already in progress, while they still have the owner they were spawned with */
+	void HandleActorPreSpawn(AActor* Actor);
+
+	/** Assigns spawned actors their ID, in spawn order */
+	void HandleActorSpawned(AActor* Actor);
+
+	/** Drops the ID and stream of a destroyed actor */
+	void HandleActorDestroyed(AActor* Actor);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Picks the world seed and starts numbering spawned actors */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Stops listening for spawns */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
@@ -0,0 +1,47 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "MYPSubsystemTickFunction.generated.h"
+
+/** Delegate executed when a subsystem tick function runs */
+DECLARE_DELEGATE_OneParam(FMYPSubsystemTickDelegate, float /*DeltaTime*/);
+
+/**
+ *  Tick function that allows a World Subsystem to run its update at a specific tick group.
+ *  Owned and registered by UMYPTickableWorldSubsystem.
+ */
+USTRUCT()
+struct MYP_API FMYPSubsystemTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	/** Delegate to execute when this tick function runs */
+	FMYPSubsystemTickDelegate TickDelegate;
+
+	/** Name reported by tick diagnostics */
+	FString DiagnosticName;
+
+	/** Smoothed cost of the subsystem update, in milliseconds. Reported in tick diagnostics */
+	double AverageCostMs = 0.0;
+
+	/** Forwards the tick to the owning subsystem */
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	/** Returns the diagnostic message for this tick function */
+	virtual FString DiagnosticMessage() override;
+
+	/** Returns the diagnostic context for this tick function */
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FMYPSubsystemTickFunction> : public TStructOpsTypeTraitsBase2<FMYPSubsystemTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+#include <type_traits>
+
+/**
+ *  Returns true if a native actor or component class does work in its tick.
+ *  Taking the address of an inherited member function gives a pointer typed on the class that declared it,
+ *  so the type only differs from the engine base's when the class, or one of its parents, declares its own override.
+ */
+template<typename T>
+constexpr bool MYPOverridesNativeTick()
+{
+	if constexpr (std::is_base_of_v<AActor, T>)
+	{
+		return !std::is_same_v<decltype(&T::Tick), decltype(&AActor::Tick)>
+			|| !std::is_same_v<decltype(&T::TickActor), decltype(&AActor::TickActor)>;
+	}
+	else
+	{
+		static_assert(std::is_base_of_v<UActorComponent, T>, "Only actors and components have tick functions to audit");
+
+		return !std::is_same_v<decltype(&T::TickComponent), decltype(&UActorComponent::TickComponent)>;
+	}
+}
+
+/** Static registration of a native class's tick override, read by the tick auditor */
+struct MYP_API FMYPNativeTickRegistration
+{
+	FMYPNativeTickRegistration(UClass* (*StaticClassFunc)(), bool bOverridesTick);
+
+	/** Returns true and fills in the result if the class has been registered */
+	static bool FindOverridesTick(const UClass* Class, bool& bOutOverridesTick);
+};
+
+/**
+ *  Lets the tick auditor know for certain whether a native class overrides Tick, TickActor or TickComponent.
+ *  Use it once in the class's .cpp. Unregistered classes fall back to a guess based on their default tick settings.
+ */
+#define MYP_AUDIT_TICK(Class) \
+	static const FMYPNativeTickRegistration PREPROCESSOR_JOIN(GMYPNativeTickRegistration_, Class)(&Class::StaticClass, MYPOverridesNativeTick<Class>())
@@ -0,0 +1,113 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "MYPTickAuditSubsystem.generated.h"
+
+class AActor;
+class UActorComponent;
+struct FTickFunction;
+
+/**
+ *  Audit result for a single actor or component tick function
+ */
+struct FMYPTickAuditEntry
+{
+	/** Actor or component that owns the tick function */
+	TWeakObjectPtr<UObject> Object;
+
+	/** Tick group the function runs in */
+	TEnumAsByte<ETickingGroup> TickGroup = TG_PrePhysics;
+
+	/** Tick interval in seconds. Zero means every frame */
+	float TickInterval = 0.0f;
+
+	/** If true, the tick function is currently enabled */
+	bool bEnabled = false;
+
+	/** If true, the object's native class overrides its tick. Exact for classes registered with MYP_AUDIT_TICK, a guess from the default tick settings otherwise */
+	bool bHasNativeTick = false;
+
+	/** If true, the object's Blueprint implements the Tick event */
+	bool bHasScriptTick = false;
+
+	/** Returns true if this tick function runs without doing any work */
+	bool IsRedundant() const { return !bHasNativeTick && !bHasScriptTick; }
+};
+
+/**
+ *  Audits the actor and component tick functions registered in the world.
+ *  Flags tick functions whose object neither overrides Tick natively nor implements the Blueprint Tick event,
+ *  and optionally unregisters them once actors have begun play. See MYP.Ticks.Audit and MYP.Ticks.AutoDisable.
+ *  Tick functions are only registered in BeginPlay, so the pass runs from a tick function of its own at the end of the frame.
+ */
+UCLASS()
+class MYP_API UMYPTickAuditSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Actors spawned since the last pass */
+	TArray<TWeakObjectPtr<AActor>> PendingActors;
+
+	/** Handle to the actor spawned delegate */
+	FDelegateHandle ActorSpawnedHandle;
+
+	/** If true, the actors present at begin play have been through the pass */
+	bool bLevelActorsProcessed = false;
+
+	/** Number of tick functions unregistered by this subsystem */
+	int32 NumDisabledTicks = 0;
+
+public:
+
+	/** Collects the registered actor and component tick functions in the world */
+	void Audit(TArray<FMYPTickAuditEntry>& OutEntries) const;
+
+	/** Logs the audit results. Optionally includes the engine's full tick function dump */
+	void LogAudit(bool bIncludeAllTickFunctions) const;
+
+	/** Unregisters the redundant tick functions of an actor and its components. Returns the number of tick functions removed */
+	int32 DisableRedundantTicks(AActor* Actor);
+
+	/** Returns the number of tick functions unregistered by this subsystem */
+	int32 GetNumDisabledTicks() const { return NumDisabledTicks; }
+
+protected:
+
+	/** Fills out an audit entry for a tick function */
+	void FillEntry(FMYPTickAuditEntry& Entry, UObject* Object, const FTickFunction& TickFunction) const;
+
+	/**
+	 *  Returns true if the class's native parent does work in its tick.
+	 *  Uses the MYP_AUDIT_TICK registration when there is one, and otherwise assumes a native parent that turns its tick on overrides it,
+	 *  beyond the engine base classes that only forward to Blueprint.
+	 */
+	static bool HasNativeTick(const UClass* Class);
+
+	/** Returns true if the class implements the Blueprint Tick event */
+	static bool HasScriptTick(const UClass* Class);
+
+	/** Queues actors spawned after begin play for the next pass */
+	void HandleActorSpawned(AActor* Actor);
+
+	/** Unregisters the redundant ticks of the level actors on the first frame, and of the queued actors after that */
+	void DisablePendingTicks(float DeltaTime);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Sets up the pass tick */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Starts listening for spawned actors */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Removes the actor spawned delegate */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
@@ -0,0 +1,80 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/World.h"
+#include "MYPSubsystemTickFunction.h"
+#include "MYPTickableWorldSubsystem.generated.h"
+
+/**
+ *  Base class for the gameplay World Subsystems.
+ *  - Only created for game and PIE worlds
+ *  - Optionally owns a tick function that runs in a chosen tick group. Subclasses set it up from Initialize,
+ *    it's registered once the world begins play and unregistered when the subsystem is deinitialized
+ *  - The tick can be switched on and off at any time, including before the world begins play
+ */
+UCLASS(Abstract)
+class MYP_API UMYPTickableWorldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Tick function that runs the subsystem update */
+	FMYPSubsystemTickFunction SubsystemTickFunction;
+
+	/** Requested tick state. Applied to the tick function when it's registered */
+	bool bTickEnabled = false;
+
+public:
+
+	/** Returns the subsystem of the given class for the world the context object lives in */
+	template<typename T>
+	static T* Get(const UObject* WorldContextObject)
+	{
+		const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+		return World ? World->GetSubsystem<T>() : nullptr;
+	}
+
+	// ~begin UWorldSubsystem interface
+
+	/** Registers the subsystem tick function, if one was set up */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Unregisters the subsystem tick function */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+
+protected:
+
+	/** Only create gameplay subsystems for game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 *  Sets up the subsystem tick. Call it from Initialize.
+	 *  @param TickMethod		Subsystem method to run every tick
+	 *  @param TickGroup		Tick group to run the method in
+	 *  @param DiagnosticName	Name shown in tick dumps and profiler captures
+	 *  @param TickInterval		Time between ticks, in seconds. Zero ticks every frame
+	 *  @param bStartEnabled	If false, the tick stays off until SetTickEnabled is called
+	 */
+	template<typename T>
+	void SetupTick(void (T::*TickMethod)(float), ETickingGroup TickGroup, const TCHAR* DiagnosticName, float TickInterval = 0.0f, bool bStartEnabled = true)
+	{
+		SubsystemTickFunction.TickGroup = TickGroup;
+		SubsystemTickFunction.TickInterval = TickInterval;
+		SubsystemTickFunction.DiagnosticName = DiagnosticName;
+		SubsystemTickFunction.TickDelegate.BindUObject(CastChecked<T>(this), TickMethod);
+		bTickEnabled = bStartEnabled;
+	}
+
+	/** Turns the subsystem tick on or off. Safe to call before the world begins play and from within the tick */
+	void SetTickEnabled(bool bEnabled);
+
+	/** Returns true if the tick has been requested on */
+	bool IsTickEnabled() const { return bTickEnabled; }
+
+	/** Returns true once the tick function has been registered with the world */
+	bool IsTickRegistered() const { return SubsystemTickFunction.IsTickFunctionRegistered(); }
+};
@@ -0,0 +1,218 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Engine/EngineTypes.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "MYPTimerSubsystem.generated.h"
+
+/**
+ *  Handle to a timer scheduled on the MYP Timer Subsystem.
+ *  Handles become stale once their timer fires (non-looping), is cleared or its owner ends play.
+ */
+struct FMYPTimerHandle
+{
+	/** Index of the timer node */
+	int32 Index = INDEX_NONE;
+
+	/** Serial number of the timer node when the handle was issued */
+	uint32 Serial = 0;
+
+	/** Returns true if this handle was ever assigned a timer. Use the subsystem to check if the timer is still active */
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	/** Resets the handle */
+	void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+
+	bool operator==(const FMYPTimerHandle& Other) const { return Index == Other.Index && Serial == Other.Serial; }
+	bool operator!=(const FMYPTimerHandle& Other) const { return !(*this == Other); }
+};
+
+/**
+ *  Hierarchical timer wheel for gameplay timers.
+ *  - Scheduling and cancelling a timer are O(1)
+ *  - Per frame cost depends on the number of due timers, not on the number of scheduled timers
+ *  - Timers are owned by an actor and are cancelled automatically when it ends play
+ */
+UCLASS()
+class MYP_API UMYPTimerSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Number of bits per wheel level */
+	static constexpr int32 SlotBits = 6;
+
+	/** Number of slots per wheel level */
+	static constexpr int32 NumSlots = 1 << SlotBits;
+
+	/** Slot index mask */
+	static constexpr int32 SlotMask = NumSlots - 1;
+
+	/** Number of wheel levels */
+	static constexpr int32 NumLevels = 4;
+
+	/** Index of the list holding the timers being fired */
+	static constexpr int32 FiringList = NumLevels * NumSlots;
+
+	/** Wheel resolution, in ticks per second */
+	static constexpr double TicksPerSecond = 120.0;
+
+	/** A single timer. Nodes are pooled and linked into both a wheel slot list and their owner's list */
+	struct FTimerNode
+	{
+		/** Callback to run when the timer fires */
+		FSimpleDelegate Callback;
+
+		/** Owning actor */
+		TObjectKey<AActor> Owner;
+
+		/** Wheel tick at which the timer fires */
+		int64 ExpireTick = 0;
+
+		/** Loop interval in ticks, or zero for one-shot timers */
+		int64 LoopTicks = 0;
+
+		/** Previous and next nodes in the slot list */
+		int32 SlotPrev = INDEX_NONE;
+		int32 SlotNext = INDEX_NONE;
+
+		/** Previous and next nodes in the owner list */
+		int32 OwnerPrev = INDEX_NONE;
+		int32 OwnerNext = INDEX_NONE;
+
+		/** Slot list this node is linked into, as Level * NumSlots + Slot */
+		int32 SlotList = INDEX_NONE;
+
+		/** Serial number, incremented every time the node is freed */
+		uint32 Serial = 1;
+
+		/** If true, the node holds an active timer */
+		bool bActive = false;
+	};
+
+	/** Pooled timer nodes */
+	TArray<FTimerNode> Nodes;
+
+	/** Free node indices */
+	TArray<int32> FreeNodes;
+
+	/** Head node of each slot list for all levels, plus the firing list */
+	int32 SlotHeads[NumLevels * NumSlots + 1];
+
+	/** Head node of each owner's timer list */
+	TMap<TObjectKey<AActor>, int32> OwnerHeads;
+
+	/** Next wheel tick to process */
+	int64 NextTick = 0;
+
+	/** Number of active timers */
+	int32 NumActiveTimers = 0;
+
+public:
+
+	/** Constructor */
+	UMYPTimerSubsystem();
+
+	/**
+	 *  Returns the timer subsystem for the world the context object lives in.
+	 *  Every game world has one, so this ensures if it's missing from a running game world rather than letting callers drop their timers.
+	 */
+	static UMYPTimerSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 *  Schedules a timer owned by an actor.
+	 *  @param Owner		Actor that owns the timer. Its timers are cleared when it ends play
+	 *  @param Delay		Time in seconds until the timer fires
+	 *  @param Callback		Delegate to run when the timer fires
+	 *  @param bLoop		If true, the timer keeps firing every Delay seconds until cleared
+	 */
+	FMYPTimerHandle SetTimer(AActor* Owner, float Delay, FSimpleDelegate&& Callback, bool bLoop = false);
+
+	/** Schedules a timer that calls a member function on its owning actor */
+	template<typename UserClass>
+	FMYPTimerHandle SetTimer(UserClass* Owner, void (UserClass::*Function)(), float Delay, bool bLoop = false)
+	{
+		return SetTimer(Owner, Delay, FSimpleDelegate::CreateUObject(Owner, Function), bLoop);
+	}
+
+	/** Schedules a timer on the handle, clearing the handle's previous timer first */
+	template<typename UserClass>
+	void SetTimer(FMYPTimerHandle& Handle, UserClass* Owner, void (UserClass::*Function)(), float Delay, bool bLoop = false)
+	{
+		ClearTimer(Handle);
+		Handle = SetTimer(Owner, Delay, FSimpleDelegate::CreateUObject(Owner, Function), bLoop);
+	}
+
+	/** Cancels a timer and invalidates the handle */
+	void ClearTimer(FMYPTimerHandle& Handle);
+
+	/** Cancels all timers owned by an actor */
+	void ClearAllTimersForOwner(const AActor* Owner);
+
+	/** Returns true if the handle's timer is still scheduled */
+	bool IsTimerActive(const FMYPTimerHandle& Handle) const;
+
+	/** Returns the time remaining until the handle's timer fires, or -1 if it's not active */
+	float GetTimerRemaining(const FMYPTimerHandle& Handle) const;
+
+	/** Returns the number of active timers */
+	int32 GetNumActiveTimers() const { return NumActiveTimers; }
+
+protected:
+
+	/** Returns the wheel tick for a world time */
+	static int64 TimeToTick(double Time) { return FMath::FloorToInt64(Time * TicksPerSecond); }
+
+	/** Returns the current world time */
+	double GetCurrentTime() const;
+
+	/** Returns the node for a handle, or nullptr if the handle is stale */
+	const FTimerNode* FindNode(const FMYPTimerHandle& Handle) const;
+
+	/** Links a node into the wheel slot matching its expire tick */
+	void LinkToSlot(int32 NodeIndex);
+
+	/** Unlinks a node from its wheel slot */
+	void UnlinkFromSlot(int32 NodeIndex);
+
+	/** Links a node into its owner's list */
+	void LinkToOwner(int32 NodeIndex, AActor* Owner);
+
+	/** Unlinks a node from its owner's list */
+	void UnlinkFromOwner(int32 NodeIndex);
+
+	/** Unlinks and frees a node */
+	void FreeNode(int32 NodeIndex);
+
+	/** Moves all the timers in a slot down to the lower levels */
+	void CascadeSlot(int32 Level, int32 Slot);
+
+	/** Fires all timers due on the given tick */
+	void ProcessTick(int64 Tick);
+
+	/** Advances the wheel to the current time */
+	void TickWheel(float DeltaTime);
+
+	/** Clears all timers for an actor that ended play */
+	UFUNCTION()
+	void HandleOwnerEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Sets up the wheel tick */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Drops all scheduled timers */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+
+protected:
+
+	/** Gameplay timers are needed wherever actors begin play, including game previews */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+};
@@ -0,0 +1,495 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatEnemy.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "CombatAIController.h"
+#include "Components/WidgetComponent.h"
+#include "Engine/DamageEvents.h"
+#include "CombatLifeBar.h"
+#include "MYPTimerSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Animation/AnimInstance.h"
+#include "CombatDamageSubsystem.h"
+#include "CombatLineOfSightSubsystem.h"
+#include "CombatTacticalSubsystem.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "IAnimationBudgetAllocator.h"
+#include "MYPGameplayTimelineComponent.h"
+#include "CombatHurtboxComponent.h"
+#include "CombatHurtboxSubsystem.h"
+#include "MYPMessageSubsystem.h"
+#include "MYPRandomSubsystem.h"
+#include "CombatMessages.h"
+#include "CombatFeedbackProfile.h"
+#include "MYPTickAudit.h"
+#include "MYP.h"
+
+MYP_AUDIT_TICK(ACombatEnemy);
+
+ACombatEnemy::ACombatEnemy(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// bind the attack montage ended delegate
+	OnAttackMontageEnded.BindUObject(this, &ACombatEnemy::AttackMontageEnded);
+
+	// set the AI Controller class by default
+	AIControllerClass = ACombatAIController::StaticClass();
+
+	// use an AI Controller regardless of whether we're placed or spawned
+	AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
+
+	// ignore the controller's yaw rotation
+	bUseControllerRotationYaw = false;
+
+	// create the life bar
+	LifeBar = CreateDefaultSubobject<UWidgetComponent>(TEXT("LifeBar"));
+	LifeBar->SetupAttachment(RootComponent);
+
+	// create the gameplay timeline
+	GameplayTimeline = CreateDefaultSubobject<UMYPGameplayTimelineComponent>(TEXT("GameplayTimeline"));
+
+	// create the hurtbox
+	Hurtbox = CreateDefaultSubobject<UCombatHurtboxComponent>(TEXT("Hurtbox"));
+	Hurtbox->SetupAttachment(RootComponent);
+
+	// set the collision capsule size
+	GetCapsuleComponent()->SetCapsuleSize(35.0f, 90.0f);
+
+	// set the character movement properties
+	GetCharacterMovement()->bUseControllerDesiredRotation = true;
+
+	// let the animation budget allocator throttle distant and off-screen enemies based on view distance
+	if (USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh()))
+	{
+		BudgetedMesh->SetAutoCalculateSignificance(true);
+	}
+
+	// reset HP to maximum
+	CurrentHP = MaxHP;
+}
+
+void ACombatEnemy::DoAIComboAttack()
+{
+	// ignore if we're already playing an attack animation
+	if (bIsAttacking)
+	{
+		return;
+	}
+
+	// raise the attacking flag
+	bIsAttacking = true;
+
+	// keep the mesh at full update rate for the duration of the attack
+	SetAnimationBudgetExempt(true);
+
+	// choose how many times we're going to attack. Draw from our own stream, so runs with the same seed make the same choices
+	TargetComboCount = UMYPRandomSubsystem::GetStream(this).RandRange(1, ComboSectionNames.Num() - 1);
+
+	// reset the attack counter
+	CurrentComboAttack = 0;
+
+	// play the attack montage
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+	{
+		const float MontageLength = AnimInstance->Montage_Play(ComboAttackMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
+
+		// subscribe to montage completed and interrupted events
+		if (MontageLength > 0.0f)
+		{
+			// set the end delegate for the montage
+			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, ComboAttackMontage);
+
+			// drive the gameplay notifies from the timeline
+			GameplayTimeline->PlayMontage(ComboAttackMontage, GetMesh());
+		}
+	}
+}
+
+void ACombatEnemy::DoAIChargedAttack()
+{
+	// ignore if we're already playing an attack animation
+	if (bIsAttacking)
+	{
+		return;
+	}
+
+	// raise the attacking flag
+	bIsAttacking = true;
+
+	// keep the mesh at full update rate for the duration of the attack
+	SetAnimationBudgetExempt(true);
+
+	// choose how many loops are we going to charge for
+	TargetChargeLoops = UMYPRandomSubsystem::GetStream(this).RandRange(MinChargeLoops, MaxChargeLoops);
+
+	// reset the charge loop counter
+	CurrentChargeLoop = 0;
+
+	// play the attack montage
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+	{
+		const float MontageLength = AnimInstance->Montage_Play(ChargedAttackMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
+
+		// subscribe to montage completed and interrupted events
+		if (MontageLength > 0.0f)
+		{
+			// set the end delegate for the montage
+			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, ChargedAttackMontage);
+
+			// drive the gameplay notifies from the timeline
+			GameplayTimeline->PlayMontage(ChargedAttackMontage, GetMesh());
+		}
+	}
+}
+
+void ACombatEnemy::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupted)
+{
+	// stop driving the montage's gameplay notifies
+	GameplayTimeline->Stop(Montage);
+
+	// reset the attacking flag
+	bIsAttacking = false;
+
+	// let the budget allocator throttle the mesh again
+	SetAnimationBudgetExempt(false);
+
+	// call the attack completed delegate so the StateTree can continue execution
+	OnAttackCompleted.ExecuteIfBound();
+}
+
+void ACombatEnemy::SetAnimationBudgetExempt(bool bExempt)
+{
+	USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh());
+
+	if (!BudgetedMesh)
+	{
+		return;
+	}
+
+	if (bExempt)
+	{
+		// take over the significance calculation so the allocator won't throttle us mid-attack
+		BudgetedMesh->SetAutoCalculateSignificance(false);
+
+		if (IAnimationBudgetAllocator* BudgetAllocator = IAnimationBudgetAllocator::Get(GetWorld()))
+		{
+			BudgetAllocator->SetComponentSignificance(BudgetedMesh, 1.0f, true, false, false);
+		}
+	}
+	else
+	{
+		// hand the significance calculation back to the allocator
+		BudgetedMesh->SetAutoCalculateSignificance(true);
+	}
+}
+
+void ACombatEnemy::DoAttackTrace(FName DamageSourceBone)
+{
+	// start at the provided socket location, sweep forward
+	const FVector TraceStart = GetMesh()->GetSocketLocation(DamageSourceBone);
+	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * MeleeTraceDistance);
+
+	// enemies only hit player hurtboxes; they don't knock back boxes or each other
+	if (UCombatHurtboxSubsystem* HurtboxSubsystem = GetWorld()->GetSubsystem<UCombatHurtboxSubsystem>())
+	{
+		FCombatMeleeQuery Query;
+		Query.Attacker = this;
+		Query.TargetFaction = ECombatFaction::Player;
+		Query.Start = TraceStart;
+		Query.End = TraceEnd;
+		Query.Radius = MeleeTraceRadius;
+		Query.Damage = MeleeDamage;
+		Query.KnockbackImpulse = MeleeKnockbackImpulse;
+		Query.LaunchImpulse = MeleeLaunchImpulse;
+
+		HurtboxSubsystem->QueueMeleeQuery(Query);
+	}
+}
+
+void ACombatEnemy::CheckCombo()
+{
+	// increase the combo counter
+	++CurrentComboAttack;
+
+	// do we still have attacks to play in this string?
+	if (CurrentComboAttack < TargetComboCount)
+	{
+		// jump to the next attack section
+		if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+		{
+			AnimInstance->Montage_JumpToSection(ComboSectionNames[CurrentComboAttack], ComboAttackMontage);
+		}
+
+		// keep the gameplay timeline in sync
+		GameplayTimeline->JumpToSection(ComboSectionNames[CurrentComboAttack]);
+	}
+}
+
+void ACombatEnemy::CheckChargedAttack()
+{
+	// increase the charge loop counter
+	++CurrentChargeLoop;
+
+	// jump to either the loop or attack section of the montage depending on whether we hit the loop target
+	const FName NextSection = CurrentChargeLoop >= TargetChargeLoops ? ChargeAttackSection : ChargeLoopSection;
+
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+	{
+		AnimInstance->Montage_JumpToSection(NextSection, ChargedAttackMontage);
+	}
+
+	// keep the gameplay timeline in sync
+	GameplayTimeline->JumpToSection(NextSection);
+}
+
+void ACombatEnemy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
+{
+	// apply the damage and knockback
+	const float ActualDamage = ResolveDamage(Damage, DamageCauser, DamageLocation, DamageImpulse);
+
+	// only play effects if we received nonzero damage
+	if (ActualDamage > 0.0f)
+	{
+		// play the damage effects
+		PlayReceivedDamageFeedback(ActualDamage, DamageLocation, DamageImpulse.GetSafeNormal());
+	}
+}
+
+void ACombatEnemy::ApplyDamageBatch(TConstArrayView<FCombatDamageEvent> DamageEvents)
+{
+	float TotalDamage = 0.0f;
+	FVector LastDamageLocation = FVector::ZeroVector;
+	FVector LastDamageImpulse = FVector::ZeroVector;
+
+	{
+		// defer life bar updates until the whole batch has been applied
+		TGuardValue<bool> BatchGuard(bResolvingDamageBatch, true);
+
+		// apply each damage event in order
+		for (const FCombatDamageEvent& DamageEvent : DamageEvents)
+		{
+			const float ActualDamage = ResolveDamage(DamageEvent.Damage, DamageEvent.DamageCauser.Get(), DamageEvent.DamageLocation, DamageEvent.DamageImpulse);
+
+			// accumulate the received damage and keep the last hit for effects
+			if (ActualDamage > 0.0f)
+			{
+				TotalDamage += ActualDamage;
+				LastDamageLocation = DamageEvent.DamageLocation;
+				LastDamageImpulse = DamageEvent.DamageImpulse;
+			}
+		}
+	}
+
+	// only update the UI and play effects if we received nonzero damage
+	if (TotalDamage > 0.0f)
+	{
+		// update the life bar once if we survived the batch
+		if (CurrentHP > 0.0f)
+		{
+			LifeBarWidget->UpdateLifePercentage(CurrentHP / MaxHP);
+		}
+
+		// play the damage effects once for the whole batch
+		PlayReceivedDamageFeedback(TotalDamage, LastDamageLocation, LastDamageImpulse.GetSafeNormal());
+	}
+}
+
+void ACombatEnemy::PlayReceivedDamageFeedback(float Damage, const FVector& ImpactPoint, const FVector& DamageDirection)
+{
+	if (FeedbackProfile)
+	{
+		FeedbackProfile->HitReceived.Play(this, ImpactPoint, DamageDirection.Rotation());
+	}
+
+	// enemies get hit in crowds, so skip the Blueprint VM unless it's been asked for or there's no profile
+	if (bUseBlueprintFeedback || !FeedbackProfile)
+	{
+		MYP_COUNT_BLUEPRINT_EVENT();
+		ReceivedDamage(Damage, ImpactPoint, DamageDirection);
+	}
+}
+
+float ACombatEnemy::ResolveDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
+{
+	// pass the damage event to the actor
+	FDamageEvent DamageEvent;
+	const float ActualDamage = TakeDamage(Damage, DamageEvent, nullptr, DamageCauser);
+
+	// only process knockback and hit reactions if we received nonzero damage
+	if (ActualDamage > 0.0f)
+	{
+		// apply the knockback impulse
+		GetCharacterMovement()->AddImpulse(DamageImpulse, true);
+
+		// is the character ragdolling?
+		if (GetMesh()->IsSimulatingPhysics())
+		{
+			// apply an impulse to the ragdoll
+			GetMesh()->AddImpulseAtLocation(DamageImpulse * GetMesh()->GetMass(), DamageLocation);
+		}
+
+		// stop the attack montages to interrupt the attack
+		if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+		{
+			AnimInstance->Montage_Stop(0.1f, ComboAttackMontage);
+			AnimInstance->Montage_Stop(0.1f, ChargedAttackMontage);
+		}
+
+		// stop firing the interrupted attack's gameplay notifies
+		GameplayTimeline->Stop();
+	}
+
+	return ActualDamage;
+}
+
+void ACombatEnemy::HandleDeath()
+{
+	// hide the life bar
+	LifeBar->SetHiddenInGame(true);
+
+	// disable the collision capsule to avoid being hit again while dead
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Hurtbox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	// disable character movement
+	GetCharacterMovement()->DisableMovement();
+
+	// enable full ragdoll physics
+	GetMesh()->SetSimulatePhysics(true);
+
+	// dead enemies don't need to look for the player anymore
+	if (UCombatLineOfSightSubsystem* LineOfSight = GetWorld()->GetSubsystem<UCombatLineOfSightSubsystem>())
+	{
+		LineOfSight->UnregisterObserver(this);
+	}
+
+	// free our tactical position for the enemies still fighting
+	if (UCombatTacticalSubsystem* Tactical = GetWorld()->GetSubsystem<UCombatTacticalSubsystem>())
+	{
+		Tactical->ReleaseClaim(this);
+	}
+
+	// play the death effects
+	if (FeedbackProfile)
+	{
+		FeedbackProfile->Destroyed.Play(this, GetActorLocation());
+	}
+
+	// let any listeners know about our death. Deferred, so the deaths from the same damage flush are delivered together
+	if (UMYPMessageSubsystem* Messages = UMYPMessageSubsystem::Get(this))
+	{
+		FCombatEnemyDiedMessage Message;
+		Message.Instigator = this;
+
+		Messages->BroadcastDeferred(CombatChannels::EnemyDied, Message);
+	}
+
+	// set up the death timer
+	if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+	{
+		Timers->SetTimer(DeathTimer, this, &ACombatEnemy::RemoveFromLevel, DeathRemovalTime);
+	}
+}
+
+void ACombatEnemy::ApplyHealing(float Healing, AActor* Healer)
+{
+	// stub
+}
+
+ECombatFaction ACombatEnemy::GetCombatFaction() const
+{
+	return ECombatFaction::Enemy;
+}
+
+void ACombatEnemy::RemoveFromLevel()
+{
+	// destroy this actor
+	Destroy();
+}
+
+float ACombatEnemy::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
+{
+	// only process damage if the character is still alive
+	if (CurrentHP <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	// reduce the current HP
+	CurrentHP -= Damage;
+
+	// have we run out of HP?
+	if (CurrentHP <= 0.0f)
+	{
+		// die
+		HandleDeath();
+	}
+	else
+	{
+		// update the life bar, unless we're resolving a damage batch that will update it once at the end
+		if (!bResolvingDamageBatch)
+		{
+			LifeBarWidget->UpdateLifePercentage(CurrentHP / MaxHP);
+		}
+
+		// enable partial ragdoll physics, but keep the pelvis vertical
+		GetMesh()->SetPhysicsBlendWeight(0.5f);
+		GetMesh()->SetBodySimulatePhysics(PelvisBoneName, false);
+	}
+
+	// return the received damage amount
+	return Damage;
+}
+
+void ACombatEnemy::Landed(const FHitResult& Hit)
+{
+	Super::Landed(Hit);
+
+	// is the character still alive?
+	if (CurrentHP >= 0.0f)
+	{
+		// disable ragdoll physics
+		GetMesh()->SetPhysicsBlendWeight(0.0f);
+	}
+
+	// call the landed Delegate for StateTree
+	OnEnemyLanded.ExecuteIfBound();
+}
+
+void ACombatEnemy::BeginPlay()
+{
+	// reset HP to maximum
+	CurrentHP = MaxHP;
+
+	// we top the HP before BeginPlay so StateTree picks it up at the right value
+	Super::BeginPlay();
+
+	// get the life bar widget from the widget comp
+	LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
+	check(LifeBarWidget);
+
+	// fill the life bar
+	LifeBarWidget->UpdateLifePercentage(1.0f);
+
+	// start tracking line of sight to the player
+	if (UCombatLineOfSightSubsystem* LineOfSight = GetWorld()->GetSubsystem<UCombatLineOfSightSubsystem>())
+	{
+		LineOfSight->RegisterObserver(this);
+	}
+}
+
+void ACombatEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// the StateTree task only releases its claim when it exits, which it doesn't do for enemies destroyed mid-state
+	if (UCombatTacticalSubsystem* Tactical = GetWorld()->GetSubsystem<UCombatTacticalSubsystem>())
+	{
+		Tactical->ReleaseClaim(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
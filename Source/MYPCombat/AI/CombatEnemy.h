@@ -7,12 +7,15 @@
 #include "CombatAttacker.h"
 #include "CombatDamageable.h"
 #include "Animation/AnimMontage.h"
-#include "Engine/TimerHandle.h"
+#include "MYPTimerSubsystem.h"
 #include "CombatEnemy.generated.h"
 
 class UWidgetComponent;
 class UCombatLifeBar;
+class UCombatFeedbackProfile;
 class UAnimMontage;
+class UMYPGameplayTimelineComponent;
+class UCombatHurtboxComponent;
 
 /** Completed attack animation delegate for StateTree */
 DECLARE_DELEGATE(FOnEnemyAttackCompleted);
@@ -20,9 +23,6 @@ DECLARE_DELEGATE(FOnEnemyAttackCompleted);
 /** Landed delegate for StateTree */
 DECLARE_DELEGATE(FOnEnemyLanded);
 
-/** Enemy died delegate */
-DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnemyDied);
-
 /**
  *  An AI-controlled character with combat capabilities.
  *  Its bundled AI Controller runs logic through StateTree
@@ -36,10 +36,18 @@ class ACombatEnemy : public ACharacter, public ICombatAttacker, public ICombatDa
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UWidgetComponent* LifeBar;
 
+	/** Fires gameplay notifies from attack montages independently of the animation update rate */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UMYPGameplayTimelineComponent* GameplayTimeline;
+
+	/** Makes the character visible to melee sweeps from the opposing faction */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UCombatHurtboxComponent* Hurtbox;
+
 public:
 	
-	/** Constructor */
-	ACombatEnemy();
+	/** Constructor. Swaps the character mesh for a budgeted skeletal mesh */
+	ACombatEnemy(const FObjectInitializer& ObjectInitializer);
 
 protected:
 
@@ -63,9 +71,20 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Damage")
 	UCombatLifeBar* LifeBarWidget;
 
+	/** Hit and death effects played natively */
+	UPROPERTY(EditAnywhere, Category="Feedback")
+	TObjectPtr<UCombatFeedbackProfile> FeedbackProfile;
+
+	/** If true, the ReceivedDamage Blueprint event is called on top of the feedback profile. It's always called if there's no profile */
+	UPROPERTY(EditAnywhere, Category="Feedback")
+	bool bUseBlueprintFeedback = false;
+
 	/** If true, the character is currently playing an attack animation */
 	bool bIsAttacking = false;
 
+	/** If true, the character is resolving a batch of damage events and will defer life bar updates until the batch is done */
+	bool bResolvingDamageBatch = false;
+
 	/** Distance ahead of the character that melee attack sphere collision traces will extend */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 500, Units = "cm"))
 	float MeleeTraceDistance = 75.0f;
@@ -131,7 +150,7 @@ protected:
 	float DeathRemovalTime = 5.0f;
 
 	/** Enemy death timer */
-	FTimerHandle DeathTimer;
+	FMYPTimerHandle DeathTimer;
 
 	/** Attack montage ended delegate */
 	FOnMontageEnded OnAttackMontageEnded;
@@ -143,10 +162,6 @@ public:
 	/** Landed internal delegate to notify StateTree tasks. We use this instead of the built-in Landed delegate so we can bind to a Lambda in StateTree tasks */
 	FOnEnemyLanded OnEnemyLanded;
 
-	/** Enemy died delegate. Allows external subscribers to respond to enemy death */
-	UPROPERTY(BlueprintAssignable, Category="Events")
-	FOnEnemyDied OnEnemyDied;
-
 public:
 
 	/** Performs an AI-initiated combo attack. Number of hits will be decided by this character */
@@ -158,6 +173,11 @@ public:
 	/** Called from a delegate when the attack montage ends */
 	void AttackMontageEnded(UAnimMontage* Montage, bool bInterrupted);
 
+protected:
+
+	/** Exempts the mesh from animation budget throttling while attacking, and hands it back to the allocator afterwards */
+	void SetAnimationBudgetExempt(bool bExempt);
+
 public:
 
 	// ~begin ICombatAttacker interface
@@ -186,6 +206,12 @@ public:
 	/** Handles healing events */
 	virtual void ApplyHealing(float Healing, AActor* Healer) override;
 
+	/** Returns the faction this character fights for */
+	virtual ECombatFaction GetCombatFaction() const override;
+
+	/** Handles all damage events received this frame, updating the life bar and effects once */
+	virtual void ApplyDamageBatch(TConstArrayView<FCombatDamageEvent> DamageEvents) override;
+
 	// ~end ICombatDamageable interface
 
 protected:
@@ -203,6 +229,14 @@ public:
 
 protected:
 
+	/** Applies damage, knockback and hit reactions. Returns the amount of damage actually received */
+	float ResolveDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse);
+
+protected:
+
+	/** Plays the damage received feedback, and calls the Blueprint handler if needed */
+	void PlayReceivedDamageFeedback(float Damage, const FVector& ImpactPoint, const FVector& DamageDirection);
+
 	/** Blueprint handler to play damage received effects */
 	UFUNCTION(BlueprintImplementableEvent, Category="Combat")
 	void ReceivedDamage(float Damage, const FVector& ImpactPoint, const FVector& DamageDirection);
@@ -212,6 +246,6 @@ protected:
 	/** Gameplay initialization */
 	virtual void BeginPlay() override;
 
-	/** EndPlay cleanup */
-	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+	/** Gameplay cleanup */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 };
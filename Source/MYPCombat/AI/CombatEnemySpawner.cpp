@@ -0,0 +1,371 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatEnemySpawner.h"
+#include "Components/SceneComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/ArrowComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "MYPTimerSubsystem.h"
+#include "CombatEnemy.h"
+#include "CombatSpawnSchedulerSubsystem.h"
+#include "MYPMessageSubsystem.h"
+#include "CombatMessages.h"
+#include "MYPTickAudit.h"
+
+MYP_AUDIT_TICK(ACombatEnemySpawner);
+
+/** Maximum number of rings of candidate slots searched around the spawn capsule */
+static constexpr int32 MaxSpawnSlotRings = 3;
+
+ACombatEnemySpawner::ACombatEnemySpawner()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// create the root
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	// create the reference spawn capsule
+	SpawnCapsule = CreateDefaultSubobject<UCapsuleComponent>(TEXT("Spawn Capsule"));
+	SpawnCapsule->SetupAttachment(RootComponent);
+
+	SpawnCapsule->SetRelativeLocation(FVector(0.0f, 0.0f, 90.0f));
+	SpawnCapsule->SetCapsuleSize(35.0f, 90.0f);
+	SpawnCapsule->SetCollisionProfileName(FName("NoCollision"));
+
+	SpawnDirection = CreateDefaultSubobject<UArrowComponent>(TEXT("Spawn Direction"));
+	SpawnDirection->SetupAttachment(RootComponent);
+}
+
+void ACombatEnemySpawner::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// find the spawn slots up front, so spawning only needs to check that its slot is still clear
+	BuildSpawnSlots();
+
+	// fall back to a channel only this spawner sends on
+	if (DepletedChannel.IsNone())
+	{
+		DepletedChannel = FName(*GetPathName());
+	}
+
+	// subscribe the activatable actors once, instead of looking them up when we're depleted
+	for (AActor* CurrentActor : ActorsToActivateWhenDepleted)
+	{
+		if (ICombatActivatable* Activatable = Cast<ICombatActivatable>(CurrentActor))
+		{
+			Activatable->ListenForActivation(DepletedChannel);
+		}
+	}
+
+	// listen for enemy deaths
+	if (UMYPMessageSubsystem* Messages = UMYPMessageSubsystem::Get(this))
+	{
+		Messages->Subscribe<FCombatEnemyDiedMessage>(CombatChannels::EnemyDied, this, &ACombatEnemySpawner::HandleEnemyDiedMessage);
+	}
+	
+	// should we spawn enemies right away?
+	if (bShouldSpawnEnemiesImmediately)
+	{
+		// schedule the first wave
+		if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+		{
+			Timers->SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnWave, InitialSpawnDelay);
+		}
+	}
+
+}
+
+void ACombatEnemySpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// drop any spawns still waiting in the queue
+	if (UCombatSpawnSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatSpawnSchedulerSubsystem>())
+	{
+		Scheduler->CancelSpawns(this);
+	}
+
+	// stop listening for enemy deaths
+	if (UMYPMessageSubsystem* Messages = UMYPMessageSubsystem::Get(this))
+	{
+		Messages->UnsubscribeAll(this);
+	}
+
+	SpawnedEnemies.Empty();
+}
+
+void ACombatEnemySpawner::BuildSpawnSlots()
+{
+	SpawnSlots.Reset();
+
+	// the reference capsule is always the first slot
+	const FTransform CapsuleTransform = SpawnCapsule->GetComponentTransform();
+	SpawnSlots.Add(CapsuleTransform);
+
+	const float CapsuleRadius = SpawnCapsule->GetScaledCapsuleRadius();
+	const float CapsuleHalfHeight = SpawnCapsule->GetScaledCapsuleHalfHeight();
+	const FCollisionShape CapsuleShape = FCollisionShape::MakeCapsule(CapsuleRadius, CapsuleHalfHeight);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatSpawnSlots), false, this);
+
+	// look for more slots on rings around the capsule
+	for (int32 Ring = 1; Ring <= MaxSpawnSlotRings && SpawnSlots.Num() < NumSpawnSlots; ++Ring)
+	{
+		const int32 NumCandidates = Ring * 6;
+
+		for (int32 CandidateIndex = 0; CandidateIndex < NumCandidates && SpawnSlots.Num() < NumSpawnSlots; ++CandidateIndex)
+		{
+			const float Angle = UE_TWO_PI * CandidateIndex / NumCandidates;
+			FVector Candidate = CapsuleTransform.GetLocation() + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * (Ring * SpawnSlotSpacing);
+
+			// the slot needs a floor under it
+			FHitResult FloorHit;
+
+			if (!GetWorld()->LineTraceSingleByChannel(FloorHit, Candidate + FVector(0.0f, 0.0f, CapsuleHalfHeight), Candidate - FVector(0.0f, 0.0f, CapsuleHalfHeight * 2.0f), ECC_Visibility, QueryParams))
+			{
+				continue;
+			}
+
+			// rest the capsule just above the floor
+			Candidate.Z = FloorHit.ImpactPoint.Z + CapsuleHalfHeight + 2.0f;
+
+			// and it must fit there
+			if (GetWorld()->OverlapBlockingTestByChannel(Candidate, FQuat::Identity, ECC_Pawn, CapsuleShape, QueryParams))
+			{
+				continue;
+			}
+
+			SpawnSlots.Emplace(CapsuleTransform.GetRotation(), Candidate);
+		}
+	}
+
+	UsedSpawnSlots.Init(false, SpawnSlots.Num());
+}
+
+int32 ACombatEnemySpawner::ChooseSpawnSlot() const
+{
+	// get the player's view cone
+	FVector ViewLocation = FVector::ZeroVector;
+	FRotator ViewRotation = FRotator::ZeroRotator;
+	float CosHalfFOV = -1.0f;
+
+	if (const APlayerController* PlayerController = UGameplayStatics::GetPlayerController(this, 0))
+	{
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+		const float FOV = PlayerController->PlayerCameraManager ? PlayerController->PlayerCameraManager->GetFOVAngle() : 90.0f;
+		CosHalfFOV = FMath::Cos(FMath::DegreesToRadians(FOV * 0.5f));
+	}
+
+	const FVector ViewDirection = ViewRotation.Vector();
+
+	// return the first free slot outside the view cone, or the first free slot if they're all in view
+	int32 FallbackSlot = INDEX_NONE;
+
+	for (int32 SlotIndex = 0; SlotIndex < SpawnSlots.Num(); ++SlotIndex)
+	{
+		if (UsedSpawnSlots[SlotIndex])
+		{
+			continue;
+		}
+
+		const FVector ToSlot = (SpawnSlots[SlotIndex].GetLocation() - ViewLocation).GetSafeNormal();
+
+		if (FVector::DotProduct(ToSlot, ViewDirection) < CosHalfFOV)
+		{
+			return SlotIndex;
+		}
+
+		if (FallbackSlot == INDEX_NONE)
+		{
+			FallbackSlot = SlotIndex;
+		}
+	}
+
+	return FallbackSlot;
+}
+
+bool ACombatEnemySpawner::IsSpawnSlotClear(int32 SlotIndex) const
+{
+	const FCollisionShape CapsuleShape = FCollisionShape::MakeCapsule(SpawnCapsule->GetScaledCapsuleRadius(), SpawnCapsule->GetScaledCapsuleHalfHeight());
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatSpawnSlotClear), false, this);
+
+	return !GetWorld()->OverlapBlockingTestByChannel(SpawnSlots[SlotIndex].GetLocation(), FQuat::Identity, ECC_Pawn, CapsuleShape, QueryParams);
+}
+
+void ACombatEnemySpawner::SpawnWave()
+{
+	// never spawn more enemies than we have slots for
+	const int32 NumToSpawn = FMath::Min3(WaveSize, SpawnCount, SpawnSlots.Num());
+
+	if (NumToSpawn <= 0)
+	{
+		return;
+	}
+
+	UsedSpawnSlots.Init(false, SpawnSlots.Num());
+	WaveEnemiesRemaining = NumToSpawn;
+
+	// queue the spawns so they're spread over several frames
+	UCombatSpawnSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatSpawnSchedulerSubsystem>();
+
+	for (int32 i = 0; i < NumToSpawn; ++i)
+	{
+		if (Scheduler)
+		{
+			Scheduler->QueueSpawn(this);
+		}
+		else
+		{
+			SpawnEnemy();
+		}
+	}
+}
+
+void ACombatEnemySpawner::SpawnEnemy()
+{
+	ACombatEnemy* SpawnedEnemy = nullptr;
+
+	// ensure the enemy class is valid
+	if (IsValid(EnemyClass))
+	{
+		// corpses, props or the player may have moved onto a slot since it was built, so skip any that are blocked now
+		int32 SlotIndex = ChooseSpawnSlot();
+
+		while (SlotIndex != INDEX_NONE && !IsSpawnSlotClear(SlotIndex))
+		{
+			UsedSpawnSlots[SlotIndex] = true;
+			SlotIndex = ChooseSpawnSlot();
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Owner = this;
+
+		if (SlotIndex != INDEX_NONE)
+		{
+			// the slot was just checked, so skip the encroachment checks
+			UsedSpawnSlots[SlotIndex] = true;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		}
+		else
+		{
+			// every slot is blocked, so let the engine nudge the enemy out of the way on the reference capsule
+			SlotIndex = 0;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		}
+
+		SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(EnemyClass, SpawnSlots[SlotIndex], SpawnParams);
+	}
+
+	// remember the enemy, so we can recognize its death message
+	if (SpawnedEnemy)
+	{
+		SpawnedEnemies.Add(SpawnedEnemy);
+		SpawnedEnemy->OnDestroyed.AddDynamic(this, &ACombatEnemySpawner::HandleEnemyDestroyed);
+	}
+
+	// count failed spawns as dead so the wave can still end
+	if (!SpawnedEnemy)
+	{
+		OnEnemyDied();
+	}
+}
+
+void ACombatEnemySpawner::HandleEnemyDiedMessage(FName Channel, const FCombatEnemyDiedMessage& Message)
+{
+	// ignore enemies spawned by someone else
+	const ACombatEnemy* DeadEnemy = Cast<ACombatEnemy>(Message.Instigator.Get());
+
+	if (DeadEnemy && SpawnedEnemies.Remove(DeadEnemy) > 0)
+	{
+		OnEnemyDied();
+	}
+}
+
+void ACombatEnemySpawner::HandleEnemyDestroyed(AActor* DestroyedActor)
+{
+	const ACombatEnemy* DestroyedEnemy = Cast<ACombatEnemy>(DestroyedActor);
+
+	// nothing to do if the death was already counted
+	if (!DestroyedEnemy || SpawnedEnemies.Remove(DestroyedEnemy) == 0)
+	{
+		return;
+	}
+
+	// enemies stay around for a while after dying, so the death message should have been counted by now.
+	// If it wasn't, kills aren't reaching us and the spawner would never be depleted
+	ensureMsgf(DestroyedEnemy->CurrentHP > 0.0f, TEXT("%s died without %s counting its death"), *DestroyedEnemy->GetName(), *GetName());
+
+	// count enemies removed before dying, like ones that fell out of the world, so the wave still ends
+	OnEnemyDied();
+}
+
+void ACombatEnemySpawner::OnEnemyDied()
+{
+	// decrease the spawn counters
+	--SpawnCount;
+	--WaveEnemiesRemaining;
+
+	// is this the last enemy we should spawn?
+	if (SpawnCount <= 0)
+	{
+		// schedule the activation on depleted message
+		if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+		{
+			Timers->SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnerDepleted, ActivationDelay);
+		}
+		return;
+	}
+
+	// wait for the rest of the wave to die
+	if (WaveEnemiesRemaining > 0)
+	{
+		return;
+	}
+
+	// schedule the next wave
+	if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+	{
+		Timers->SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnWave, RespawnDelay);
+	}
+}
+
+void ACombatEnemySpawner::SpawnerDepleted()
+{
+	// activate everything listening on our depleted channel
+	if (UMYPMessageSubsystem* Messages = UMYPMessageSubsystem::Get(this))
+	{
+		FCombatActivationMessage Message;
+		Message.Instigator = this;
+
+		Messages->Broadcast(DepletedChannel, Message);
+	}
+}
+
+void ACombatEnemySpawner::ToggleInteraction(AActor* ActivationInstigator)
+{
+	// stub
+}
+
+void ACombatEnemySpawner::ActivateInteraction(AActor* ActivationInstigator)
+{
+	// ensure we're only activated once, and only if we've deferred enemy spawning
+	if (bHasBeenActivated || bShouldSpawnEnemiesImmediately)
+	{
+		return;
+	}
+
+	// raise the activation flag
+	bHasBeenActivated = true;
+
+	// spawn the first wave
+	SpawnWave();
+}
+
+void ACombatEnemySpawner::DeactivateInteraction(AActor* ActivationInstigator)
+{
+	// stub
+}
@@ -5,17 +5,22 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "CombatActivatable.h"
+#include "UObject/ObjectKey.h"
 #include "CombatEnemySpawner.generated.h"
 
 class UCapsuleComponent;
 class UArrowComponent;
 class ACombatEnemy;
+struct FCombatEnemyDiedMessage;
 
 /**
  *  A basic Actor in charge of spawning Enemy Characters and monitoring their deaths.
- *  Enemies will be spawned one by one, and the spawner will wait until the enemy dies before spawning a new one.
+ *  Enemies are spawned in waves over a set of collision-free slots found on BeginPlay, preferring slots the player can't see.
+ *  The spawner waits until the whole wave dies before spawning the next one.
+ *  Spawns go through the spawn scheduler, which spreads them over several frames.
  *  The spawner can be remotely activated through the ICombatActivatable interface
  *  When the last spawned enemy dies, the spawner can also activate other ICombatActivatables
+ *  Enemy deaths and the depleted activation both go through the gameplay message bus
  */
 UCLASS(abstract)
 class ACombatEnemySpawner : public AActor, public ICombatActivatable
@@ -46,6 +51,18 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner", meta = (ClampMin = 0, ClampMax = 100))
 	int32 SpawnCount = 1;
 
+	/** Number of enemies spawned together in each wave */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner", meta = (ClampMin = 1, ClampMax = 16))
+	int32 WaveSize = 1;
+
+	/** Number of spawn slots to look for around the spawn capsule. The capsule itself is always the first slot */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner|Slots", meta = (ClampMin = 1, ClampMax = 32))
+	int32 NumSpawnSlots = 6;
+
+	/** Distance between the rings of spawn slots around the spawn capsule */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner|Slots", meta = (ClampMin = 50, ClampMax = 1000, Units = "cm"))
+	float SpawnSlotSpacing = 150.0f;
+
 	/** Time to wait before spawning the next enemy after the current one dies */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner", meta = (ClampMin = 0, ClampMax = 10))
 	float RespawnDelay = 5.0f;
@@ -54,15 +71,31 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Activation", meta = (ClampMin = 0, ClampMax = 10))
 	float ActivationDelay = 1.0f;
 
-	/** List of actors to activate after the last enemy dies */
+	/** List of actors to activate after the last enemy dies. They're subscribed to the depleted channel on BeginPlay */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Activation")
 	TArray<AActor*> ActorsToActivateWhenDepleted;
 
+	/** Channel the activation message is sent on when depleted. If not set, a channel unique to this spawner is used */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Activation")
+	FName DepletedChannel;
+
 	/** Flag to ensure this is only activated once */
 	bool bHasBeenActivated = false;
 
 	/** Timer to spawn enemies after a delay */
-	FTimerHandle SpawnTimer;
+	FMYPTimerHandle SpawnTimer;
+
+	/** Spawn transforms that were collision-free on BeginPlay. The reference capsule is always the first one */
+	TArray<FTransform> SpawnSlots;
+
+	/** Slots already used by the current wave */
+	TBitArray<> UsedSpawnSlots;
+
+	/** Number of enemies in the current wave that are queued or alive */
+	int32 WaveEnemiesRemaining = 0;
+
+	/** Enemies spawned by us whose death hasn't been counted yet. Their owner can't be used for this, possession hands it to the AI controller */
+	TSet<TObjectKey<ACombatEnemy>> SpawnedEnemies;
 
 public:	
 	
@@ -75,15 +108,39 @@ public:
 	virtual void BeginPlay() override;
 
 	/** Cleanup */
-	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Spawn an enemy on a free slot. Called by the spawn scheduler */
+	void SpawnEnemy();
+
+	/** Returns true once every enemy this spawner was going to spawn has died */
+	bool IsDepleted() const { return SpawnCount <= 0; }
+
+	/** Returns the number of enemy deaths still needed to deplete this spawner */
+	int32 GetEnemiesLeft() const { return FMath::Max(SpawnCount, 0); }
 
 protected:
 
-	/** Spawn an enemy and subscribe to its death event */
-	void SpawnEnemy();
+	/** Finds the collision-free spawn slots around the spawn capsule */
+	void BuildSpawnSlots();
 
-	/** Called when the spawned enemy has died */
+	/** Returns a free slot for the current wave, preferring slots outside the player's view, or INDEX_NONE if all are used */
+	int32 ChooseSpawnSlot() const;
+
+	/** Returns true if nothing currently blocks an enemy capsule on the given slot */
+	bool IsSpawnSlotClear(int32 SlotIndex) const;
+
+	/** Queues the next wave of enemies with the spawn scheduler */
+	void SpawnWave();
+
+	/** Handles enemy death messages, and counts the deaths of enemies we spawned */
+	void HandleEnemyDiedMessage(FName Channel, const FCombatEnemyDiedMessage& Message);
+
+	/** Counts enemies of ours removed from the level without their death being counted */
 	UFUNCTION()
+	void HandleEnemyDestroyed(AActor* DestroyedActor);
+
+	/** Called when the spawned enemy has died */
 	void OnEnemyDied();
 
 	/** Called after the last spawned enemy has died */
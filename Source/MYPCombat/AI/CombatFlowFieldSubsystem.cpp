@@ -0,0 +1,495 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatFlowFieldSubsystem.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavMesh/NavMeshBoundsVolume.h"
+#include "HAL/IConsoleManager.h"
+#include "MYP.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Flow Field Update"), STAT_CombatFlowFieldUpdate, STATGROUP_MYP);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat Flow Field Cells"), STAT_CombatFlowFieldCells, STATGROUP_MYP);
+
+static TAutoConsoleVariable<float> CVarCombatFlowFieldCellSize(
+	TEXT("Combat.FlowField.CellSize"),
+	100.0f,
+	TEXT("Size in cm of a flow field cell. Takes effect the next time the grid is built."),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<int32> CVarCombatFlowFieldMaxCells(
+	TEXT("Combat.FlowField.MaxCells"),
+	65536,
+	TEXT("Maximum number of flow field cells. The cell size grows to fit large arenas under this cap."),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<int32> CVarCombatFlowFieldCellsPerFrame(
+	TEXT("Combat.FlowField.CellsPerFrame"),
+	4096,
+	TEXT("Number of cells the flow field grid and integration updates may process each frame."),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarCombatFlowFieldMaxStepHeight(
+	TEXT("Combat.FlowField.MaxStepHeight"),
+	60.0f,
+	TEXT("Maximum height difference in cm between neighboring cells for enemies to step between them."),
+	ECVF_Default);
+
+static FAutoConsoleCommandWithWorldAndArgs CombatFlowFieldBenchmarkCommand(
+	TEXT("Combat.FlowField.Benchmark"),
+	TEXT("Compares the cost of sampling the flow field against synchronous navmesh path queries. Optional argument: number of samples (default 500)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UCombatFlowFieldSubsystem* FlowField = World ? World->GetSubsystem<UCombatFlowFieldSubsystem>() : nullptr)
+		{
+			FlowField->RunBenchmark(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 500);
+		}
+	}));
+
+/** Neighbor offsets, orthogonal first */
+static const int32 NeighborOffsetsX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int32 NeighborOffsetsY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+bool UCombatFlowFieldSubsystem::SampleDirection(const FVector& Location, FVector& OutDirection) const
+{
+	OutDirection = FVector::ZeroVector;
+
+	const int32 CellIndex = GetCellIndex(Location);
+
+	if (CellIndex == INDEX_NONE || !HasField() || ActiveField[CellIndex] == UnreachableCost)
+	{
+		return false;
+	}
+
+	// at the goal, head straight for the goal cell's center
+	if (CellIndex == ActiveGoalCell)
+	{
+		OutDirection = (GetCellLocation(ActiveGoalCell) - Location).GetSafeNormal2D();
+		return true;
+	}
+
+	// step towards the cheapest reachable neighbor
+	const int32 X = CellIndex % SizeX;
+	const int32 Y = CellIndex / SizeX;
+
+	int32 BestCell = INDEX_NONE;
+	uint32 BestCost = ActiveField[CellIndex];
+
+	for (int32 Neighbor = 0; Neighbor < 8; ++Neighbor)
+	{
+		const int32 NX = X + NeighborOffsetsX[Neighbor];
+		const int32 NY = Y + NeighborOffsetsY[Neighbor];
+
+		if (NX < 0 || NY < 0 || NX >= SizeX || NY >= SizeY)
+		{
+			continue;
+		}
+
+		const int32 NeighborCell = NY * SizeX + NX;
+
+		if (ActiveField[NeighborCell] < BestCost && CanStep(CellIndex, NeighborCell))
+		{
+			BestCost = ActiveField[NeighborCell];
+			BestCell = NeighborCell;
+		}
+	}
+
+	if (BestCell == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutDirection = (GetCellLocation(BestCell) - Location).GetSafeNormal2D();
+	return true;
+}
+
+float UCombatFlowFieldSubsystem::GetPathDistance(const FVector& Location) const
+{
+	const int32 CellIndex = GetCellIndex(Location);
+
+	if (CellIndex == INDEX_NONE || !HasField() || ActiveField[CellIndex] == UnreachableCost)
+	{
+		return -1.0f;
+	}
+
+	// integration costs are in tenths of a cell
+	return ActiveField[CellIndex] * CellSize / StraightCost;
+}
+
+void UCombatFlowFieldSubsystem::RunBenchmark(int32 NumSamples)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+
+	if (!NavSys || !PlayerPawn || !HasField() || NumSamples <= 0)
+	{
+		UE_LOG(MYPLog, Warning, TEXT("Flow field benchmark needs a navmesh, a player pawn and a complete field"));
+		return;
+	}
+
+	// pick random walkable cells with a fixed seed so runs are comparable
+	FRandomStream Random(1234);
+	TArray<FVector> Locations;
+	Locations.Reserve(NumSamples);
+
+	for (int32 Attempt = 0; Attempt < NumSamples * 8 && Locations.Num() < NumSamples; ++Attempt)
+	{
+		const int32 CellIndex = Random.RandHelper(SizeX * SizeY);
+
+		if (WalkableCells[CellIndex])
+		{
+			Locations.Add(GetCellLocation(CellIndex));
+		}
+	}
+
+	// time the flow field samples
+	int32 NumFieldHits = 0;
+	const double FieldStart = FPlatformTime::Seconds();
+
+	for (const FVector& Location : Locations)
+	{
+		FVector Direction;
+		NumFieldHits += SampleDirection(Location, Direction) ? 1 : 0;
+	}
+
+	const double FieldTime = FPlatformTime::Seconds() - FieldStart;
+
+	// time a navmesh path query from each location to the player
+	int32 NumPathHits = 0;
+	const FVector Goal = PlayerPawn->GetActorLocation();
+	const double PathStart = FPlatformTime::Seconds();
+
+	for (const FVector& Location : Locations)
+	{
+		const FPathFindingResult Result = NavSys->FindPathSync(FPathFindingQuery(nullptr, *NavSys->GetDefaultNavDataInstance(), Location, Goal));
+		NumPathHits += Result.IsSuccessful() ? 1 : 0;
+	}
+
+	const double PathTime = FPlatformTime::Seconds() - PathStart;
+
+	UE_LOG(MYPLog, Log, TEXT("Flow field benchmark, %d agents on a %dx%d grid: field %.3f ms total (%.3f us each, %d reach), navmesh paths %.3f ms total (%.3f us each, %d reach)"),
+		Locations.Num(), SizeX, SizeY,
+		FieldTime * 1000.0, FieldTime * 1000000.0 / FMath::Max(1, Locations.Num()), NumFieldHits,
+		PathTime * 1000.0, PathTime * 1000000.0 / FMath::Max(1, Locations.Num()), NumPathHits);
+}
+
+int32 UCombatFlowFieldSubsystem::GetCellIndex(const FVector& Location) const
+{
+	if (SizeX == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 X = FMath::FloorToInt32((Location.X - GridOrigin.X) / CellSize);
+	const int32 Y = FMath::FloorToInt32((Location.Y - GridOrigin.Y) / CellSize);
+
+	if (X < 0 || Y < 0 || X >= SizeX || Y >= SizeY)
+	{
+		return INDEX_NONE;
+	}
+
+	return Y * SizeX + X;
+}
+
+FVector UCombatFlowFieldSubsystem::GetCellLocation(int32 CellIndex) const
+{
+	const int32 X = CellIndex % SizeX;
+	const int32 Y = CellIndex / SizeX;
+
+	return FVector(GridOrigin.X + (X + 0.5f) * CellSize, GridOrigin.Y + (Y + 0.5f) * CellSize, CellHeights[CellIndex]);
+}
+
+bool UCombatFlowFieldSubsystem::CanStep(int32 FromCell, int32 ToCell) const
+{
+	if (!WalkableCells[ToCell] || FMath::Abs(CellHeights[ToCell] - CellHeights[FromCell]) > CVarCombatFlowFieldMaxStepHeight.GetValueOnGameThread())
+	{
+		return false;
+	}
+
+	// diagonal steps can't cut corners around unwalkable cells
+	const int32 FromX = FromCell % SizeX;
+	const int32 FromY = FromCell / SizeX;
+	const int32 ToX = ToCell % SizeX;
+	const int32 ToY = ToCell / SizeX;
+
+	if (FromX != ToX && FromY != ToY)
+	{
+		return WalkableCells[FromY * SizeX + ToX] && WalkableCells[ToY * SizeX + FromX];
+	}
+
+	return true;
+}
+
+void UCombatFlowFieldSubsystem::StartGridBuild()
+{
+	bGridDirty = false;
+
+	// the arena is the area covered by the nav mesh bounds volumes
+	FBox ArenaBounds(ForceInit);
+
+	for (TActorIterator<ANavMeshBoundsVolume> It(GetWorld()); It; ++It)
+	{
+		ArenaBounds += It->GetComponentsBoundingBox(true);
+	}
+
+	// drop the current field, since the cells are about to change
+	ActiveField.Reset();
+	ActiveGoalCell = INDEX_NONE;
+	PendingGoalCell = INDEX_NONE;
+	DEC_DWORD_STAT_BY(STAT_CombatFlowFieldCells, SizeX * SizeY);
+
+	if (!ArenaBounds.IsValid)
+	{
+		SizeX = SizeY = 0;
+		GridBuildCursor = INDEX_NONE;
+		return;
+	}
+
+	// grow the cells if needed to stay under the cell cap
+	const FVector ArenaSize = ArenaBounds.GetSize();
+	const int32 MaxCells = FMath::Max(1, CVarCombatFlowFieldMaxCells.GetValueOnGameThread());
+
+	CellSize = FMath::Max(10.0f, CVarCombatFlowFieldCellSize.GetValueOnGameThread());
+	CellSize = FMath::Max(CellSize, float(FMath::Sqrt(ArenaSize.X * ArenaSize.Y / MaxCells)));
+
+	GridOrigin = ArenaBounds.Min;
+	SizeX = FMath::Max(1, FMath::CeilToInt32(ArenaSize.X / CellSize));
+	SizeY = FMath::Max(1, FMath::CeilToInt32(ArenaSize.Y / CellSize));
+
+	const int32 NumCells = SizeX * SizeY;
+	CellHeights.SetNumZeroed(NumCells);
+	WalkableCells.Init(false, NumCells);
+	ActiveField.Init(UnreachableCost, NumCells);
+	PendingField.Init(UnreachableCost, NumCells);
+	INC_DWORD_STAT_BY(STAT_CombatFlowFieldCells, NumCells);
+
+	// project from the middle of the arena's vertical extent
+	GridOrigin.Z = ArenaBounds.GetCenter().Z;
+	ArenaHeight = ArenaSize.Z;
+	GridBuildCursor = 0;
+}
+
+int32 UCombatFlowFieldSubsystem::ContinueGridBuild(int32 Budget)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	if (!NavSys || GridBuildCursor == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	const FVector QueryExtent(CellSize * 0.5f, CellSize * 0.5f, ArenaHeight * 0.5f);
+	const int32 NumCells = SizeX * SizeY;
+	const int32 EndCell = FMath::Min(NumCells, GridBuildCursor + Budget);
+	const int32 NumProcessed = EndCell - GridBuildCursor;
+
+	for (; GridBuildCursor < EndCell; ++GridBuildCursor)
+	{
+		const int32 X = GridBuildCursor % SizeX;
+		const int32 Y = GridBuildCursor / SizeX;
+		const FVector CellCenter(GridOrigin.X + (X + 0.5f) * CellSize, GridOrigin.Y + (Y + 0.5f) * CellSize, GridOrigin.Z);
+
+		// a cell is walkable if it overlaps the navmesh
+		FNavLocation NavLocation;
+		const bool bWalkable = NavSys->ProjectPointToNavigation(CellCenter, NavLocation, QueryExtent);
+
+		WalkableCells[GridBuildCursor] = bWalkable;
+		CellHeights[GridBuildCursor] = bWalkable ? float(NavLocation.Location.Z) : GridOrigin.Z;
+	}
+
+	// is the grid complete?
+	if (GridBuildCursor >= NumCells)
+	{
+		GridBuildCursor = INDEX_NONE;
+	}
+
+	return NumProcessed;
+}
+
+void UCombatFlowFieldSubsystem::StartIntegration(int32 GoalCell)
+{
+	const int32 NumCells = SizeX * SizeY;
+
+	// every cell can still reach the new goal through the old one, so the old costs plus the cost between the two goals
+	// are valid upper bounds for the new field. Seeding with them repairs the old field: only the cells that have a shorter
+	// way to the new goal get improved and expanded again, and the rest keep their seeded cost
+	if (HasField() && ActiveField.Num() == NumCells && ActiveField[GoalCell] != UnreachableCost)
+	{
+		const uint32 GoalOffset = ActiveField[GoalCell];
+
+		PendingField.SetNumUninitialized(NumCells);
+
+		for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex)
+		{
+			PendingField[CellIndex] = ActiveField[CellIndex] == UnreachableCost ? UnreachableCost : ActiveField[CellIndex] + GoalOffset;
+		}
+	}
+	else
+	{
+		// nothing to repair, so integrate from scratch
+		PendingField.Init(UnreachableCost, NumCells);
+	}
+
+	// reset the queue
+	for (TArray<int32>& Bucket : QueueBuckets)
+	{
+		Bucket.Reset();
+	}
+
+	QueueCost = 0;
+	QueueNum = 0;
+	PendingGoalCell = GoalCell;
+
+	// start the integration from the goal
+	PendingField[GoalCell] = 0;
+	PushCell(GoalCell, 0);
+}
+
+int32 UCombatFlowFieldSubsystem::ContinueIntegration(int32 Budget)
+{
+	int32 NumProcessed = 0;
+
+	while (QueueNum > 0 && NumProcessed < Budget)
+	{
+		// find the next bucket with cells in it
+		TArray<int32>& Bucket = QueueBuckets[QueueCost % NumQueueBuckets];
+
+		if (Bucket.IsEmpty())
+		{
+			++QueueCost;
+			continue;
+		}
+
+		const int32 CellIndex = Bucket.Pop(EAllowShrinking::No);
+		--QueueNum;
+
+		// skip cells that were reached more cheaply after they were queued
+		if (PendingField[CellIndex] != QueueCost)
+		{
+			continue;
+		}
+
+		++NumProcessed;
+
+		// relax the neighbors
+		const int32 X = CellIndex % SizeX;
+		const int32 Y = CellIndex / SizeX;
+
+		for (int32 Neighbor = 0; Neighbor < 8; ++Neighbor)
+		{
+			const int32 NX = X + NeighborOffsetsX[Neighbor];
+			const int32 NY = Y + NeighborOffsetsY[Neighbor];
+
+			if (NX < 0 || NY < 0 || NX >= SizeX || NY >= SizeY)
+			{
+				continue;
+			}
+
+			const int32 NeighborCell = NY * SizeX + NX;
+			const uint32 NewCost = QueueCost + (Neighbor < 4 ? StraightCost : DiagonalCost);
+
+			if (NewCost < PendingField[NeighborCell] && CanStep(CellIndex, NeighborCell))
+			{
+				PendingField[NeighborCell] = NewCost;
+				PushCell(NeighborCell, NewCost);
+			}
+		}
+	}
+
+	// is the field complete? Swap it in for steering
+	if (QueueNum == 0 && PendingGoalCell != INDEX_NONE)
+	{
+		Swap(ActiveField, PendingField);
+		ActiveGoalCell = PendingGoalCell;
+		PendingGoalCell = INDEX_NONE;
+	}
+
+	return NumProcessed;
+}
+
+void UCombatFlowFieldSubsystem::PushCell(int32 CellIndex, uint32 Cost)
+{
+	QueueBuckets[Cost % NumQueueBuckets].Add(CellIndex);
+	++QueueNum;
+}
+
+void UCombatFlowFieldSubsystem::TickUpdate(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatFlowFieldUpdate);
+
+	int32 Budget = FMath::Max(1, CVarCombatFlowFieldCellsPerFrame.GetValueOnGameThread());
+
+	// rebuild the grid if the navmesh changed
+	if (bGridDirty)
+	{
+		StartGridBuild();
+	}
+
+	// finish building the grid before integrating over it
+	if (GridBuildCursor != INDEX_NONE)
+	{
+		Budget -= ContinueGridBuild(Budget);
+
+		if (GridBuildCursor != INDEX_NONE)
+		{
+			return;
+		}
+	}
+
+	// follow the player
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	const int32 PlayerCell = PlayerPawn ? GetCellIndex(PlayerPawn->GetActorLocation()) : INDEX_NONE;
+
+	// start a new field when the player reaches a new walkable cell. While a field is being built, let it finish
+	// so a moving player doesn't keep restarting it
+	if (PendingGoalCell == INDEX_NONE && PlayerCell != INDEX_NONE && WalkableCells[PlayerCell] && PlayerCell != ActiveGoalCell)
+	{
+		StartIntegration(PlayerCell);
+	}
+
+	if (PendingGoalCell != INDEX_NONE && Budget > 0)
+	{
+		ContinueIntegration(Budget);
+	}
+}
+
+void UCombatFlowFieldSubsystem::HandleNavigationGenerationFinished(ANavigationData* NavData)
+{
+	// rebuild the grid from the new navmesh
+	bGridDirty = true;
+}
+
+void UCombatFlowFieldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// update before the AI and movement ticks, so enemies steer with a fresh field
+	SetupTick(&UCombatFlowFieldSubsystem::TickUpdate, TG_PrePhysics, TEXT("CombatFlowFieldSubsystem::TickUpdate"));
+}
+
+void UCombatFlowFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// rebuild the grid whenever the navmesh is regenerated
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &UCombatFlowFieldSubsystem::HandleNavigationGenerationFinished);
+	}
+}
+
+void UCombatFlowFieldSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &UCombatFlowFieldSubsystem::HandleNavigationGenerationFinished);
+	}
+
+	DEC_DWORD_STAT_BY(STAT_CombatFlowFieldCells, SizeX * SizeY);
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,150 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "CombatFlowFieldSubsystem.generated.h"
+
+class ANavigationData;
+
+/**
+ *  Builds a single flow field towards the player over the arena's navmesh, so any number of enemies can pursue
+ *  the player by sampling it instead of requesting their own paths.
+ *  - The arena is the area covered by the level's Nav Mesh Bounds Volumes, split into a grid of navmesh-projected cells
+ *  - The integration field is repaired whenever the player enters a new cell. The previous costs, offset by the cost
+ *    between the old and new goal, seed the new field, so only cells with a shorter way to the new goal are expanded again.
+ *    The previous field keeps steering enemies until the new one is complete
+ *  - Grid and field updates are time sliced to a fixed number of cells per frame
+ *  - Sampling the field is O(1)
+ */
+UCLASS()
+class UCombatFlowFieldSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Integration cost of an orthogonal step */
+	static constexpr uint32 StraightCost = 10;
+
+	/** Integration cost of a diagonal step */
+	static constexpr uint32 DiagonalCost = 14;
+
+	/** Number of buckets in the integration queue. Must be larger than the highest step cost */
+	static constexpr int32 NumQueueBuckets = DiagonalCost + 1;
+
+	/** Integration cost of unreachable cells */
+	static constexpr uint32 UnreachableCost = MAX_uint32;
+
+	/** World position of the corner of the first cell */
+	FVector GridOrigin = FVector::ZeroVector;
+
+	/** Size of a grid cell */
+	float CellSize = 100.0f;
+
+	/** Height of the arena, used as the vertical extent of the navmesh projections */
+	float ArenaHeight = 0.0f;
+
+	/** Number of cells along X and Y */
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+
+	/** Navmesh height of each cell */
+	TArray<float> CellHeights;
+
+	/** Walkable flag for each cell */
+	TBitArray<> WalkableCells;
+
+	/** Next cell to project while building the grid, or INDEX_NONE if the grid is complete */
+	int32 GridBuildCursor = INDEX_NONE;
+
+	/** Integration field enemies are currently steering with */
+	TArray<uint32> ActiveField;
+
+	/** Goal cell of the active field */
+	int32 ActiveGoalCell = INDEX_NONE;
+
+	/** Integration field being built */
+	TArray<uint32> PendingField;
+
+	/** Goal cell of the field being built, or INDEX_NONE if no field is being built */
+	int32 PendingGoalCell = INDEX_NONE;
+
+	/** Bucketed priority queue for the integration, indexed by cost modulo the number of buckets */
+	TArray<int32> QueueBuckets[NumQueueBuckets];
+
+	/** Cost currently being expanded by the integration */
+	uint32 QueueCost = 0;
+
+	/** Number of cells left in the integration queue */
+	int32 QueueNum = 0;
+
+	/** If true, the grid must be rebuilt from the navmesh */
+	bool bGridDirty = true;
+
+public:
+
+	/**
+	 *  Samples the flow field at a location.
+	 *  @param Location			World location to sample
+	 *  @param OutDirection		Normalized horizontal direction towards the player
+	 *  @return true if the location is on the field and can reach the player
+	 */
+	bool SampleDirection(const FVector& Location, FVector& OutDirection) const;
+
+	/** Returns the approximate path distance from a location to the player, or -1 if it can't reach the player through the field */
+	float GetPathDistance(const FVector& Location) const;
+
+	/** Returns true if there's a complete field to sample */
+	bool HasField() const { return ActiveGoalCell != INDEX_NONE; }
+
+	/** Times sampling the field against synchronous navmesh path queries from the same random locations, and logs the results */
+	void RunBenchmark(int32 NumSamples);
+
+protected:
+
+	/** Returns the cell containing a world location, or INDEX_NONE if it's off the grid */
+	int32 GetCellIndex(const FVector& Location) const;
+
+	/** Returns the world location of a cell's center */
+	FVector GetCellLocation(int32 CellIndex) const;
+
+	/** Returns true if a step between two neighboring walkable cells is allowed */
+	bool CanStep(int32 FromCell, int32 ToCell) const;
+
+	/** Sizes the grid to the nav mesh bounds and starts projecting its cells */
+	void StartGridBuild();
+
+	/** Projects grid cells onto the navmesh. Returns the number of cells processed */
+	int32 ContinueGridBuild(int32 Budget);
+
+	/** Starts building a new integration field towards the given cell, seeded from the active field when there is one */
+	void StartIntegration(int32 GoalCell);
+
+	/** Expands the integration field. Returns the number of cells processed */
+	int32 ContinueIntegration(int32 Budget);
+
+	/** Adds a cell to the integration queue */
+	void PushCell(int32 CellIndex, uint32 Cost);
+
+	/** Time slices the grid and field updates */
+	void TickUpdate(float DeltaTime);
+
+	/** Marks the grid dirty when the navmesh is rebuilt */
+	UFUNCTION()
+	void HandleNavigationGenerationFinished(ANavigationData* NavData);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Sets up the update tick */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Starts listening for navmesh rebuilds */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Stops listening for navmesh rebuilds */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
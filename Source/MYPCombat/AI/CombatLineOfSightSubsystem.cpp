@@ -0,0 +1,253 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatLineOfSightSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+#include "CollisionQueryParams.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "MYP.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Line of Sight Traces"), STAT_CombatSightTraces, STATGROUP_MYP);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Line of Sight Traces Per Frame"), STAT_CombatSightTracesPerFrame, STATGROUP_MYP);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Line of Sight Queue Depth"), STAT_CombatSightQueueDepth, STATGROUP_MYP);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Combat Line of Sight Average Result Age (ms)"), STAT_CombatSightAverageResultAge, STATGROUP_MYP);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Combat Line of Sight Max Result Age (ms)"), STAT_CombatSightMaxResultAge, STATGROUP_MYP);
+
+static TAutoConsoleVariable<float> CVarCombatSightBudgetMs(
+	TEXT("Combat.Sight.BudgetMs"),
+	0.25f,
+	TEXT("Time in milliseconds the line of sight service may spend tracing each frame. At least one observer is traced every frame."),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarCombatSightMaxResultAge(
+	TEXT("Combat.Sight.MaxResultAge"),
+	0.5f,
+	TEXT("Results older than this many seconds are refreshed ahead of any fresher result, regardless of distance."),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarCombatSightNearDistance(
+	TEXT("Combat.Sight.NearDistance"),
+	500.0f,
+	TEXT("Observers closer than this distance in cm to the player share the highest refresh priority."),
+	ECVF_Default);
+
+void UCombatLineOfSightSubsystem::RegisterObserver(AActor* Observer)
+{
+	if (!Observer || EntryIndices.Contains(Observer))
+	{
+		return;
+	}
+
+	EntryIndices.Add(Observer, Entries.Num());
+
+	FCombatSightEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Observer = Observer;
+	Entry.ObserverKey = Observer;
+}
+
+void UCombatLineOfSightSubsystem::UnregisterObserver(AActor* Observer)
+{
+	if (const int32* Index = EntryIndices.Find(Observer))
+	{
+		RemoveEntryAt(*Index);
+	}
+}
+
+bool UCombatLineOfSightSubsystem::HasLineOfSight(const AActor* Observer, float MaxResultAge /*= 0.0f*/) const
+{
+	const FCombatSightEntry* Entry = FindEntry(Observer);
+
+	if (!Entry || Entry->LastCheckTime < 0.0)
+	{
+		return false;
+	}
+
+	// optionally reject results that are too old to act on
+	if (MaxResultAge > 0.0f && GetWorld()->GetTimeSeconds() - Entry->LastCheckTime > MaxResultAge)
+	{
+		return false;
+	}
+
+	return Entry->bHasLineOfSight;
+}
+
+float UCombatLineOfSightSubsystem::GetResultAge(const AActor* Observer) const
+{
+	const FCombatSightEntry* Entry = FindEntry(Observer);
+
+	if (!Entry || Entry->LastCheckTime < 0.0)
+	{
+		return -1.0f;
+	}
+
+	return float(GetWorld()->GetTimeSeconds() - Entry->LastCheckTime);
+}
+
+float UCombatLineOfSightSubsystem::GetTimeSinceSeen(const AActor* Observer) const
+{
+	const FCombatSightEntry* Entry = FindEntry(Observer);
+
+	if (!Entry || Entry->LastSeenTime < 0.0)
+	{
+		return -1.0f;
+	}
+
+	return float(GetWorld()->GetTimeSeconds() - Entry->LastSeenTime);
+}
+
+const FCombatSightEntry* UCombatLineOfSightSubsystem::FindEntry(const AActor* Observer) const
+{
+	const int32* Index = EntryIndices.Find(Observer);
+
+	return Index ? &Entries[*Index] : nullptr;
+}
+
+void UCombatLineOfSightSubsystem::RemoveEntryAt(int32 Index)
+{
+	EntryIndices.Remove(Entries[Index].ObserverKey);
+
+	Entries.RemoveAtSwap(Index, EAllowShrinking::No);
+
+	// the last entry moved into the removed slot
+	if (Entries.IsValidIndex(Index))
+	{
+		EntryIndices.Add(Entries[Index].ObserverKey, Index);
+	}
+}
+
+bool UCombatLineOfSightSubsystem::TraceLineOfSight(const AActor* Observer, const APawn* Target) const
+{
+	FVector EyeLocation;
+	FRotator EyeRotation;
+	Observer->GetActorEyesViewPoint(EyeLocation, EyeRotation);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatLineOfSight), false, Observer);
+	QueryParams.AddIgnoredActor(Target);
+
+	FHitResult Hit;
+	return !GetWorld()->LineTraceSingleByChannel(Hit, EyeLocation, Target->GetPawnViewLocation(), ECC_Visibility, QueryParams);
+}
+
+void UCombatLineOfSightSubsystem::TickTraces(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatSightTraces);
+
+	// drop observers that were destroyed without unregistering
+	for (int32 i = Entries.Num() - 1; i >= 0; --i)
+	{
+		if (!Entries[i].Observer.IsValid())
+		{
+			RemoveEntryAt(i);
+		}
+	}
+
+	const APawn* Player = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	if (Entries.IsEmpty() || !Player)
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const FVector PlayerLocation = Player->GetActorLocation();
+	const float MaxResultAge = CVarCombatSightMaxResultAge.GetValueOnGameThread();
+	const float NearDistance = FMath::Max(CVarCombatSightNearDistance.GetValueOnGameThread(), 1.0f);
+
+	// score every observer. Stale results gain priority over time, and nearby observers gain it faster
+	TraceQueue.Reset();
+
+	double TotalAge = 0.0;
+	double MaxAge = 0.0;
+
+	for (int32 i = 0; i < Entries.Num(); ++i)
+	{
+		const FCombatSightEntry& Entry = Entries[i];
+
+		float Priority;
+
+		if (Entry.LastCheckTime < 0.0)
+		{
+			// observers that were never traced go first
+			Priority = MAX_flt;
+		}
+		else
+		{
+			const double Age = Now - Entry.LastCheckTime;
+			const float Distance = FVector::Dist(Entry.Observer->GetActorLocation(), PlayerLocation);
+
+			Priority = float(Age) * NearDistance / FMath::Max(Distance, NearDistance);
+
+			// overdue results are refreshed before any result that is still within its max age
+			if (Age >= MaxResultAge)
+			{
+				Priority += 1.0f + float(Age);
+			}
+
+			TotalAge += Age;
+			MaxAge = FMath::Max(MaxAge, Age);
+		}
+
+		TraceQueue.Emplace(Priority, i);
+	}
+
+	SET_FLOAT_STAT(STAT_CombatSightAverageResultAge, TotalAge * 1000.0 / Entries.Num());
+	SET_FLOAT_STAT(STAT_CombatSightMaxResultAge, MaxAge * 1000.0);
+
+	auto HigherPriority = [](const TPair<float, int32>& A, const TPair<float, int32>& B)
+	{
+		return A.Key > B.Key;
+	};
+
+	TraceQueue.Heapify(HigherPriority);
+
+	// trace in priority order until the budget runs out, always making some progress
+	const double BudgetSeconds = CVarCombatSightBudgetMs.GetValueOnGameThread() / 1000.0;
+	const double StartTime = FPlatformTime::Seconds();
+
+	int32 NumTraces = 0;
+
+	while (!TraceQueue.IsEmpty())
+	{
+		TPair<float, int32> Item;
+		TraceQueue.HeapPop(Item, HigherPriority, EAllowShrinking::No);
+
+		FCombatSightEntry& Entry = Entries[Item.Value];
+
+		Entry.bHasLineOfSight = TraceLineOfSight(Entry.Observer.Get(), Player);
+		Entry.LastCheckTime = Now;
+
+		if (Entry.bHasLineOfSight)
+		{
+			Entry.LastSeenTime = Now;
+		}
+
+		++NumTraces;
+
+		if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_CombatSightTracesPerFrame, NumTraces);
+	SET_DWORD_STAT(STAT_CombatSightQueueDepth, TraceQueue.Num());
+}
+
+void UCombatLineOfSightSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// trace after movement, so results match where everyone ended up this frame
+	SetupTick(&UCombatLineOfSightSubsystem::TickTraces, TG_PostPhysics, TEXT("CombatLineOfSightSubsystem::TickTraces"));
+}
+
+void UCombatLineOfSightSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	EntryIndices.Empty();
+
+	Super::Deinitialize();
+}
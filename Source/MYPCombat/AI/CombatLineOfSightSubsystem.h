@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "CombatLineOfSightSubsystem.generated.h"
+
+class APawn;
+
+/**
+ *  Cached line of sight result for a registered observer
+ */
+struct FCombatSightEntry
+{
+	/** Actor looking for the player */
+	TWeakObjectPtr<AActor> Observer;
+
+	/** Map key for the observer, still usable after the observer is destroyed */
+	TObjectKey<AActor> ObserverKey;
+
+	/** World time of the last trace, or a negative value if it was never traced */
+	double LastCheckTime = -1.0;
+
+	/** World time the observer last saw the player, or a negative value if it never did */
+	double LastSeenTime = -1.0;
+
+	/** Result of the last trace */
+	bool bHasLineOfSight = false;
+};
+
+/**
+ *  Answers "can this enemy see the player?" for every registered observer without tracing for each of them every frame.
+ *  - Observers register their interest once and read back the cached result
+ *  - Each frame, the stalest and closest observers are traced first until the frame's time budget runs out
+ *  - Results older than the max result age jump the queue, so distant observers still refresh regularly
+ */
+UCLASS()
+class UCombatLineOfSightSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Registered observers */
+	TArray<FCombatSightEntry> Entries;
+
+	/** Maps each registered observer to its entry */
+	TMap<TObjectKey<AActor>, int32> EntryIndices;
+
+	/** Scratch priority queue of entry indices, reused between frames */
+	TArray<TPair<float, int32>> TraceQueue;
+
+public:
+
+	/** Starts tracing line of sight from this observer to the player */
+	void RegisterObserver(AActor* Observer);
+
+	/** Stops tracing line of sight from this observer */
+	void UnregisterObserver(AActor* Observer);
+
+	/**
+	 *  Returns the cached line of sight result for an observer.
+	 *  @param Observer			Registered observer
+	 *  @param MaxResultAge		If greater than zero, results older than this many seconds count as not seeing the player
+	 *  @return true if the observer's last trace reached the player
+	 */
+	bool HasLineOfSight(const AActor* Observer, float MaxResultAge = 0.0f) const;
+
+	/** Returns the seconds since the observer was last traced, or -1 if it hasn't been traced yet */
+	float GetResultAge(const AActor* Observer) const;
+
+	/** Returns the seconds since the observer last saw the player, or -1 if it never did */
+	float GetTimeSinceSeen(const AActor* Observer) const;
+
+protected:
+
+	/** Returns the registered entry for an observer, or nullptr */
+	const FCombatSightEntry* FindEntry(const AActor* Observer) const;
+
+	/** Removes the entry at the given index, keeping the index map in sync */
+	void RemoveEntryAt(int32 Index);
+
+	/** Traces from the observer's eyes to the target's view location. Returns true if nothing is in the way */
+	bool TraceLineOfSight(const AActor* Observer, const APawn* Target) const;
+
+	/** Refreshes the stalest results under the frame budget */
+	void TickTraces(float DeltaTime);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Sets up the trace tick */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Drops all registered observers */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
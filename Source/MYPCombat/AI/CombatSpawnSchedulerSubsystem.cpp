@@ -0,0 +1,126 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatSpawnSchedulerSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "CombatEnemySpawner.h"
+#include "MYP.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Spawn Scheduler"), STAT_CombatSpawnScheduler, STATGROUP_MYP);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat Spawn Queue Length"), STAT_CombatSpawnQueueLength, STATGROUP_MYP);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Combat Spawn Frame Cost (ms)"), STAT_CombatSpawnFrameCost, STATGROUP_MYP);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Combat Spawn Worst Frame Cost (ms)"), STAT_CombatSpawnWorstFrameCost, STATGROUP_MYP);
+
+static TAutoConsoleVariable<float> CVarCombatSpawnBudgetMs(
+	TEXT("Combat.Spawn.BudgetMs"),
+	2.0f,
+	TEXT("Time in milliseconds the spawn scheduler may spend spawning enemies each frame. At least one enemy is spawned every frame while the queue isn't empty."),
+	ECVF_Scalability);
+
+static FAutoConsoleCommandWithWorld CombatSpawnStatsCommand(
+	TEXT("Combat.Spawn.Stats"),
+	TEXT("Logs the spawn queue length and the worst frame spent spawning enemies."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UCombatSpawnSchedulerSubsystem* Scheduler = World ? World->GetSubsystem<UCombatSpawnSchedulerSubsystem>() : nullptr)
+		{
+			UE_LOG(MYPLog, Log, TEXT("Spawn queue length %d, worst spawn frame %.3f ms"), Scheduler->GetQueueLength(), Scheduler->GetWorstFrameCostMs());
+		}
+	}));
+
+void UCombatSpawnSchedulerSubsystem::QueueSpawn(ACombatEnemySpawner* Spawner)
+{
+	if (Spawner)
+	{
+		SpawnQueue.Add(Spawner);
+		INC_DWORD_STAT(STAT_CombatSpawnQueueLength);
+	}
+}
+
+void UCombatSpawnSchedulerSubsystem::CancelSpawns(ACombatEnemySpawner* Spawner)
+{
+	// a spawn callback may cancel while we're walking the queue, so only clear the entries and let TickSpawns skip them
+	if (bIsSpawning)
+	{
+		for (TWeakObjectPtr<ACombatEnemySpawner>& QueuedSpawner : SpawnQueue)
+		{
+			if (QueuedSpawner == Spawner)
+			{
+				QueuedSpawner.Reset();
+			}
+		}
+
+		return;
+	}
+
+	const int32 NumRemoved = SpawnQueue.Remove(Spawner);
+	DEC_DWORD_STAT_BY(STAT_CombatSpawnQueueLength, NumRemoved);
+}
+
+void UCombatSpawnSchedulerSubsystem::TickSpawns(float DeltaTime)
+{
+	if (SpawnQueue.IsEmpty())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CombatSpawnScheduler);
+
+	const double BudgetSeconds = CVarCombatSpawnBudgetMs.GetValueOnGameThread() / 1000.0;
+	const double StartTime = FPlatformTime::Seconds();
+
+	// spawn in request order until the budget runs out
+	int32 NumProcessed = 0;
+
+	{
+		TGuardValue<bool> SpawningGuard(bIsSpawning, true);
+
+		while (NumProcessed < SpawnQueue.Num())
+		{
+			// the spawner may have been destroyed since it queued the request
+			if (ACombatEnemySpawner* Spawner = SpawnQueue[NumProcessed].Get())
+			{
+				Spawner->SpawnEnemy();
+			}
+
+			++NumProcessed;
+
+			if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+			{
+				break;
+			}
+		}
+	}
+
+	SpawnQueue.RemoveAt(0, NumProcessed, EAllowShrinking::No);
+	DEC_DWORD_STAT_BY(STAT_CombatSpawnQueueLength, NumProcessed);
+
+	// track the frame cost, and the worst one so far
+	const float FrameCostMs = float((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	SET_FLOAT_STAT(STAT_CombatSpawnFrameCost, FrameCostMs);
+
+	if (FrameCostMs > WorstFrameCostMs)
+	{
+		WorstFrameCostMs = FrameCostMs;
+		SET_FLOAT_STAT(STAT_CombatSpawnWorstFrameCost, WorstFrameCostMs);
+	}
+}
+
+void UCombatSpawnSchedulerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// spawn early in the frame, so new enemies move and animate on the frame they appear
+	SetupTick(&UCombatSpawnSchedulerSubsystem::TickSpawns, TG_PrePhysics, TEXT("CombatSpawnSchedulerSubsystem::TickSpawns"));
+}
+
+void UCombatSpawnSchedulerSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_CombatSpawnQueueLength, SpawnQueue.Num());
+	SpawnQueue.Empty();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "CombatSpawnSchedulerSubsystem.generated.h"
+
+class ACombatEnemySpawner;
+
+/**
+ *  Spreads enemy spawns over several frames.
+ *  Spawners queue one request per enemy, and the scheduler spawns as many as fit in the frame's time budget,
+ *  always spawning at least one per frame so the queue keeps moving.
+ */
+UCLASS()
+class UCombatSpawnSchedulerSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Spawners waiting to spawn an enemy, one entry per enemy, in request order */
+	TArray<TWeakObjectPtr<ACombatEnemySpawner>> SpawnQueue;
+
+	/** Highest time spent spawning in a single frame, in milliseconds */
+	float WorstFrameCostMs = 0.0f;
+
+	/** True while TickSpawns is walking the queue */
+	bool bIsSpawning = false;
+
+public:
+
+	/** Queues an enemy spawn for the given spawner */
+	void QueueSpawn(ACombatEnemySpawner* Spawner);
+
+	/** Drops all queued spawns for the given spawner */
+	void CancelSpawns(ACombatEnemySpawner* Spawner);
+
+	/** Returns the number of queued spawns */
+	int32 GetQueueLength() const { return SpawnQueue.Num(); }
+
+	/** Returns the highest time spent spawning in a single frame, in milliseconds */
+	float GetWorstFrameCostMs() const { return WorstFrameCostMs; }
+
+protected:
+
+	/** Spawns queued enemies under the frame budget */
+	void TickSpawns(float DeltaTime);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Sets up the spawn tick */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Drops any queued spawns */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
@@ -8,6 +8,9 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "AIController.h"
 #include "CombatEnemy.h"
+#include "CombatFlowFieldSubsystem.h"
+#include "CombatLineOfSightSubsystem.h"
+#include "CombatTacticalSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "StateTreeAsyncExecutionContext.h"
 
@@ -30,6 +33,30 @@ FText FStateTreeCharacterGroundedCondition::GetDescription(const FGuid& ID, FSta
 
 ////////////////////////////////////////////////////////////////////
 
+bool FStateTreePlayerVisibleCondition::TestCondition(FStateTreeExecutionContext& Context) const
+{
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	// read the last traced result instead of tracing here, so the check costs the same for every enemy
+	bool bCondition = false;
+
+	if (const UCombatLineOfSightSubsystem* LineOfSight = InstanceData.Character->GetWorld()->GetSubsystem<UCombatLineOfSightSubsystem>())
+	{
+		bCondition = LineOfSight->HasLineOfSight(InstanceData.Character, InstanceData.MaxResultAge);
+	}
+
+	return InstanceData.bMustNotBeVisible ? !bCondition : bCondition;
+}
+
+#if WITH_EDITOR
+FText FStateTreePlayerVisibleCondition::GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting /*= EStateTreeNodeFormatting::Text*/) const
+{
+	return FText::FromString("<b>Is Player Visible</b>");
+}
+#endif // WITH_EDITOR
+
+////////////////////////////////////////////////////////////////////
+
 EStateTreeRunStatus FStateTreeComboAttackTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
 	// have we transitioned from another state?
@@ -287,4 +314,100 @@ FText FStateTreeGetPlayerInfoTask::GetDescription(const FGuid& ID, FStateTreeDat
 {
 	return FText::FromString("<b>Get Player Info</b>");
 }
+#endif // WITH_EDITOR
+
+////////////////////////////////////////////////////////////////////
+
+EStateTreeRunStatus FStateTreeFlowFieldPursuitTask::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	// get the instance data
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	// get the character possessed by the first local player
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(InstanceData.Character, 0);
+
+	if (!PlayerPawn)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	const FVector CharacterLocation = InstanceData.Character->GetActorLocation();
+	const FVector PlayerLocation = PlayerPawn->GetActorLocation();
+
+	// have we caught up with the player?
+	if (FVector::DistSquared2D(CharacterLocation, PlayerLocation) <= FMath::Square(InstanceData.AcceptanceRadius))
+	{
+		return EStateTreeRunStatus::Succeeded;
+	}
+
+	// steer along the flow field. Off the field, head straight for the player
+	FVector Direction;
+	const UCombatFlowFieldSubsystem* FlowField = InstanceData.Character->GetWorld()->GetSubsystem<UCombatFlowFieldSubsystem>();
+
+	if (!FlowField || !FlowField->SampleDirection(CharacterLocation, Direction))
+	{
+		Direction = (PlayerLocation - CharacterLocation).GetSafeNormal2D();
+	}
+
+	InstanceData.Character->AddMovementInput(Direction);
+
+	return EStateTreeRunStatus::Running;
+}
+
+#if WITH_EDITOR
+FText FStateTreeFlowFieldPursuitTask::GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting /*= EStateTreeNodeFormatting::Text*/) const
+{
+	return FText::FromString("<b>Flow Field Pursuit</b>");
+}
+#endif // WITH_EDITOR
+
+////////////////////////////////////////////////////////////////////
+
+EStateTreeRunStatus FStateTreeFindTacticalPositionTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	// have we transitioned from another state?
+	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
+	{
+		// get the instance data
+		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+		const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(InstanceData.Character, 0);
+		UCombatTacticalSubsystem* Tactical = InstanceData.Character->GetWorld()->GetSubsystem<UCombatTacticalSubsystem>();
+
+		if (!PlayerPawn || !Tactical)
+		{
+			return EStateTreeRunStatus::Failed;
+		}
+
+		// pick and claim a position from the baked grid
+		if (!Tactical->FindPosition(InstanceData.Character, InstanceData.Query, PlayerPawn->GetActorLocation(), InstanceData.TacticalLocation))
+		{
+			return EStateTreeRunStatus::Failed;
+		}
+	}
+
+	return EStateTreeRunStatus::Running;
+}
+
+void FStateTreeFindTacticalPositionTask::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	// have we transitioned to another state?
+	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
+	{
+		// get the instance data
+		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+		// let other enemies use the position
+		if (UCombatTacticalSubsystem* Tactical = InstanceData.Character->GetWorld()->GetSubsystem<UCombatTacticalSubsystem>())
+		{
+			Tactical->ReleaseClaim(InstanceData.Character);
+		}
+	}
+}
+
+#if WITH_EDITOR
+FText FStateTreeFindTacticalPositionTask::GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting /*= EStateTreeNodeFormatting::Text*/) const
+{
+	return FText::FromString("<b>Find Tactical Position</b>");
+}
 #endif // WITH_EDITOR
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "StateTreeTaskBase.h"
 #include "StateTreeConditionBase.h"
+#include "CombatTacticalGrid.h"
 
 #include "CombatStateTreeUtility.generated.h"
 
@@ -58,6 +59,55 @@ struct FStateTreeCharacterGroundedCondition : public FStateTreeConditionCommonBa
 
 ////////////////////////////////////////////////////////////////////
 
+/**
+ *  Instance data struct for the FStateTreePlayerVisibleCondition condition
+ */
+USTRUCT()
+struct FStateTreePlayerVisibleConditionInstanceData
+{
+	GENERATED_BODY()
+
+	/** Character looking for the player. Must be registered with the line of sight subsystem */
+	UPROPERTY(EditAnywhere, Category = "Context")
+	TObjectPtr<ACharacter> Character;
+
+	/** If greater than zero, line of sight results older than this many seconds are treated as not visible */
+	UPROPERTY(EditAnywhere, Category = "Condition", meta = (ClampMin = 0, Units = "s"))
+	float MaxResultAge = 0.0f;
+
+	/** If true, the condition passes if the player can't be seen instead */
+	UPROPERTY(EditAnywhere, Category = "Condition")
+	bool bMustNotBeVisible = false;
+};
+
+/**
+ *  StateTree condition to check the character's cached line of sight to the player
+ */
+USTRUCT(DisplayName = "Player is Visible", Category = "Combat")
+struct FStateTreePlayerVisibleCondition : public FStateTreeConditionCommonBase
+{
+	GENERATED_BODY()
+
+	/** Set the instance data type */
+	using FInstanceDataType = FStateTreePlayerVisibleConditionInstanceData;
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	/** Default constructor */
+	FStateTreePlayerVisibleCondition() = default;
+
+	/** Tests the StateTree condition */
+	virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
+
+#if WITH_EDITOR
+
+	/** Provides the description string */
+	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
+#endif
+
+};
+
+////////////////////////////////////////////////////////////////////
+
 /**
  *  Instance data struct for the Combat StateTree tasks
  */
@@ -305,6 +355,93 @@ struct FStateTreeGetPlayerInfoTask : public FStateTreeTaskCommonBase
 	/** Runs while the owning state is active */
 	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
 
+#if WITH_EDITOR
+	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
+#endif // WITH_EDITOR
+};
+
+////////////////////////////////////////////////////////////////////
+
+/**
+ *  Instance data struct for the Flow Field Pursuit StateTree task
+ */
+USTRUCT()
+struct FStateTreeFlowFieldPursuitInstanceData
+{
+	GENERATED_BODY()
+
+	/** Character that will pursue the player */
+	UPROPERTY(EditAnywhere, Category = Context)
+	TObjectPtr<ACharacter> Character;
+
+	/** Distance to the player at which the pursuit succeeds */
+	UPROPERTY(EditAnywhere, Category = Parameter, meta = (ClampMin = 0, Units = "cm"))
+	float AcceptanceRadius = 150.0f;
+};
+
+/**
+ *  StateTree task to move a Character towards the player by steering along the shared combat flow field.
+ *  Unlike a Move To task, it doesn't request a navmesh path, so its cost doesn't grow with the number of pursuers
+ */
+USTRUCT(meta=(DisplayName="Flow Field Pursuit", Category="Combat"))
+struct FStateTreeFlowFieldPursuitTask : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	/* Ensure we're using the correct instance data struct */
+	using FInstanceDataType = FStateTreeFlowFieldPursuitInstanceData;
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	/** Runs while the owning state is active */
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+
+#if WITH_EDITOR
+	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
+#endif // WITH_EDITOR
+};
+
+////////////////////////////////////////////////////////////////////
+
+/**
+ *  Instance data struct for the Find Tactical Position StateTree task
+ */
+USTRUCT()
+struct FStateTreeFindTacticalPositionInstanceData
+{
+	GENERATED_BODY()
+
+	/** Character looking for a position */
+	UPROPERTY(EditAnywhere, Category = Context)
+	TObjectPtr<ACharacter> Character;
+
+	/** Weights and ranges used to pick the position */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	FCombatTacticalQuery Query;
+
+	/** Chosen tactical position */
+	UPROPERTY(EditAnywhere, Category = Output)
+	FVector TacticalLocation = FVector::ZeroVector;
+};
+
+/**
+ *  StateTree task to pick a position from the baked combat tactical grid, as a cheaper, deterministic alternative to
+ *  running an EQS query. The position stays claimed by the Character while the owning state is active
+ */
+USTRUCT(meta=(DisplayName="Find Tactical Position", Category="Combat"))
+struct FStateTreeFindTacticalPositionTask : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	/* Ensure we're using the correct instance data struct */
+	using FInstanceDataType = FStateTreeFindTacticalPositionInstanceData;
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	/** Runs when the owning state is entered */
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
+	/** Runs when the owning state is ended */
+	virtual void ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
 #if WITH_EDITOR
 	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
 #endif // WITH_EDITOR
@@ -0,0 +1,301 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatTacticalGrid.h"
+#include "Components/BoxComponent.h"
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+#include "CollisionQueryParams.h"
+#include "CombatTacticalSubsystem.h"
+#include "MYPFrameArena.h"
+#include "MYPTickAudit.h"
+#include "MYP.h"
+
+MYP_AUDIT_TICK(ACombatTacticalGrid);
+
+ACombatTacticalGrid::ACombatTacticalGrid()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// create the box that bounds the bake
+	RootComponent = Box = CreateDefaultSubobject<UBoxComponent>(TEXT("Box"));
+	check(Box);
+
+	Box->SetBoxExtent(FVector(1000.0f, 1000.0f, 300.0f));
+
+	// the box only marks the baked area
+	Box->SetCollisionProfileName(FName("NoCollision"));
+}
+
+bool ACombatTacticalGrid::ContainsLocation(const FVector& Location) const
+{
+	return Box->Bounds.GetBox().IsInsideOrOn(Location);
+}
+
+FVector ACombatTacticalGrid::GetPointLocation(int32 PointIndex) const
+{
+	return FVector(PointsX[PointIndex], PointsY[PointIndex], PointsZ[PointIndex]);
+}
+
+int32 ACombatTacticalGrid::FindBestPoint(const FCombatTacticalQuery& Query, const FVector& QuerierLocation, const FVector& PlayerLocation, TConstArrayView<FVector> CrowdLocations, TArray<float>& Scores) const
+{
+	if (NumPoints == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// the point arrays are padded, so every block of four is complete
+	const int32 NumPadded = PointsX.Num();
+	check(NumPadded % 4 == 0);
+
+	Scores.SetNumUninitialized(NumPadded, EAllowShrinking::No);
+
+	// broadcast the query parameters
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float One = VectorOneFloat();
+	const VectorRegister4Float Rejected = VectorSetFloat1(-MAX_flt);
+
+	const VectorRegister4Float QuerierX = VectorSetFloat1(float(QuerierLocation.X));
+	const VectorRegister4Float QuerierY = VectorSetFloat1(float(QuerierLocation.Y));
+	const VectorRegister4Float QuerierZ = VectorSetFloat1(float(QuerierLocation.Z));
+	const VectorRegister4Float SearchRadiusSq = VectorSetFloat1(FMath::Square(Query.SearchRadius));
+
+	const VectorRegister4Float PlayerX = VectorSetFloat1(float(PlayerLocation.X));
+	const VectorRegister4Float PlayerY = VectorSetFloat1(float(PlayerLocation.Y));
+	const VectorRegister4Float PlayerZ = VectorSetFloat1(float(PlayerLocation.Z));
+	const VectorRegister4Float IdealDistance = VectorSetFloat1(Query.IdealPlayerDistance);
+	const VectorRegister4Float InvIdealDistance = VectorSetFloat1(1.0f / FMath::Max(Query.IdealPlayerDistance, 1.0f));
+
+	const VectorRegister4Float InvCrowdingRadiusSq = VectorSetFloat1(1.0f / FMath::Square(FMath::Max(Query.CrowdingRadius, 1.0f)));
+
+	const VectorRegister4Float CoverWeight = VectorSetFloat1(Query.CoverWeight);
+	const VectorRegister4Float HeightWeight = VectorSetFloat1(Query.HeightWeight);
+	const VectorRegister4Float ConnectivityWeight = VectorSetFloat1(Query.ConnectivityWeight);
+	const VectorRegister4Float PlayerDistanceWeight = VectorSetFloat1(Query.PlayerDistanceWeight);
+	const VectorRegister4Float CrowdingWeight = VectorSetFloat1(Query.CrowdingWeight);
+
+	// broadcast the crowd locations once, instead of once per block
+	TArray<VectorRegister4Float, TMYPInlineFrameAllocator<48>> Crowd;
+	Crowd.Reserve(CrowdLocations.Num() * 3);
+
+	for (const FVector& CrowdLocation : CrowdLocations)
+	{
+		Crowd.Add(VectorSetFloat1(float(CrowdLocation.X)));
+		Crowd.Add(VectorSetFloat1(float(CrowdLocation.Y)));
+		Crowd.Add(VectorSetFloat1(float(CrowdLocation.Z)));
+	}
+
+	for (int32 i = 0; i < NumPadded; i += 4)
+	{
+		const VectorRegister4Float X = VectorLoad(PointsX.GetData() + i);
+		const VectorRegister4Float Y = VectorLoad(PointsY.GetData() + i);
+		const VectorRegister4Float Z = VectorLoad(PointsZ.GetData() + i);
+
+		// baked scores
+		VectorRegister4Float Score = VectorMultiply(VectorLoad(CoverScores.GetData() + i), CoverWeight);
+		Score = VectorMultiplyAdd(VectorLoad(HeightScores.GetData() + i), HeightWeight, Score);
+		Score = VectorMultiplyAdd(VectorLoad(ConnectivityScores.GetData() + i), ConnectivityWeight, Score);
+
+		// prefer points close to the ideal distance from the player
+		VectorRegister4Float DeltaX = VectorSubtract(X, PlayerX);
+		VectorRegister4Float DeltaY = VectorSubtract(Y, PlayerY);
+		VectorRegister4Float DeltaZ = VectorSubtract(Z, PlayerZ);
+		const VectorRegister4Float PlayerDistance = VectorSqrt(VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaZ, DeltaZ))));
+		const VectorRegister4Float DistanceError = VectorMin(VectorMultiply(VectorAbs(VectorSubtract(PlayerDistance, IdealDistance)), InvIdealDistance), One);
+		Score = VectorMultiplyAdd(VectorSubtract(One, DistanceError), PlayerDistanceWeight, Score);
+
+		// penalize points near other claimed points, falling off with the squared distance
+		VectorRegister4Float Crowding = Zero;
+
+		for (int32 c = 0; c < Crowd.Num(); c += 3)
+		{
+			DeltaX = VectorSubtract(X, Crowd[c]);
+			DeltaY = VectorSubtract(Y, Crowd[c + 1]);
+			DeltaZ = VectorSubtract(Z, Crowd[c + 2]);
+			const VectorRegister4Float CrowdDistanceSq = VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaZ, DeltaZ)));
+			Crowding = VectorAdd(Crowding, VectorMax(Zero, VectorSubtract(One, VectorMultiply(CrowdDistanceSq, InvCrowdingRadiusSq))));
+		}
+
+		Score = VectorNegateMultiplyAdd(Crowding, CrowdingWeight, Score);
+
+		// reject points outside the search radius
+		DeltaX = VectorSubtract(X, QuerierX);
+		DeltaY = VectorSubtract(Y, QuerierY);
+		DeltaZ = VectorSubtract(Z, QuerierZ);
+		const VectorRegister4Float QuerierDistanceSq = VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaZ, DeltaZ)));
+		Score = VectorSelect(VectorCompareLE(QuerierDistanceSq, SearchRadiusSq), Score, Rejected);
+
+		VectorStore(Score, Scores.GetData() + i);
+	}
+
+	// pick the best point, skipping the padding. Ties go to the lowest index so results are deterministic
+	int32 BestIndex = INDEX_NONE;
+	float BestScore = -MAX_flt;
+
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		if (Scores[i] > BestScore)
+		{
+			BestScore = Scores[i];
+			BestIndex = i;
+		}
+	}
+
+	return BestIndex;
+}
+
+#if WITH_EDITOR
+
+void ACombatTacticalGrid::Bake()
+{
+	UWorld* World = GetWorld();
+	UNavigationSystemV1* NavSys = World ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+
+	if (!NavSys)
+	{
+		UE_LOG(MYPLog, Warning, TEXT("%s: can't bake tactical points without a navigation system"), *GetActorNameOrLabel());
+		return;
+	}
+
+	Modify();
+
+	// sample the navmesh over a grid covering the box
+	const FBox Bounds = Box->Bounds.GetBox();
+	const FVector BoundsSize = Bounds.GetSize();
+	const int32 SizeX = FMath::Max(1, FMath::FloorToInt32(BoundsSize.X / PointSpacing));
+	const int32 SizeY = FMath::Max(1, FMath::FloorToInt32(BoundsSize.Y / PointSpacing));
+	const FVector QueryExtent(PointSpacing * 0.5f, PointSpacing * 0.5f, BoundsSize.Z * 0.5f);
+
+	TArray<FVector> Locations;
+	TArray<int32> CellPoints;
+	CellPoints.Init(INDEX_NONE, SizeX * SizeY);
+
+	for (int32 CellIndex = 0; CellIndex < CellPoints.Num(); ++CellIndex)
+	{
+		const int32 X = CellIndex % SizeX;
+		const int32 Y = CellIndex / SizeX;
+		const FVector CellCenter(Bounds.Min.X + (X + 0.5f) * PointSpacing, Bounds.Min.Y + (Y + 0.5f) * PointSpacing, Bounds.GetCenter().Z);
+
+		FNavLocation NavLocation;
+
+		if (NavSys->ProjectPointToNavigation(CellCenter, NavLocation, QueryExtent))
+		{
+			CellPoints[CellIndex] = Locations.Add(NavLocation.Location);
+		}
+	}
+
+	// pad the arrays to whole blocks of four
+	NumPoints = Locations.Num();
+	const int32 NumPadded = Align(NumPoints, 4);
+
+	PointsX.Init(0.0f, NumPadded);
+	PointsY.Init(0.0f, NumPadded);
+	PointsZ.Init(0.0f, NumPadded);
+	CoverScores.Init(0.0f, NumPadded);
+	HeightScores.Init(0.0f, NumPadded);
+	ConnectivityScores.Init(0.0f, NumPadded);
+
+	// find the height range to normalize against
+	float MinZ = MAX_flt;
+	float MaxZ = -MAX_flt;
+
+	for (const FVector& Location : Locations)
+	{
+		MinZ = FMath::Min(MinZ, float(Location.Z));
+		MaxZ = FMath::Max(MaxZ, float(Location.Z));
+	}
+
+	const float HeightRange = FMath::Max(MaxZ - MinZ, 1.0f);
+
+	// cover only comes from static geometry, so characters placed in the level don't skew the bake
+	const FCollisionObjectQueryParams CoverObjectParams(ECC_WorldStatic);
+	const FCollisionQueryParams CoverQueryParams(SCENE_QUERY_STAT(CombatTacticalBake), false, this);
+
+	for (int32 CellIndex = 0; CellIndex < CellPoints.Num(); ++CellIndex)
+	{
+		const int32 PointIndex = CellPoints[CellIndex];
+
+		if (PointIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FVector& Location = Locations[PointIndex];
+
+		PointsX[PointIndex] = float(Location.X);
+		PointsY[PointIndex] = float(Location.Y);
+		PointsZ[PointIndex] = float(Location.Z);
+
+		HeightScores[PointIndex] = (float(Location.Z) - MinZ) / HeightRange;
+
+		// count the neighbors within a step of this point
+		const int32 X = CellIndex % SizeX;
+		const int32 Y = CellIndex / SizeX;
+		int32 NumConnected = 0;
+
+		for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+		{
+			for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+			{
+				const int32 NeighborX = X + OffsetX;
+				const int32 NeighborY = Y + OffsetY;
+
+				if ((OffsetX == 0 && OffsetY == 0) || NeighborX < 0 || NeighborY < 0 || NeighborX >= SizeX || NeighborY >= SizeY)
+				{
+					continue;
+				}
+
+				const int32 NeighborPoint = CellPoints[NeighborY * SizeX + NeighborX];
+
+				if (NeighborPoint != INDEX_NONE && FMath::Abs(Locations[NeighborPoint].Z - Location.Z) <= MaxStepHeight)
+				{
+					++NumConnected;
+				}
+			}
+		}
+
+		ConnectivityScores[PointIndex] = NumConnected / 8.0f;
+
+		// probe around the point for nearby cover
+		const FVector ProbeStart = Location + FVector(0.0f, 0.0f, CoverProbeHeight);
+		int32 NumBlocked = 0;
+
+		for (int32 Probe = 0; Probe < NumCoverProbes; ++Probe)
+		{
+			const float Angle = UE_TWO_PI * Probe / NumCoverProbes;
+			const FVector ProbeEnd = ProbeStart + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * CoverProbeDistance;
+
+			if (World->LineTraceTestByObjectType(ProbeStart, ProbeEnd, CoverObjectParams, CoverQueryParams))
+			{
+				++NumBlocked;
+			}
+		}
+
+		CoverScores[PointIndex] = float(NumBlocked) / NumCoverProbes;
+	}
+
+	UE_LOG(MYPLog, Log, TEXT("%s: baked %d tactical points from %d samples"), *GetActorNameOrLabel(), NumPoints, CellPoints.Num());
+}
+
+#endif // WITH_EDITOR
+
+void ACombatTacticalGrid::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// make the baked points available to queries
+	if (UCombatTacticalSubsystem* Tactical = GetWorld()->GetSubsystem<UCombatTacticalSubsystem>())
+	{
+		Tactical->RegisterGrid(this);
+	}
+}
+
+void ACombatTacticalGrid::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	if (UCombatTacticalSubsystem* Tactical = GetWorld()->GetSubsystem<UCombatTacticalSubsystem>())
+	{
+		Tactical->UnregisterGrid(this);
+	}
+}
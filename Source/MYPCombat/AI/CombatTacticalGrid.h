@@ -0,0 +1,155 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "CombatTacticalGrid.generated.h"
+
+class UBoxComponent;
+
+/**
+ *  Weights and ranges used to score tactical points
+ */
+USTRUCT(BlueprintType)
+struct FCombatTacticalQuery
+{
+	GENERATED_BODY()
+
+	/** Only points within this distance of the querier are considered */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tactical Query", meta = (ClampMin = 0, Units = "cm"))
+	float SearchRadius = 1500.0f;
+
+	/** Preferred distance from the player. Points score lower the further they are from it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tactical Query", meta = (ClampMin = 1, Units = "cm"))
+	float IdealPlayerDistance = 400.0f;
+
+	/** Other claimed points within this distance reduce a point's score */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tactical Query", meta = (ClampMin = 1, Units = "cm"))
+	float CrowdingRadius = 250.0f;
+
+	/** Weight of the baked cover score */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tactical Query")
+	float CoverWeight = 1.0f;
+
+	/** Weight of the baked height score */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tactical Query")
+	float HeightWeight = 0.25f;
+
+	/** Weight of the baked navigation connectivity score */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tactical Query")
+	float ConnectivityWeight = 0.5f;
+
+	/** Weight of the distance to the player term */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tactical Query")
+	float PlayerDistanceWeight = 1.0f;
+
+	/** Weight of the crowding penalty */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Tactical Query")
+	float CrowdingWeight = 1.0f;
+};
+
+/**
+ *  Holds tactical points baked in the editor over the navmesh inside its box, for one combat arena.
+ *  - Each point stores static scores for cover, height and navigation connectivity
+ *  - Points are stored as flat parallel arrays, padded to a multiple of four, so queries can score four points at a time
+ *  - Queries add the distance to the player and crowding from other claimed points to the baked scores
+ */
+UCLASS()
+class ACombatTacticalGrid : public AActor
+{
+	GENERATED_BODY()
+
+	/** Box that bounds the baked area */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
+	UBoxComponent* Box;
+
+protected:
+
+	/** Distance between sampled points */
+	UPROPERTY(EditAnywhere, Category="Tactical Grid|Bake", meta = (ClampMin = 25, Units = "cm"))
+	float PointSpacing = 150.0f;
+
+	/** Maximum height difference between neighboring points for them to count as connected */
+	UPROPERTY(EditAnywhere, Category="Tactical Grid|Bake", meta = (ClampMin = 0, Units = "cm"))
+	float MaxStepHeight = 60.0f;
+
+	/** Number of horizontal probes cast from each point to measure cover */
+	UPROPERTY(EditAnywhere, Category="Tactical Grid|Bake", meta = (ClampMin = 1, ClampMax = 32))
+	int32 NumCoverProbes = 8;
+
+	/** Length of each cover probe */
+	UPROPERTY(EditAnywhere, Category="Tactical Grid|Bake", meta = (ClampMin = 0, Units = "cm"))
+	float CoverProbeDistance = 200.0f;
+
+	/** Height above the navmesh the cover probes are cast at */
+	UPROPERTY(EditAnywhere, Category="Tactical Grid|Bake", meta = (ClampMin = 0, Units = "cm"))
+	float CoverProbeHeight = 90.0f;
+
+	/** Number of baked points, not counting the padding */
+	UPROPERTY(VisibleAnywhere, Category="Tactical Grid")
+	int32 NumPoints = 0;
+
+	/** Baked point locations */
+	UPROPERTY()
+	TArray<float> PointsX;
+
+	UPROPERTY()
+	TArray<float> PointsY;
+
+	UPROPERTY()
+	TArray<float> PointsZ;
+
+	/** Fraction of cover probes blocked around each point, from 0 to 1 */
+	UPROPERTY()
+	TArray<float> CoverScores;
+
+	/** Height of each point relative to the lowest and highest points, from 0 to 1 */
+	UPROPERTY()
+	TArray<float> HeightScores;
+
+	/** Fraction of each point's neighbors it can step to, from 0 to 1 */
+	UPROPERTY()
+	TArray<float> ConnectivityScores;
+
+public:
+
+	/** Constructor */
+	ACombatTacticalGrid();
+
+	/** Returns true if the location is inside the baked area */
+	bool ContainsLocation(const FVector& Location) const;
+
+	/** Returns the number of baked points */
+	int32 GetNumPoints() const { return NumPoints; }
+
+	/** Returns the location of a baked point */
+	FVector GetPointLocation(int32 PointIndex) const;
+
+	/**
+	 *  Scores every baked point and returns the best one.
+	 *  @param Query				Weights and ranges to score with
+	 *  @param QuerierLocation		Location of the character looking for a point
+	 *  @param PlayerLocation		Location of the player
+	 *  @param CrowdLocations		Locations that make nearby points less desirable
+	 *  @param Scores				Scratch buffer for the scores, resized as needed
+	 *  @return the best point's index, or INDEX_NONE if no point is in range
+	 */
+	int32 FindBestPoint(const FCombatTacticalQuery& Query, const FVector& QuerierLocation, const FVector& PlayerLocation, TConstArrayView<FVector> CrowdLocations, TArray<float>& Scores) const;
+
+#if WITH_EDITOR
+
+	/** Samples the navmesh inside the box and bakes the tactical points */
+	UFUNCTION(CallInEditor, Category="Tactical Grid")
+	void Bake();
+
+#endif // WITH_EDITOR
+
+protected:
+
+	/** Registers with the tactical subsystem */
+	virtual void BeginPlay() override;
+
+	/** Unregisters from the tactical subsystem */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+};
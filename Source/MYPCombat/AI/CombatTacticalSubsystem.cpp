@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatTacticalSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "MYP.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Tactical Query"), STAT_CombatTacticalQuery, STATGROUP_MYP);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Tactical Queries"), STAT_CombatTacticalQueries, STATGROUP_MYP);
+
+void UCombatTacticalSubsystem::RegisterGrid(ACombatTacticalGrid* Grid)
+{
+	if (Grid)
+	{
+		Grids.AddUnique(Grid);
+	}
+}
+
+void UCombatTacticalSubsystem::UnregisterGrid(ACombatTacticalGrid* Grid)
+{
+	Grids.Remove(Grid);
+}
+
+bool UCombatTacticalSubsystem::FindPosition(AActor* Querier, const FCombatTacticalQuery& Query, const FVector& PlayerLocation, FVector& OutLocation)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatTacticalQuery);
+	INC_DWORD_STAT(STAT_CombatTacticalQueries);
+
+	if (!Querier)
+	{
+		return false;
+	}
+
+	const FVector QuerierLocation = Querier->GetActorLocation();
+	const ACombatTacticalGrid* Grid = FindGrid(QuerierLocation);
+
+	if (!Grid)
+	{
+		return false;
+	}
+
+	// the other queriers' claims make their surroundings less attractive
+	const TObjectKey<AActor> QuerierKey(Querier);
+
+	CrowdScratch.Reset();
+
+	for (auto It = Claims.CreateIterator(); It; ++It)
+	{
+		// drop claims left behind by queriers that are gone
+		if (!It->Key.ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (It->Key != QuerierKey)
+		{
+			CrowdScratch.Add(It->Value);
+		}
+	}
+
+	const int32 PointIndex = Grid->FindBestPoint(Query, QuerierLocation, PlayerLocation, CrowdScratch, ScoreScratch);
+
+	if (PointIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutLocation = Grid->GetPointLocation(PointIndex);
+	Claims.Add(QuerierKey, OutLocation);
+
+	return true;
+}
+
+void UCombatTacticalSubsystem::ReleaseClaim(AActor* Querier)
+{
+	Claims.Remove(Querier);
+}
+
+const ACombatTacticalGrid* UCombatTacticalSubsystem::FindGrid(const FVector& Location) const
+{
+	for (const TWeakObjectPtr<ACombatTacticalGrid>& Grid : Grids)
+	{
+		if (Grid.IsValid() && Grid->GetNumPoints() > 0 && Grid->ContainsLocation(Location))
+		{
+			return Grid.Get();
+		}
+	}
+
+	return nullptr;
+}
+
+void UCombatTacticalSubsystem::Deinitialize()
+{
+	Grids.Empty();
+	Claims.Empty();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "CombatTacticalGrid.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "CombatTacticalSubsystem.generated.h"
+
+/**
+ *  Picks tactical positions for combat enemies from the baked tactical grids in the level.
+ *  Each enemy holds a claim on the last point it was given, so enemies querying after it spread out around it.
+ *  Claims are released when the enemy leaves the state, dies or ends play, and any left by destroyed queriers are pruned on the next query.
+ */
+UCLASS()
+class UCombatTacticalSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Tactical grids in the level */
+	TArray<TWeakObjectPtr<ACombatTacticalGrid>> Grids;
+
+	/** Point currently claimed by each querier */
+	TMap<TObjectKey<AActor>, FVector> Claims;
+
+	/** Scratch buffers reused between queries */
+	TArray<FVector> CrowdScratch;
+	TArray<float> ScoreScratch;
+
+public:
+
+	/** Adds a tactical grid to the query set */
+	void RegisterGrid(ACombatTacticalGrid* Grid);
+
+	/** Removes a tactical grid from the query set */
+	void UnregisterGrid(ACombatTacticalGrid* Grid);
+
+	/**
+	 *  Finds the best tactical position for a querier and claims it.
+	 *  @param Querier			Actor looking for a position. Its own claim doesn't count as crowding
+	 *  @param Query			Weights and ranges to score with
+	 *  @param PlayerLocation	Location of the player
+	 *  @param OutLocation		Location of the chosen point
+	 *  @return true if a point was found
+	 */
+	bool FindPosition(AActor* Querier, const FCombatTacticalQuery& Query, const FVector& PlayerLocation, FVector& OutLocation);
+
+	/** Releases the point claimed by a querier */
+	void ReleaseClaim(AActor* Querier);
+
+protected:
+
+	/** Returns the grid containing a location, or nullptr */
+	const ACombatTacticalGrid* FindGrid(const FVector& Location) const;
+
+public:
+
+	// ~begin USubsystem interface
+
+	/** Releases all grids and claims */
+	virtual void Deinitialize() override;
+
+	// ~end USubsystem interface
+};
@@ -5,7 +5,13 @@
 #include "CombatAttacker.h"
 #include "Components/SkeletalMeshComponent.h"
 
-void UAnimNotify_CheckChargedAttack::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+UAnimNotify_CheckChargedAttack::UAnimNotify_CheckChargedAttack()
+{
+	// fire as a branching point so the charge loop jump happens before the section ends, regardless of update rate
+	bIsNativeBranchingPoint = true;
+}
+
+void UAnimNotify_CheckChargedAttack::FireGameplayNotify(USkeletalMeshComponent* MeshComp)
 {
 	// cast the owner to the attacker interface
 	if (ICombatAttacker* AttackerInterface = Cast<ICombatAttacker>(MeshComp->GetOwner()))
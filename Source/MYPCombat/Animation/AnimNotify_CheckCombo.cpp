@@ -5,7 +5,13 @@
 #include "CombatAttacker.h"
 #include "Components/SkeletalMeshComponent.h"
 
-void UAnimNotify_CheckCombo::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+UAnimNotify_CheckCombo::UAnimNotify_CheckCombo()
+{
+	// fire as a branching point so the combo section jump isn't missed at reduced animation update rates
+	bIsNativeBranchingPoint = true;
+}
+
+void UAnimNotify_CheckCombo::FireGameplayNotify(USkeletalMeshComponent* MeshComp)
 {
 	// cast the owner to the attacker interface
 	if (ICombatAttacker* AttackerInterface = Cast<ICombatAttacker>(MeshComp->GetOwner()))
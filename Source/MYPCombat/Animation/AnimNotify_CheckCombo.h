@@ -3,21 +3,24 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Animation/AnimNotifies/AnimNotify.h"
+#include "MYPGameplayAnimNotify.h"
 #include "AnimNotify_CheckCombo.generated.h"
 
 /**
  *  AnimNotify to perform a combo string check.
  */
 UCLASS()
-class UAnimNotify_CheckCombo : public UAnimNotify
+class UAnimNotify_CheckCombo : public UMYPGameplayAnimNotify
 {
 	GENERATED_BODY()
 	
 public:
 
-	/** Perform the Anim Notify */
-	virtual void Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
+	/** Constructor */
+	UAnimNotify_CheckCombo();
+
+	/** Perform the gameplay logic for the Anim Notify */
+	virtual void FireGameplayNotify(USkeletalMeshComponent* MeshComp) override;
 
 	/** Get the notify name */
 	virtual FString GetNotifyName_Implementation() const override;
@@ -5,7 +5,13 @@
 #include "CombatAttacker.h"
 #include "Components/SkeletalMeshComponent.h"
 
-void UAnimNotify_DoAttackTrace::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+UAnimNotify_DoAttackTrace::UAnimNotify_DoAttackTrace()
+{
+	// fire as a branching point so the trace happens at its exact montage time, even if the mesh's update rate is throttled by the animation budget
+	bIsNativeBranchingPoint = true;
+}
+
+void UAnimNotify_DoAttackTrace::FireGameplayNotify(USkeletalMeshComponent* MeshComp)
 {
 	// cast the owner to the attacker interface
 	if (ICombatAttacker* AttackerInterface = Cast<ICombatAttacker>(MeshComp->GetOwner()))
@@ -3,14 +3,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Animation/AnimNotifies/AnimNotify.h"
+#include "MYPGameplayAnimNotify.h"
 #include "AnimNotify_DoAttackTrace.generated.h"
 
 /**
  *  AnimNotify to tell the actor to perform an attack trace check to look for targets to damage.
  */
 UCLASS()
-class UAnimNotify_DoAttackTrace : public UAnimNotify
+class UAnimNotify_DoAttackTrace : public UMYPGameplayAnimNotify
 {
 	GENERATED_BODY()
 	
@@ -22,8 +22,11 @@ protected:
 
 public:
 
-	/** Perform the Anim Notify */
-	virtual void Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
+	/** Constructor */
+	UAnimNotify_DoAttackTrace();
+
+	/** Perform the gameplay logic for the Anim Notify */
+	virtual void FireGameplayNotify(USkeletalMeshComponent* MeshComp) override;
 
 	/** Get the notify name */
 	virtual FString GetNotifyName_Implementation() const override;
@@ -0,0 +1,297 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPBenchmark.h"
+
+#if MYP_WITH_BENCHMARKS
+
+#include "Engine/World.h"
+#include "Engine/DamageEvents.h"
+#include "EngineUtils.h"
+#include "AIController.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StateTreeAIComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "CombatCharacter.h"
+#include "CombatEnemy.h"
+#include "CombatEnemySpawner.h"
+#include "CombatDamageSubsystem.h"
+#include "CombatHurtboxSubsystem.h"
+#include "MYP.h"
+
+namespace CombatBenchmarks
+{
+	static const TCHAR* CharacterClassPath = TEXT("/Game/Variant_Combat/Blueprints/BP_CombatCharacter.BP_CombatCharacter_C");
+	static const TCHAR* EnemyClassPath = TEXT("/Game/Variant_Combat/Blueprints/AI/BP_CombatEnemy.BP_CombatEnemy_C");
+	static const TCHAR* SpawnerClassPath = TEXT("/Game/Variant_Combat/Blueprints/AI/BP_CombatEnemySpawner.BP_CombatEnemySpawner_C");
+	static const TCHAR* BoxClassPath = TEXT("/Game/Variant_Combat/Blueprints/Interactables/BP_CombatDamageableBox.BP_CombatDamageableBox_C");
+
+	/** Bone the attack montage notifies trace from */
+	static const TCHAR* AttackBoneName = TEXT("hand_r");
+
+	/** Number of targets the attack benchmarks are run against */
+	static const int32 TargetCounts[] = { 1, 8, 32 };
+
+	/** Spawns targets clustered inside the attacker's melee sweep, pinned in place so every iteration hits all of them */
+	static void SpawnTargets(FMYPBenchmarkContext& Context, UClass* TargetClass, const FVector& Center, int32 NumTargets, TArray<AActor*>& OutTargets)
+	{
+		for (int32 TargetIndex = 0; TargetIndex < NumTargets; ++TargetIndex)
+		{
+			const FVector Offset = FRotator(0.0f, 360.0f * TargetIndex / NumTargets, 0.0f).Vector() * 20.0f;
+
+			AActor* Target = Context.SpawnActor(TargetClass, Center + Offset);
+
+			if (!Target)
+			{
+				continue;
+			}
+
+			// props would scatter and enemies would walk away as the world ticks between iterations
+			if (UPrimitiveComponent* Root = Cast<UPrimitiveComponent>(Target->GetRootComponent()))
+			{
+				Root->SetSimulatePhysics(false);
+			}
+
+			if (ACharacter* TargetCharacter = Cast<ACharacter>(Target))
+			{
+				TargetCharacter->GetCharacterMovement()->DisableMovement();
+			}
+
+			OutTargets.Add(Target);
+		}
+	}
+
+	/** Destroys the spawned targets */
+	static void DestroyTargets(TArray<AActor*>& Targets)
+	{
+		for (AActor* Target : Targets)
+		{
+			Target->Destroy();
+		}
+
+		Targets.Reset();
+	}
+
+	/** Player attack traces against damageable props, which are swept in the physics scene, and enemies, which are queued for the hurtbox subsystem */
+	static void MeasureAttackTrace(FMYPBenchmarkContext& Context, UClass* CharacterClass, UClass* BoxClass, UClass* EnemyClass)
+	{
+		UWorld* World = Context.GetWorld();
+
+		ACombatCharacter* Attacker = Context.SpawnActor<ACombatCharacter>(CharacterClass, FVector(0.0f, 0.0f, 100.0f));
+
+		if (!Attacker)
+		{
+			return;
+		}
+
+		// let the mesh pose before reading the bone
+		Context.TickWorld();
+
+		const FName AttackBone(AttackBoneName);
+		const FVector TargetCenter = Attacker->GetMesh()->GetSocketLocation(AttackBone) + Attacker->GetActorForwardVector() * 100.0f;
+
+		// cancel the damage, so the same targets survive every iteration
+		UCombatDamageSubsystem* DamageSubsystem = World->GetSubsystem<UCombatDamageSubsystem>();
+		const FDelegateHandle CancelDamage = DamageSubsystem->AddDamageModifier(FOnModifyCombatDamage::FDelegate::CreateLambda([](FCombatDamageEvent& DamageEvent)
+		{
+			DamageEvent.Damage = 0.0f;
+		}));
+
+		TArray<AActor*> Targets;
+
+		for (const int32 NumTargets : TargetCounts)
+		{
+			if (BoxClass)
+			{
+				SpawnTargets(Context, BoxClass, TargetCenter, NumTargets, Targets);
+
+				// the world tick flushes the queued damage and hit effects
+				Context.Measure(FString::Printf(TEXT("DoAttackTrace.Props%d"), NumTargets),
+					[](){},
+					[Attacker, AttackBone]() { Attacker->DoAttackTrace(AttackBone); },
+					[&Context]() { Context.TickWorld(); });
+
+				DestroyTargets(Targets);
+			}
+
+			if (EnemyClass)
+			{
+				SpawnTargets(Context, EnemyClass, TargetCenter, NumTargets, Targets);
+
+				// publish the enemies' hurtboxes
+				Context.TickWorld();
+
+				Context.Measure(FString::Printf(TEXT("DoAttackTrace.Enemies%d"), NumTargets),
+					[](){},
+					[Attacker, AttackBone]() { Attacker->DoAttackTrace(AttackBone); },
+					[&Context]() { Context.TickWorld(); });
+
+				// the queued query resolves later in the frame, so measure it on its own
+				if (UCombatHurtboxSubsystem* Hurtboxes = World->GetSubsystem<UCombatHurtboxSubsystem>())
+				{
+					FCombatMeleeQuery Query;
+					Query.Attacker = Attacker;
+					Query.TargetFaction = ECombatFaction::Enemy;
+					Query.Start = Attacker->GetMesh()->GetSocketLocation(AttackBone);
+					Query.End = TargetCenter;
+					Query.Radius = 75.0f;
+					Query.Damage = 1.0f;
+
+					TArray<FCombatMeleeHit> Hits;
+
+					Context.Measure(FString::Printf(TEXT("MeleeQuery.Enemies%d"), NumTargets), [Hurtboxes, &Query, Attacker, &Hits]()
+					{
+						Hurtboxes->RunQuery(Query, Attacker, Hits);
+					});
+				}
+
+				DestroyTargets(Targets);
+			}
+		}
+
+		DamageSubsystem->RemoveDamageModifier(CancelDamage);
+
+		Attacker->Destroy();
+	}
+
+	/** Damage and death on a fresh actor every iteration */
+	template<typename T>
+	static void MeasureDamage(FMYPBenchmarkContext& Context, UClass* VictimClass, const TCHAR* Prefix)
+	{
+		T* Victim = nullptr;
+
+		const auto SpawnVictim = [&Context, &Victim, VictimClass]()
+		{
+			Victim = Context.SpawnActor<T>(VictimClass, FVector(300.0f, 0.0f, 100.0f));
+		};
+
+		const auto DestroyVictim = [&Victim]()
+		{
+			Victim->Destroy();
+		};
+
+		Context.Measure(FString::Printf(TEXT("%s.TakeDamage"), Prefix), SpawnVictim, [&Victim]()
+		{
+			Victim->TakeDamage(1.0f, FDamageEvent(), nullptr, nullptr);
+		}, DestroyVictim);
+
+		Context.Measure(FString::Printf(TEXT("%s.HandleDeath"), Prefix), SpawnVictim, [&Victim]()
+		{
+			Victim->HandleDeath();
+		}, DestroyVictim);
+	}
+
+	/** The enemy StateTree's entry state tasks, and the tasks of whichever states it ticks into */
+	static void MeasureStateTree(FMYPBenchmarkContext& Context, UClass* EnemyClass)
+	{
+		ACombatEnemy* Enemy = Context.SpawnActor<ACombatEnemy>(EnemyClass, FVector(600.0f, 0.0f, 100.0f));
+		const AAIController* Controller = Enemy ? Cast<AAIController>(Enemy->GetController()) : nullptr;
+		UStateTreeAIComponent* StateTree = Controller ? Controller->FindComponentByClass<UStateTreeAIComponent>() : nullptr;
+
+		if (!StateTree)
+		{
+			UE_LOG(MYPLog, Warning, TEXT("Combat: the enemy has no StateTree AI component, skipping the StateTree benchmarks"));
+
+			if (Enemy)
+			{
+				Enemy->Destroy();
+			}
+
+			return;
+		}
+
+		Context.Measure(TEXT("StateTree.EnterState"),
+			[StateTree]() { StateTree->StopLogic(TEXT("Benchmark")); },
+			[StateTree]() { StateTree->StartLogic(); },
+			[](){});
+
+		Context.Measure(TEXT("StateTree.Tick"), [StateTree]()
+		{
+			StateTree->TickComponent(1.0f / 60.0f, LEVELTICK_All, &StateTree->PrimaryComponentTick);
+		});
+
+		Enemy->Destroy();
+	}
+
+	/** Spawning an enemy at a precomputed slot */
+	static void MeasureSpawner(FMYPBenchmarkContext& Context, UClass* SpawnerClass)
+	{
+		ACombatEnemySpawner* Spawner = Context.SpawnActor<ACombatEnemySpawner>(SpawnerClass, FVector(-600.0f, 0.0f, 100.0f));
+
+		if (!Spawner)
+		{
+			return;
+		}
+
+		// enemies are owned by their AI controllers once possessed, so tell the spawned ones apart by what was there before
+		TSet<ACombatEnemy*> ExistingEnemies;
+
+		Context.Measure(TEXT("EnemySpawner.SpawnEnemy"),
+			[&Context, &ExistingEnemies]()
+			{
+				ExistingEnemies.Reset();
+
+				for (TActorIterator<ACombatEnemy> It(Context.GetWorld()); It; ++It)
+				{
+					ExistingEnemies.Add(*It);
+				}
+			},
+			[Spawner]() { Spawner->SpawnEnemy(); },
+			[&Context, &ExistingEnemies]()
+			{
+				for (TActorIterator<ACombatEnemy> It(Context.GetWorld()); It; ++It)
+				{
+					if (ExistingEnemies.Contains(*It))
+					{
+						continue;
+					}
+
+					// the controller outlives its pawn, so destroy it too
+					AController* Controller = It->GetController();
+
+					It->Destroy();
+
+					if (Controller)
+					{
+						Controller->Destroy();
+					}
+				}
+			});
+
+		Spawner->Destroy();
+	}
+
+	static void Run(FMYPBenchmarkContext& Context)
+	{
+		Context.SpawnFloor();
+
+		const TSubclassOf<ACombatCharacter> CharacterClass = Context.LoadBlueprintClass<ACombatCharacter>(CharacterClassPath);
+		const TSubclassOf<ACombatEnemy> EnemyClass = Context.LoadBlueprintClass<ACombatEnemy>(EnemyClassPath);
+		const TSubclassOf<ACombatEnemySpawner> SpawnerClass = Context.LoadBlueprintClass<ACombatEnemySpawner>(SpawnerClassPath);
+		const TSubclassOf<AActor> BoxClass = Context.LoadBlueprintClass<AActor>(BoxClassPath);
+
+		if (CharacterClass)
+		{
+			MeasureAttackTrace(Context, CharacterClass, BoxClass, EnemyClass);
+
+			MeasureDamage<ACombatCharacter>(Context, CharacterClass, TEXT("Character"));
+		}
+
+		if (EnemyClass)
+		{
+			MeasureDamage<ACombatEnemy>(Context, EnemyClass, TEXT("Enemy"));
+
+			MeasureStateTree(Context, EnemyClass);
+		}
+
+		if (SpawnerClass)
+		{
+			MeasureSpawner(Context, SpawnerClass);
+		}
+	}
+
+	static FMYPBenchmarkSuite Suite(TEXT("Combat"), &Run);
+}
+
+#endif // MYP_WITH_BENCHMARKS
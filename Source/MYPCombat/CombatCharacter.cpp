@@ -12,13 +12,25 @@
 #include "EnhancedInputComponent.h"
 #include "CombatLifeBar.h"
 #include "Engine/DamageEvents.h"
-#include "TimerManager.h"
+#include "MYPTimerSubsystem.h"
 #include "Engine/LocalPlayer.h"
 #include "CombatPlayerController.h"
+#include "CombatDamageSubsystem.h"
+#include "MYPGameplayTimelineComponent.h"
+#include "CombatHurtboxComponent.h"
+#include "CombatHurtboxSubsystem.h"
+#include "CombatTriggerSubsystem.h"
+#include "CombatCollisionChannels.h"
+#include "CombatFeedbackProfile.h"
+#include "MYPAllocScope.h"
+#include "MYPTickAudit.h"
+#include "MYP.h"
+
+MYP_AUDIT_TICK(ACombatCharacter);
 
 ACombatCharacter::ACombatCharacter()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	// bind the attack montage ended delegate
 	OnAttackMontageEnded.BindUObject(this, &ACombatCharacter::AttackMontageEnded);
@@ -47,6 +59,13 @@ ACombatCharacter::ACombatCharacter()
 	LifeBar = CreateDefaultSubobject<UWidgetComponent>(TEXT("LifeBar"));
 	LifeBar->SetupAttachment(RootComponent);
 
+	// create the gameplay timeline
+	GameplayTimeline = CreateDefaultSubobject<UMYPGameplayTimelineComponent>(TEXT("GameplayTimeline"));
+
+	// create the hurtbox
+	Hurtbox = CreateDefaultSubobject<UCombatHurtboxComponent>(TEXT("Hurtbox"));
+	Hurtbox->SetupAttachment(RootComponent);
+
 	// set the player tag
 	Tags.Add(FName("Player"));
 }
@@ -164,13 +183,60 @@ void ACombatCharacter::DoChargedAttackEnd()
 	}
 }
 
+void ACombatCharacter::BotMove(float Right, float Forward)
+{
+	DoMove(Right, Forward);
+}
+
+void ACombatCharacter::BotLook(float Yaw, float Pitch)
+{
+	DoLook(Yaw, Pitch);
+}
+
+void ACombatCharacter::BotAction(FName Action, bool bPressed)
+{
+	if (Action == MYPBotActions::Attack)
+	{
+		if (bPressed)
+		{
+			DoComboAttackStart();
+		}
+		else
+		{
+			DoComboAttackEnd();
+		}
+	}
+	else if (Action == MYPBotActions::ChargedAttack)
+	{
+		if (bPressed)
+		{
+			DoChargedAttackStart();
+		}
+		else
+		{
+			DoChargedAttackEnd();
+		}
+	}
+	else if (Action == MYPBotActions::Jump)
+	{
+		if (bPressed)
+		{
+			Jump();
+		}
+		else
+		{
+			StopJumping();
+		}
+	}
+}
+
 void ACombatCharacter::ResetHP()
 {
 	// reset the current HP total
 	CurrentHP = MaxHP;
 
 	// update the life bar
-	LifeBarWidget->SetLifePercentage(1.0f);
+	LifeBarWidget->UpdateLifePercentage(1.0f);
 }
 
 void ACombatCharacter::ComboAttack()
@@ -191,6 +257,9 @@ void ACombatCharacter::ComboAttack()
 		{
 			// set the end delegate for the montage
 			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, ComboAttackMontage);
+
+			// drive the gameplay notifies from the timeline
+			GameplayTimeline->PlayMontage(ComboAttackMontage, GetMesh());
 		}
 	}
 
@@ -214,12 +283,18 @@ void ACombatCharacter::ChargedAttack()
 		{
 			// set the end delegate for the montage
 			AnimInstance->Montage_SetEndDelegate(OnAttackMontageEnded, ChargedAttackMontage);
+
+			// drive the gameplay notifies from the timeline
+			GameplayTimeline->PlayMontage(ChargedAttackMontage, GetMesh());
 		}
 	}
 }
 
 void ACombatCharacter::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 {
+	// stop driving the montage's gameplay notifies
+	GameplayTimeline->Stop(Montage);
+
 	// reset the attacking flag
 	bIsAttacking = false;
 
@@ -242,45 +317,61 @@ void ACombatCharacter::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupt
 
 void ACombatCharacter::DoAttackTrace(FName DamageSourceBone)
 {
-	// sweep for objects in front of the character to be hit by the attack
-	TArray<FHitResult> OutHits;
+	MYP_ALLOC_SCOPE(CombatAttackTrace);
 
 	// start at the provided socket location, sweep forward
 	const FVector TraceStart = GetMesh()->GetSocketLocation(DamageSourceBone);
 	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * MeleeTraceDistance);
 
-	// check for pawn and world dynamic collision object types
+	// enemies are resolved against their bone hurtboxes later in the frame
+	if (UCombatHurtboxSubsystem* HurtboxSubsystem = GetWorld()->GetSubsystem<UCombatHurtboxSubsystem>())
+	{
+		FCombatMeleeQuery Query;
+		Query.Attacker = this;
+		Query.TargetFaction = ECombatFaction::Enemy;
+		Query.Start = TraceStart;
+		Query.End = TraceEnd;
+		Query.Radius = MeleeTraceRadius;
+		Query.Damage = MeleeDamage;
+		Query.KnockbackImpulse = MeleeKnockbackImpulse;
+		Query.LaunchImpulse = MeleeLaunchImpulse;
+
+		HurtboxSubsystem->QueueMeleeQuery(Query);
+	}
+
+	// sweep the physics scene for damageable props only. The physics query API only fills default allocator arrays, so reuse the member array
+	AttackTraceHits.Reset();
+
 	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
-	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+	ObjectParams.AddObjectTypesToQuery(ECC_CombatProp);
 
 	// use a sphere shape for the sweep
 	FCollisionShape CollisionShape;
 	CollisionShape.SetSphere(MeleeTraceRadius);
 
 	// ignore self
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatAttackTrace), false, this);
 
-	if (GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
+	if (GetWorld()->SweepMultiByObjectType(AttackTraceHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
 	{
 		// iterate over each object hit
-		for (const FHitResult& CurrentHit : OutHits)
+		for (const FHitResult& CurrentHit : AttackTraceHits)
 		{
-			// check if we've hit a damageable actor
-			ICombatDamageable* Damageable = Cast<ICombatDamageable>(CurrentHit.GetActor());
+			// knock upwards and away from the impact normal
+			const FVector Impulse = (CurrentHit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
 
-			if (Damageable)
-			{
-				// knock upwards and away from the impact normal
-				const FVector Impulse = (CurrentHit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
+			// queue the damage event so it's resolved together with any other hits this frame
+			FCombatDamageEvent DamageEvent;
+			DamageEvent.Target = CurrentHit.GetActor();
+			DamageEvent.DamageCauser = this;
+			DamageEvent.Damage = MeleeDamage;
+			DamageEvent.DamageLocation = CurrentHit.ImpactPoint;
+			DamageEvent.DamageImpulse = Impulse;
 
-				// pass the damage event to the actor
-				Damageable->ApplyDamage(MeleeDamage, this, CurrentHit.ImpactPoint, Impulse);
+			UCombatDamageSubsystem::QueueDamage(this, DamageEvent);
 
-				// call the BP handler to play effects, etc.
-				DealtDamage(MeleeDamage, CurrentHit.ImpactPoint);
-			}
+			// play the hit effects
+			PlayDealtDamageFeedback(MeleeDamage, CurrentHit.ImpactPoint, CurrentHit.ImpactNormal);
 		}
 	}
 }
@@ -307,6 +398,9 @@ void ACombatCharacter::CheckCombo()
 				{
 					AnimInstance->Montage_JumpToSection(ComboSectionNames[ComboCount], ComboAttackMontage);
 				}
+
+				// keep the gameplay timeline in sync
+				GameplayTimeline->JumpToSection(ComboSectionNames[ComboCount]);
 			}
 		}
 	}
@@ -318,19 +412,111 @@ void ACombatCharacter::CheckChargedAttack()
 	bHasLoopedChargedAttack = true;
 
 	// jump to either the loop or the attack section depending on whether we're still holding the charge button
+	const FName NextSection = bIsChargingAttack ? ChargeLoopSection : ChargeAttackSection;
+
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		AnimInstance->Montage_JumpToSection(bIsChargingAttack ? ChargeLoopSection : ChargeAttackSection, ChargedAttackMontage);
+		AnimInstance->Montage_JumpToSection(NextSection, ChargedAttackMontage);
+	}
+
+	// keep the gameplay timeline in sync
+	GameplayTimeline->JumpToSection(NextSection);
+}
+
+void ACombatCharacter::HandleMeleeHit(AActor* HitActor, float Damage, const FVector& ImpactPoint, const FVector& ImpactNormal, FName Zone)
+{
+	// play the hit effects
+	PlayDealtDamageFeedback(Damage, ImpactPoint, ImpactNormal);
+}
+
+void ACombatCharacter::PlayDealtDamageFeedback(float Damage, const FVector& ImpactPoint, const FVector& ImpactNormal)
+{
+	if (FeedbackProfile)
+	{
+		FeedbackProfile->HitDealt.Play(this, ImpactPoint, ImpactNormal.Rotation());
+	}
+
+	// only enter the Blueprint VM if asked to, or if the profile isn't there to cover for it
+	if (bUseBlueprintFeedback || !FeedbackProfile)
+	{
+		MYP_COUNT_BLUEPRINT_EVENT();
+		DealtDamage(Damage, ImpactPoint);
+	}
+}
+
+void ACombatCharacter::PlayReceivedDamageFeedback(float Damage, const FVector& ImpactPoint, const FVector& DamageDirection)
+{
+	if (FeedbackProfile)
+	{
+		FeedbackProfile->HitReceived.Play(this, ImpactPoint, DamageDirection.Rotation());
+	}
+
+	if (bUseBlueprintFeedback || !FeedbackProfile)
+	{
+		MYP_COUNT_BLUEPRINT_EVENT();
+		ReceivedDamage(Damage, ImpactPoint, DamageDirection);
 	}
 }
 
 void ACombatCharacter::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
+{
+	// apply the damage and knockback
+	const float ActualDamage = ResolveDamage(Damage, DamageCauser, DamageLocation, DamageImpulse);
+
+	// only play effects if we received nonzero damage
+	if (ActualDamage > 0.0f)
+	{
+		// play the damage effects
+		PlayReceivedDamageFeedback(ActualDamage, DamageLocation, DamageImpulse.GetSafeNormal());
+	}
+}
+
+void ACombatCharacter::ApplyDamageBatch(TConstArrayView<FCombatDamageEvent> DamageEvents)
+{
+	float TotalDamage = 0.0f;
+	FVector LastDamageLocation = FVector::ZeroVector;
+	FVector LastDamageImpulse = FVector::ZeroVector;
+
+	{
+		// defer life bar updates until the whole batch has been applied
+		TGuardValue<bool> BatchGuard(bResolvingDamageBatch, true);
+
+		// apply each damage event in order
+		for (const FCombatDamageEvent& DamageEvent : DamageEvents)
+		{
+			const float ActualDamage = ResolveDamage(DamageEvent.Damage, DamageEvent.DamageCauser.Get(), DamageEvent.DamageLocation, DamageEvent.DamageImpulse);
+
+			// accumulate the received damage and keep the last hit for effects
+			if (ActualDamage > 0.0f)
+			{
+				TotalDamage += ActualDamage;
+				LastDamageLocation = DamageEvent.DamageLocation;
+				LastDamageImpulse = DamageEvent.DamageImpulse;
+			}
+		}
+	}
+
+	// only update the UI and play effects if we received nonzero damage
+	if (TotalDamage > 0.0f)
+	{
+		// update the life bar once if we survived the batch
+		if (CurrentHP > 0.0f)
+		{
+			LifeBarWidget->UpdateLifePercentage(CurrentHP / MaxHP);
+		}
+
+		// play the damage effects once for the whole batch
+		PlayReceivedDamageFeedback(TotalDamage, LastDamageLocation, LastDamageImpulse.GetSafeNormal());
+	}
+}
+
+float ACombatCharacter::ResolveDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
 {
 	// pass the damage event to the actor
 	FDamageEvent DamageEvent;
 	const float ActualDamage = TakeDamage(Damage, DamageEvent, nullptr, DamageCauser);
 
-	// only process knockback and effects if we received nonzero damage
+	// only process knockback if we received nonzero damage
 	if (ActualDamage > 0.0f)
 	{
 		// apply the knockback impulse
@@ -342,11 +528,9 @@ void ACombatCharacter::ApplyDamage(float Damage, AActor* DamageCauser, const FVe
 			// apply an impulse to the ragdoll
 			GetMesh()->AddImpulseAtLocation(DamageImpulse * GetMesh()->GetMass(), DamageLocation);
 		}
-
-		// pass control to BP to play effects, etc.
-		ReceivedDamage(ActualDamage, DamageLocation, DamageImpulse.GetSafeNormal());
 	}
 
+	return ActualDamage;
 }
 
 void ACombatCharacter::HandleDeath()
@@ -357,14 +541,26 @@ void ACombatCharacter::HandleDeath()
 	// enable full ragdoll physics
 	GetMesh()->SetSimulatePhysics(true);
 
+	// stop enemies from hitting us while we're dead
+	Hurtbox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
 	// hide the life bar
 	LifeBar->SetHiddenInGame(true);
 
 	// pull back the camera
 	GetCameraBoom()->TargetArmLength = DeathCameraDistance;
 
+	// play the death effects
+	if (FeedbackProfile)
+	{
+		FeedbackProfile->Destroyed.Play(this, GetActorLocation());
+	}
+
 	// schedule respawning
-	GetWorld()->GetTimerManager().SetTimer(RespawnTimer, this, &ACombatCharacter::RespawnCharacter, RespawnTime, false);
+	if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+	{
+		Timers->SetTimer(RespawnTimer, this, &ACombatCharacter::RespawnCharacter, RespawnTime);
+	}
 }
 
 void ACombatCharacter::ApplyHealing(float Healing, AActor* Healer)
@@ -372,6 +568,11 @@ void ACombatCharacter::ApplyHealing(float Healing, AActor* Healer)
 	// stub
 }
 
+ECombatFaction ACombatCharacter::GetCombatFaction() const
+{
+	return ECombatFaction::Player;
+}
+
 void ACombatCharacter::RespawnCharacter()
 {
 	// destroy the character and let it be respawned by the Player Controller
@@ -397,8 +598,11 @@ float ACombatCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dama
 	}
 	else
 	{
-		// update the life bar
-		LifeBarWidget->SetLifePercentage(CurrentHP / MaxHP);
+		// update the life bar, unless we're resolving a damage batch that will update it once at the end
+		if (!bResolvingDamageBatch)
+		{
+			LifeBarWidget->UpdateLifePercentage(CurrentHP / MaxHP);
+		}
 
 		// enable partial ragdoll physics, but keep the pelvis vertical
 		GetMesh()->SetPhysicsBlendWeight(0.5f);
@@ -436,18 +640,27 @@ void ACombatCharacter::BeginPlay()
 	MeshStartingTransform = GetMesh()->GetRelativeTransform();
 
 	// set the life bar color
-	LifeBarWidget->SetBarColor(LifeBarColor);
+	LifeBarWidget->UpdateBarColor(LifeBarColor);
 
 	// reset HP to maximum
 	ResetHP();
+
+	// let trigger volumes test against us
+	if (UCombatTriggerSubsystem* Triggers = GetWorld()->GetSubsystem<UCombatTriggerSubsystem>())
+	{
+		Triggers->RegisterPawn(this);
+	}
 }
 
 void ACombatCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::EndPlay(EndPlayReason);
+	// free our trigger slot, so it can be reused by the next pawn
+	if (UCombatTriggerSubsystem* Triggers = GetWorld()->GetSubsystem<UCombatTriggerSubsystem>())
+	{
+		Triggers->UnregisterPawn(this);
+	}
 
-	// clear the respawn timer
-	GetWorld()->GetTimerManager().ClearTimer(RespawnTimer);
+	Super::EndPlay(EndPlayReason);
 }
 
 void ACombatCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -6,7 +6,9 @@
 #include "GameFramework/Character.h"
 #include "CombatAttacker.h"
 #include "CombatDamageable.h"
+#include "MYPBotInput.h"
 #include "Animation/AnimInstance.h"
+#include "MYPTimerSubsystem.h"
 #include "CombatCharacter.generated.h"
 
 class USpringArmComponent;
@@ -14,7 +16,10 @@ class UCameraComponent;
 class UInputAction;
 struct FInputActionValue;
 class UCombatLifeBar;
+class UCombatFeedbackProfile;
 class UWidgetComponent;
+class UMYPGameplayTimelineComponent;
+class UCombatHurtboxComponent;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogCombatCharacter, Log, All);
 
@@ -27,7 +32,7 @@ DECLARE_LOG_CATEGORY_EXTERN(LogCombatCharacter, Log, All);
  *  - Respawning
  */
 UCLASS(abstract)
-class ACombatCharacter : public ACharacter, public ICombatAttacker, public ICombatDamageable
+class ACombatCharacter : public ACharacter, public ICombatAttacker, public ICombatDamageable, public IMYPBotInput
 {
 	GENERATED_BODY()
 
@@ -42,6 +47,14 @@ class ACombatCharacter : public ACharacter, public ICombatAttacker, public IComb
 	/** Life bar widget component */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UWidgetComponent* LifeBar;
+
+	/** Fires gameplay notifies from attack montages independently of the animation update rate */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UMYPGameplayTimelineComponent* GameplayTimeline;
+
+	/** Makes the character visible to melee sweeps from the opposing faction */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UCombatHurtboxComponent* Hurtbox;
 	
 protected:
 
@@ -89,6 +102,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Damage")
 	TObjectPtr<UCombatLifeBar> LifeBarWidget;
 
+	/** Hit effects and sounds played natively when dealing and receiving damage */
+	UPROPERTY(EditAnywhere, Category="Feedback")
+	TObjectPtr<UCombatFeedbackProfile> FeedbackProfile;
+
+	/** If true, the DealtDamage and ReceivedDamage Blueprint events are called on top of the feedback profile. They're always called if there's no profile */
+	UPROPERTY(EditAnywhere, Category="Feedback")
+	bool bUseBlueprintFeedback = false;
+
 	/** Max amount of time that may elapse for a non-combo attack input to not be considered stale */
 	UPROPERTY(EditAnywhere, Category="Melee Attack", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
 	float AttackInputCacheTimeTolerance = 1.0f;
@@ -99,6 +120,9 @@ protected:
 	/** If true, the character is currently playing an attack animation */
 	bool bIsAttacking = false;
 
+	/** If true, the character is resolving a batch of damage events and will defer life bar updates until the batch is done */
+	bool bResolvingDamageBatch = false;
+
 	/** Distance ahead of the character that melee attack sphere collision traces will extend */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 500, Units="cm"))
 	float MeleeTraceDistance = 75.0f;
@@ -168,11 +192,14 @@ protected:
 	FOnMontageEnded OnAttackMontageEnded;
 
 	/** Character respawn timer */
-	FTimerHandle RespawnTimer;
+	FMYPTimerHandle RespawnTimer;
 
 	/** Copy of the mesh's transform so we can reset it after ragdoll animations */
 	FTransform MeshStartingTransform;
 
+	/** Prop sweep results, kept between attacks so the sweep doesn't allocate */
+	TArray<FHitResult> AttackTraceHits;
+
 public:
 	
 	/** Constructor */
@@ -249,6 +276,9 @@ public:
 	/** Performs the charged attack hold check */
 	virtual void CheckChargedAttack() override;
 
+	/** Notifies the Blueprint handler of a hurtbox hit */
+	virtual void HandleMeleeHit(AActor* HitActor, float Damage, const FVector& ImpactPoint, const FVector& ImpactNormal, FName Zone) override;
+
 	// ~end CombatAttacker interface
 
 	// ~begin CombatDamageable interface
@@ -262,8 +292,27 @@ public:
 	/** Handles healing events */
 	virtual void ApplyHealing(float Healing, AActor* Healer) override;
 
+	/** Returns the faction this character fights for */
+	virtual ECombatFaction GetCombatFaction() const override;
+
+	/** Handles all damage events received this frame, updating the life bar and effects once */
+	virtual void ApplyDamageBatch(TConstArrayView<FCombatDamageEvent> DamageEvents) override;
+
 	// ~end CombatDamageable interface
 
+	// ~begin MYPBotInput interface
+
+	/** Moves the character from a bot script */
+	virtual void BotMove(float Right, float Forward) override;
+
+	/** Turns the camera from a bot script */
+	virtual void BotLook(float Yaw, float Pitch) override;
+
+	/** Presses or releases attacks and jumps from a bot script */
+	virtual void BotAction(FName Action, bool bPressed) override;
+
+	// ~end MYPBotInput interface
+
 	/** Called from the respawn timer to destroy and re-create the character */
 	void RespawnCharacter();
 
@@ -277,6 +326,17 @@ public:
 
 protected:
 
+	/** Applies damage, knockback and hit reactions. Returns the amount of damage actually received */
+	float ResolveDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse);
+
+protected:
+
+	/** Plays the damage dealt feedback oriented along the impact normal, and calls the Blueprint handler if needed */
+	void PlayDealtDamageFeedback(float Damage, const FVector& ImpactPoint, const FVector& ImpactNormal);
+
+	/** Plays the damage received feedback, and calls the Blueprint handler if needed */
+	void PlayReceivedDamageFeedback(float Damage, const FVector& ImpactPoint, const FVector& DamageDirection);
+
 	/** Blueprint handler to play damage dealt effects */
 	UFUNCTION(BlueprintImplementableEvent, Category="Combat")
 	void DealtDamage(float Damage, const FVector& ImpactPoint);
@@ -306,4 +366,7 @@ public:
 
 	/** Returns FollowCamera subobject **/
 	FORCEINLINE class UCameraComponent* GetFollowCamera() const { return FollowCamera; }
+
+	/** Returns true if the character has run out of HP and is waiting to respawn */
+	bool IsDead() const { return CurrentHP <= 0.0f; }
 };
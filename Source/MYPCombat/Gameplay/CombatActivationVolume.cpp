@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatActivationVolume.h"
+#include "Components/BoxComponent.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/CollisionProfile.h"
+#include "CombatActivatable.h"
+#include "CombatMessages.h"
+#include "CombatTriggerSubsystem.h"
+#include "MYPTickAudit.h"
+
+MYP_AUDIT_TICK(ACombatActivationVolume);
+
+ACombatActivationVolume::ACombatActivationVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// create the box volume
+	RootComponent = Box = CreateDefaultSubobject<UBoxComponent>(TEXT("Box"));
+	check(Box);
+
+	// set the box's extent
+	Box->SetBoxExtent(FVector(500.0f, 500.0f, 500.0f));
+
+	// the trigger subsystem tests the player against the box, so it doesn't need any collision
+	Box->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	Box->SetGenerateOverlapEvents(false);
+}
+
+void ACombatActivationVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// fall back to a channel only this volume sends on
+	if (ActivationChannel.IsNone())
+	{
+		ActivationChannel = FName(*GetPathName());
+	}
+
+	// subscribe the activatable actors once, so entering the volume is a single message
+	for (AActor* CurrentActor : ActorsToActivate)
+	{
+		if (ICombatActivatable* Activatable = Cast<ICombatActivatable>(CurrentActor))
+		{
+			Activatable->ListenForActivation(ActivationChannel);
+		}
+	}
+
+	// watch for the player entering the box. Activation is gameplay the server decides on, so clients don't test it
+	UCombatTriggerSubsystem* Triggers = GetWorld()->GetSubsystem<UCombatTriggerSubsystem>();
+
+	if (Triggers && HasAuthority())
+	{
+		Triggers->RegisterTrigger(this, Box, FCombatTriggerDelegate::CreateUObject(this, &ACombatActivationVolume::OnPlayerEntered));
+	}
+}
+
+void ACombatActivationVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCombatTriggerSubsystem* Triggers = GetWorld()->GetSubsystem<UCombatTriggerSubsystem>())
+	{
+		Triggers->UnregisterTriggers(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ACombatActivationVolume::OnPlayerEntered(APawn* PlayerPawn)
+{
+	// activate everything listening on our channel
+	if (UMYPMessageSubsystem* Messages = UMYPMessageSubsystem::Get(this))
+	{
+		FCombatActivationMessage Message;
+		Message.Instigator = PlayerPawn;
+
+		Messages->Broadcast(ActivationChannel, Message);
+	}
+}
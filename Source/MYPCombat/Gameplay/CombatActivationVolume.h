@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "CombatActivationVolume.generated.h"
+
+class UBoxComponent;
+
+/**
+ *  A simple volume that activates a list of actors when the player pawn enters.
+ *  The actors are subscribed to the volume's activation channel on BeginPlay, and activated through a message on it.
+ *  The box has no collision. Player pawns are tested against it by the trigger subsystem instead, on the server only.
+ */
+UCLASS()
+class ACombatActivationVolume : public AActor
+{
+	GENERATED_BODY()
+
+	/** Collision box volume */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
+	UBoxComponent* Box;
+	
+protected:
+
+	/** List of actors to activate when this volume is entered */
+	UPROPERTY(EditAnywhere, Category="Activation Volume")
+	TArray<AActor*> ActorsToActivate;
+
+	/** Channel the activation message is sent on. Other actors may listen on it too. If not set, a channel unique to this volume is used */
+	UPROPERTY(EditAnywhere, Category="Activation Volume")
+	FName ActivationChannel;
+
+public:	
+	
+	/** Constructor */
+	ACombatActivationVolume();
+
+protected:
+
+	/** Subscribes the actors to activate to the activation channel, and registers the box as a trigger on the server */
+	virtual void BeginPlay() override;
+
+	/** Unregisters the trigger */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Handles a player pawn entering the box volume */
+	void OnPlayerEntered(APawn* PlayerPawn);
+
+};
@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatCheckpointVolume.h"
+#include "CombatCharacter.h"
+#include "CombatPlayerController.h"
+#include "CombatTriggerSubsystem.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/World.h"
+#include "MYPTickAudit.h"
+
+MYP_AUDIT_TICK(ACombatCheckpointVolume);
+
+ACombatCheckpointVolume::ACombatCheckpointVolume()
+{
+	// create the box volume
+	RootComponent = Box = CreateDefaultSubobject<UBoxComponent>(TEXT("Box"));
+	check(Box);
+
+	// set the box's extent
+	Box->SetBoxExtent(FVector(500.0f, 500.0f, 500.0f));
+
+	// the trigger subsystem tests the player against the box, so it doesn't need any collision
+	Box->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	Box->SetGenerateOverlapEvents(false);
+}
+
+void ACombatCheckpointVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// watch for the player entering the box. Respawn transforms live on the server's player controllers, so only the server needs to
+	UCombatTriggerSubsystem* Triggers = GetWorld()->GetSubsystem<UCombatTriggerSubsystem>();
+
+	if (Triggers && HasAuthority())
+	{
+		Triggers->RegisterTrigger(this, Box, FCombatTriggerDelegate::CreateUObject(this, &ACombatCheckpointVolume::OnPlayerEntered));
+	}
+}
+
+void ACombatCheckpointVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCombatTriggerSubsystem* Triggers = GetWorld()->GetSubsystem<UCombatTriggerSubsystem>())
+	{
+		Triggers->UnregisterTriggers(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ACombatCheckpointVolume::OnPlayerEntered(APawn* PlayerPawn)
+{
+	// ensure we use this only once
+	if (bCheckpointUsed)
+	{
+		return;
+	}
+		
+	// has the player entered this volume?
+	ACombatCharacter* PlayerCharacter = Cast<ACombatCharacter>(PlayerPawn);
+
+	if (PlayerCharacter)
+	{
+		if (ACombatPlayerController* PC = Cast<ACombatPlayerController>(PlayerCharacter->GetController()))
+		{
+			// raise the checkpoint used flag
+			bCheckpointUsed = true;
+
+			// update the player's respawn checkpoint
+			PC->SetRespawnTransform(PlayerCharacter->GetActorTransform());
+		}
+
+	}
+}
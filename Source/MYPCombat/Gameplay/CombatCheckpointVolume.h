@@ -7,6 +7,10 @@
 #include "Components/BoxComponent.h"
 #include "CombatCheckpointVolume.generated.h"
 
+/**
+ *  Updates the player's respawn transform the first time they enter the volume.
+ *  The box has no collision. Player pawns are tested against it by the trigger subsystem instead, on the server only.
+ */
 UCLASS(abstract)
 class ACombatCheckpointVolume : public AActor
 {
@@ -26,7 +30,12 @@ protected:
 	/** Set to true after use to avoid accidentally resetting the checkpoint */
 	bool bCheckpointUsed = false;
 
-	/** Handles overlaps with the box volume */
-	UFUNCTION()
-	void OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+	/** Registers the box as a trigger on the server */
+	virtual void BeginPlay() override;
+
+	/** Unregisters the trigger */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Handles a player pawn entering the box volume */
+	void OnPlayerEntered(APawn* PlayerPawn);
 };
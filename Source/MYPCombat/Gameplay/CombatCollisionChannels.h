@@ -0,0 +1,38 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "CombatDamageable.h"
+
+/**
+ *  Custom object channels for combat queries, as set up in DefaultEngine.ini.
+ *  Melee sweeps query only the channels of the factions they can hurt, so the physics broadphase never returns
+ *  anything they'd have to filter out.
+ */
+
+/** Hurtboxes of player characters. Ignored by every other channel */
+#define ECC_CombatPlayerHurtbox ECC_GameTraceChannel2
+
+/** Hurtboxes of enemy characters. Ignored by every other channel */
+#define ECC_CombatEnemyHurtbox ECC_GameTraceChannel3
+
+/** Damageable props. Blocked by every other channel, like World Dynamic */
+#define ECC_CombatProp ECC_GameTraceChannel4
+
+/** Returns the object channel that hurtboxes of the given faction use */
+inline ECollisionChannel GetCombatFactionObjectType(ECombatFaction Faction)
+{
+	switch (Faction)
+	{
+	case ECombatFaction::Player:
+		return ECC_CombatPlayerHurtbox;
+
+	case ECombatFaction::Enemy:
+		return ECC_CombatEnemyHurtbox;
+
+	default:
+		return ECC_CombatProp;
+	}
+}
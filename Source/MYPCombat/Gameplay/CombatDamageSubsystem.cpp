@@ -0,0 +1,156 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatDamageSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Algo/StableSort.h"
+#include "MYPFrameArena.h"
+#include "MYPAllocScope.h"
+#include "MYP.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Damage Flush"), STAT_CombatDamageFlush, STATGROUP_MYP);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Damage Events"), STAT_CombatDamageEvents, STATGROUP_MYP);
+
+void UCombatDamageSubsystem::QueueDamage(const UObject* WorldContextObject, const FCombatDamageEvent& DamageEvent)
+{
+	// get the damage subsystem for this world
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+
+	if (UCombatDamageSubsystem* DamageSubsystem = World ? World->GetSubsystem<UCombatDamageSubsystem>() : nullptr)
+	{
+		DamageSubsystem->QueueDamageEvent(DamageEvent);
+	}
+	else
+	{
+		// no subsystem, so apply the damage right away
+		ApplyDamageImmediate(DamageEvent);
+	}
+}
+
+void UCombatDamageSubsystem::QueueDamageEvent(const FCombatDamageEvent& DamageEvent)
+{
+	// add the event to the queue
+	PendingEvents.Add(DamageEvent);
+
+	// make sure the queue gets flushed this frame
+	if (IsTickRegistered())
+	{
+		SetTickEnabled(true);
+	}
+	else
+	{
+		// the world hasn't begun play yet, so there's nothing to flush us
+		FlushDamage();
+	}
+}
+
+FDelegateHandle UCombatDamageSubsystem::AddDamageModifier(FOnModifyCombatDamage::FDelegate&& Modifier)
+{
+	return OnModifyDamage.Add(MoveTemp(Modifier));
+}
+
+void UCombatDamageSubsystem::RemoveDamageModifier(FDelegateHandle Handle)
+{
+	OnModifyDamage.Remove(Handle);
+}
+
+void UCombatDamageSubsystem::FlushDamage()
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatDamageFlush);
+	MYP_ALLOC_SCOPE(CombatDamageFlush);
+
+	// swap out the pending queue. Any damage queued while resolving will wait for the next flush
+	Swap(PendingEvents, ResolvingEvents);
+
+	INC_DWORD_STAT_BY(STAT_CombatDamageEvents, ResolvingEvents.Num());
+
+	// run the modifiers and drop any events that were cancelled or lost their target
+	for (int32 i = ResolvingEvents.Num() - 1; i >= 0; --i)
+	{
+		FCombatDamageEvent& DamageEvent = ResolvingEvents[i];
+
+		OnModifyDamage.Broadcast(DamageEvent);
+
+		if (DamageEvent.Damage <= 0.0f || !DamageEvent.Target.IsValid())
+		{
+			ResolvingEvents.RemoveAt(i, EAllowShrinking::No);
+		}
+	}
+
+	// group the events by target, keeping both the order in which targets were first hit and the order of hits per target
+	TMap<const AActor*, int32, TMYPInlineFrameSetAllocator<16>> TargetOrder;
+
+	for (const FCombatDamageEvent& DamageEvent : ResolvingEvents)
+	{
+		TargetOrder.FindOrAdd(DamageEvent.Target.Get(), TargetOrder.Num());
+	}
+
+	Algo::StableSortBy(ResolvingEvents, [&TargetOrder](const FCombatDamageEvent& DamageEvent) { return TargetOrder.FindChecked(DamageEvent.Target.Get()); });
+
+	// pass each target its batch of events
+	int32 BatchStart = 0;
+
+	while (BatchStart < ResolvingEvents.Num())
+	{
+		AActor* Target = ResolvingEvents[BatchStart].Target.Get();
+
+		// find the end of this target's batch
+		int32 BatchEnd = BatchStart + 1;
+
+		while (BatchEnd < ResolvingEvents.Num() && ResolvingEvents[BatchEnd].Target.Get() == Target)
+		{
+			++BatchEnd;
+		}
+
+		// the target may have been destroyed by an earlier batch
+		if (IsValid(Target))
+		{
+			if (ICombatDamageable* Damageable = Cast<ICombatDamageable>(Target))
+			{
+				Damageable->ApplyDamageBatch(MakeArrayView(ResolvingEvents.GetData() + BatchStart, BatchEnd - BatchStart));
+			}
+		}
+
+		BatchStart = BatchEnd;
+	}
+
+	// keep the allocation for the next flush
+	ResolvingEvents.Reset();
+
+	// stop ticking if nothing was queued during the flush
+	if (PendingEvents.IsEmpty())
+	{
+		SetTickEnabled(false);
+	}
+}
+
+void UCombatDamageSubsystem::TickFlush(float DeltaTime)
+{
+	FlushDamage();
+}
+
+void UCombatDamageSubsystem::ApplyDamageImmediate(const FCombatDamageEvent& DamageEvent)
+{
+	if (ICombatDamageable* Damageable = Cast<ICombatDamageable>(DamageEvent.Target.Get()))
+	{
+		Damageable->ApplyDamage(DamageEvent.Damage, DamageEvent.DamageCauser.Get(), DamageEvent.DamageLocation, DamageEvent.DamageImpulse);
+	}
+}
+
+void UCombatDamageSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// flush after physics so all attack traces from animation have run. Only tick while damage is queued
+	SetupTick(&UCombatDamageSubsystem::TickFlush, TG_PostPhysics, TEXT("CombatDamageSubsystem::FlushDamage"), 0.0f, false);
+}
+
+void UCombatDamageSubsystem::Deinitialize()
+{
+	// drop any unresolved damage
+	PendingEvents.Empty();
+	OnModifyDamage.Clear();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatDamageable.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "CombatDamageSubsystem.generated.h"
+
+/** Damage modifier delegate. Modifiers may scale, redirect or cancel (zero) a queued damage event */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnModifyCombatDamage, FCombatDamageEvent& /*DamageEvent*/);
+
+/**
+ *  Collects damage events raised during the frame and resolves them in a single pass.
+ *  Events are flushed after physics, grouped by target, so each damaged actor
+ *  receives one batch and can coalesce its UI and effects updates.
+ */
+UCLASS()
+class UCombatDamageSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Damage events queued for the next flush */
+	TArray<FCombatDamageEvent> PendingEvents;
+
+	/** Damage events being resolved in the current flush. Kept around to reuse its allocation */
+	TArray<FCombatDamageEvent> ResolvingEvents;
+
+	/** Damage modifiers run on every event before it is resolved */
+	FOnModifyCombatDamage OnModifyDamage;
+
+public:
+
+	/** Queues a damage event. Falls back to applying it immediately if there's no damage subsystem for the world */
+	static void QueueDamage(const UObject* WorldContextObject, const FCombatDamageEvent& DamageEvent);
+
+	/** Queues a damage event to be resolved on the next flush */
+	void QueueDamageEvent(const FCombatDamageEvent& DamageEvent);
+
+	/** Registers a damage modifier. Returns a handle that can be used to remove it */
+	FDelegateHandle AddDamageModifier(FOnModifyCombatDamage::FDelegate&& Modifier);
+
+	/** Removes a previously registered damage modifier */
+	void RemoveDamageModifier(FDelegateHandle Handle);
+
+	/** Resolves all pending damage events */
+	void FlushDamage();
+
+protected:
+
+	/** Called from the tick function to flush the queue */
+	void TickFlush(float DeltaTime);
+
+	/** Applies a damage event directly to its target, bypassing the queue */
+	static void ApplyDamageImmediate(const FCombatDamageEvent& DamageEvent);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Sets up the flush tick */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Drops any unresolved damage and modifiers */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
@@ -0,0 +1,191 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatDamageableBox.h"
+#include "Components/StaticMeshComponent.h"
+#include "MYPTimerSubsystem.h"
+#include "Engine/World.h"
+#include "CombatDebrisSubsystem.h"
+#include "CombatCollisionChannels.h"
+#include "CombatFeedbackProfile.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "MYPTickAudit.h"
+#include "MYP.h"
+
+MYP_AUDIT_TICK(ACombatDamageableBox);
+
+ACombatDamageableBox::ACombatDamageableBox()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// replicate the HP, but stay dormant until a hit changes it so untouched boxes cost the server nothing
+	bReplicates = true;
+	NetDormancy = DORM_Initial;
+
+	// create the mesh
+	RootComponent = Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
+
+	// set the collision properties
+	Mesh->SetCollisionProfileName(FName("BlockAllDynamic"));
+
+	// use the prop channel so player melee sweeps can find the box
+	Mesh->SetCollisionObjectType(ECC_CombatProp);
+
+	// enable physics
+	Mesh->SetSimulatePhysics(true);
+
+	// start asleep so boxes at rest in the level don't cost simulation time until something touches them
+	Mesh->BodyInstance.bStartAwake = false;
+
+	// use more aggressive sleep thresholds so the box goes back to sleep soon after it settles
+	Mesh->BodyInstance.SleepFamily = ESleepFamily::Custom;
+	Mesh->BodyInstance.CustomSleepThresholdMultiplier = 4.0f;
+
+	// disable navigation relevance so boxes don't affect NavMesh generation
+	Mesh->bNavigationRelevant = false;
+}
+
+void ACombatDamageableBox::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// create some debris ahead of time so the first break doesn't hitch
+	if (FractureCollection && DebrisPrewarmCount > 0)
+	{
+		if (UCombatDebrisSubsystem* DebrisSubsystem = GetWorld()->GetSubsystem<UCombatDebrisSubsystem>())
+		{
+			DebrisSubsystem->PrewarmDebris(FractureCollection, DebrisPrewarmCount);
+		}
+	}
+}
+
+void ACombatDamageableBox::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ACombatDamageableBox, CurrentHP, Params);
+}
+
+void ACombatDamageableBox::RemoveFromLevel()
+{
+	if (IsNetMode(NM_Standalone))
+	{
+		Destroy();
+		return;
+	}
+
+	// destroying right away would close the channel before the final HP goes out, and clients would never break their box.
+	// Hide it everywhere instead, and let the server destroy it once clients have caught up
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	Mesh->SetSimulatePhysics(false);
+
+	if (HasAuthority())
+	{
+		SetLifeSpan(FMath::Max(RemovedLifeSpan, KINDA_SMALL_NUMBER));
+	}
+}
+
+void ACombatDamageableBox::OnRep_CurrentHP(float OldHP)
+{
+	// break the box here too, unless a local hit already has
+	if (OldHP > 0.0f && CurrentHP <= 0.0f)
+	{
+		HandleDeath();
+	}
+}
+
+void ACombatDamageableBox::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
+{
+	// only process damage if we still have HP
+	if (CurrentHP > 0.0f)
+	{
+		// apply the damage
+		CurrentHP -= Damage;
+
+		// send the new HP, waking the box for a single net update
+		MARK_PROPERTY_DIRTY_FROM_NAME(ACombatDamageableBox, CurrentHP, this);
+		FlushNetDormancy();
+
+		// save the impulse so fracture debris can inherit it
+		LastDamageImpulse = DamageImpulse;
+
+		// apply a physics impulse to the box, ignoring its mass
+		Mesh->AddImpulseAtLocation(DamageImpulse * Mesh->GetMass(), DamageLocation);
+
+		// play the hit effects
+		if (FeedbackProfile)
+		{
+			FeedbackProfile->HitReceived.Play(this, DamageLocation, DamageImpulse.Rotation());
+		}
+
+		if (ShouldCallBlueprintFeedback())
+		{
+			MYP_COUNT_BLUEPRINT_EVENT();
+			OnBoxDamaged(DamageLocation, DamageImpulse);
+		}
+
+		// are we dead?
+		if (CurrentHP <= 0.0f)
+		{
+			HandleDeath();
+		}
+	}
+}
+
+void ACombatDamageableBox::HandleDeath()
+{
+	// do we have a fractured version of this box?
+	if (FractureCollection)
+	{
+		if (UCombatDebrisSubsystem* DebrisSubsystem = GetWorld()->GetSubsystem<UCombatDebrisSubsystem>())
+		{
+			// play the destruction effects
+			PlayDestroyedFeedback();
+
+			// swap the box for pooled debris, carrying over the box's velocity and the final hit
+			const FVector DebrisImpulse = Mesh->GetPhysicsLinearVelocity() + LastDamageImpulse;
+			DebrisSubsystem->SpawnDebris(FractureCollection, Mesh->GetComponentTransform(), DebrisImpulse, DebrisSimulationTime);
+
+			// the debris replaces us, so remove the box right away
+			RemoveFromLevel();
+			return;
+		}
+	}
+
+	// change the collision object type to Visibility so we ignore most interactions but still retain physics collisions
+	Mesh->SetCollisionObjectType(ECC_Visibility);
+
+	// play the destruction effects
+	PlayDestroyedFeedback();
+
+	// set up the death cleanup timer
+	if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+	{
+		Timers->SetTimer(DeathTimer, this, &ACombatDamageableBox::RemoveFromLevel, DeathDelayTime);
+	}
+}
+
+void ACombatDamageableBox::PlayDestroyedFeedback()
+{
+	if (FeedbackProfile)
+	{
+		FeedbackProfile->Destroyed.Play(this, Mesh->GetComponentLocation());
+	}
+
+	if (ShouldCallBlueprintFeedback())
+	{
+		MYP_COUNT_BLUEPRINT_EVENT();
+		OnBoxDestroyed();
+	}
+}
+
+void ACombatDamageableBox::ApplyHealing(float Healing, AActor* Healer)
+{
+	// stub
+}
+
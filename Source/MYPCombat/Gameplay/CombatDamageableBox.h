@@ -0,0 +1,113 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "CombatDamageable.h"
+#include "MYPTimerSubsystem.h"
+#include "CombatDamageableBox.generated.h"
+
+class UGeometryCollection;
+class UCombatFeedbackProfile;
+
+/**
+ *  A simple physics box that reacts to damage through the ICombatDamageable interface
+ *  If a fracture collection is provided, the box is swapped for pooled debris when destroyed
+ */
+UCLASS(abstract)
+class ACombatDamageableBox : public AActor, public ICombatDamageable
+{
+	GENERATED_BODY()
+	
+	/** Damageable box mesh */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
+	UStaticMeshComponent* Mesh;
+
+public:	
+
+	/** Constructor */
+	ACombatDamageableBox();
+
+protected:
+
+	/** Amount of HP this box starts with. Replicated through push model, so it's only sent when damage changes it */
+	UPROPERTY(EditAnywhere, ReplicatedUsing=OnRep_CurrentHP, Category="Damage")
+	float CurrentHP = 3.0f;
+
+	/** Time to wait before we remove this box from the level. */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
+	float DeathDelayTime = 6.0f;
+
+	/** Time a removed box is kept around hidden in networked games, so clients receive its final HP and break their copy before it's destroyed */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
+	float RemovedLifeSpan = 1.0f;
+
+	/** Pre-fractured geometry collection to swap this box for when destroyed. If not set, the intact box is kept around until it's removed */
+	UPROPERTY(EditAnywhere, Category="Destruction")
+	TObjectPtr<UGeometryCollection> FractureCollection;
+
+	/** Minimum time the fracture debris simulates before it can be put to rest. Pieces still moving by then keep simulating until they settle */
+	UPROPERTY(EditAnywhere, Category="Destruction", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
+	float DebrisSimulationTime = 2.0f;
+
+	/** Number of debris actors to create ahead of time for the fracture collection */
+	UPROPERTY(EditAnywhere, Category="Destruction", meta = (ClampMin = 0, ClampMax = 32))
+	int32 DebrisPrewarmCount = 2;
+
+	/** Hit and destruction effects played natively */
+	UPROPERTY(EditAnywhere, Category="Feedback")
+	TObjectPtr<UCombatFeedbackProfile> FeedbackProfile;
+
+	/** If true, the OnBoxDamaged and OnBoxDestroyed Blueprint events are called on top of the feedback profile. They're always called if there's no profile */
+	UPROPERTY(EditAnywhere, Category="Feedback")
+	bool bUseBlueprintFeedback = false;
+
+	/** Timer to defer destruction of this box after its HP are depleted */
+	FMYPTimerHandle DeathTimer;
+
+	/** Impulse of the last damage event, passed on to fracture debris */
+	FVector LastDamageImpulse = FVector::ZeroVector;
+
+	/** Returns true if the Blueprint feedback events need to be called */
+	bool ShouldCallBlueprintFeedback() const { return bUseBlueprintFeedback || !FeedbackProfile; }
+
+	/** Plays the destruction feedback, and calls the Blueprint handler if needed */
+	void PlayDestroyedFeedback();
+
+	/** Blueprint damage handler for effect playback */
+	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
+	void OnBoxDamaged(const FVector& DamageLocation, const FVector& DamageImpulse);
+
+	/** Blueprint destruction handler for effect playback */
+	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
+	void OnBoxDestroyed();
+
+	/** Timer callback to remove the box from the level after it dies */
+	void RemoveFromLevel();
+
+	/** Breaks the box on clients when the server's HP runs out */
+	UFUNCTION()
+	void OnRep_CurrentHP(float OldHP);
+
+public:
+
+	/** Initialization */
+	virtual void BeginPlay() override;
+
+	/** Registers the replicated HP */
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// ~Begin CombatDamageable interface
+
+	/** Handles damage and knockback events */
+	virtual void ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse) override;
+
+	/** Handles death events */
+	virtual void HandleDeath() override;
+
+	/** Handles healing events */
+	virtual void ApplyHealing(float Healing, AActor* Healer) override;
+
+	// ~End CombatDamageable interface
+};
@@ -0,0 +1,267 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatDebrisSubsystem.h"
+#include "GeometryCollection/GeometryCollectionActor.h"
+#include "GeometryCollection/GeometryCollectionComponent.h"
+#include "GeometryCollection/GeometryCollectionObject.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "MYP.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Debris Tick"), STAT_CombatDebrisTick, STATGROUP_MYP);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat Active Debris"), STAT_CombatActiveDebris, STATGROUP_MYP);
+
+static TAutoConsoleVariable<int32> CVarCombatDebrisMaxActive(
+	TEXT("Combat.Debris.MaxActive"),
+	32,
+	TEXT("Maximum number of fracture debris actors active at once. The oldest debris is recycled past this cap."),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarCombatDebrisLifetime(
+	TEXT("Combat.Debris.Lifetime"),
+	6.0f,
+	TEXT("Time in seconds fracture debris stays in the level before it's returned to its pool."),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarCombatDebrisRestSpeed(
+	TEXT("Combat.Debris.RestSpeed"),
+	5.0f,
+	TEXT("Speed in cm/s below which fracture debris counts as settled and stops simulating. Debris still falling or rolling keeps simulating until it slows down or expires."),
+	ECVF_Default);
+
+void UCombatDebrisSubsystem::SpawnDebris(UGeometryCollection* Collection, const FTransform& Transform, const FVector& Impulse, float FreezeDelay)
+{
+	if (!Collection)
+	{
+		return;
+	}
+
+	// recycle the oldest debris if we're at the cap
+	const int32 MaxActive = FMath::Max(1, CVarCombatDebrisMaxActive.GetValueOnGameThread());
+
+	while (ActiveDebris.Num() >= MaxActive)
+	{
+		ReleaseDebris(0);
+	}
+
+	// get a debris actor for this collection
+	AGeometryCollectionActor* DebrisActor = AcquireDebrisActor(Collection);
+
+	if (!DebrisActor)
+	{
+		return;
+	}
+
+	UGeometryCollectionComponent* GeometryComponent = DebrisActor->GetGeometryCollectionComponent();
+
+	// move the debris into place
+	DebrisActor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+
+	// reset the dynamic state so previously broken pieces start whole again
+	GeometryComponent->SetRestCollection(Collection);
+
+	// enable rendering, collision and physics
+	DebrisActor->SetActorHiddenInGame(false);
+	DebrisActor->SetActorEnableCollision(true);
+	GeometryComponent->SetSimulatePhysics(true);
+	GeometryComponent->RecreatePhysicsState();
+
+	// push the pieces away from the hit
+	GeometryComponent->AddImpulse(Impulse, NAME_None, true);
+
+	// track the active debris
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	FCombatActiveDebris& Debris = ActiveDebris.AddDefaulted_GetRef();
+	Debris.Actor = DebrisActor;
+	Debris.Collection = Collection;
+	Debris.FreezeTime = CurrentTime + FreezeDelay;
+	Debris.ExpireTime = CurrentTime + FMath::Max(FreezeDelay, CVarCombatDebrisLifetime.GetValueOnGameThread());
+	Debris.LastBounds = GeometryComponent->Bounds;
+	Debris.LastBoundsTime = CurrentTime;
+
+	INC_DWORD_STAT(STAT_CombatActiveDebris);
+
+	// make sure we're ticking so the debris is frozen and expired on time
+	SetTickEnabled(true);
+}
+
+void UCombatDebrisSubsystem::PrewarmDebris(UGeometryCollection* Collection, int32 Count)
+{
+	if (!Collection)
+	{
+		return;
+	}
+
+	// never prewarm more debris than can be active at once
+	const int32 TargetCount = FMath::Min(Count, CVarCombatDebrisMaxActive.GetValueOnGameThread());
+
+	FCombatDebrisPool& Pool = Pools.FindOrAdd(Collection);
+
+	while (Pool.NumCreated < TargetCount)
+	{
+		if (AGeometryCollectionActor* DebrisActor = CreateDebrisActor(Collection))
+		{
+			Pool.FreeActors.Add(DebrisActor);
+		}
+		else
+		{
+			break;
+		}
+	}
+}
+
+AGeometryCollectionActor* UCombatDebrisSubsystem::AcquireDebrisActor(UGeometryCollection* Collection)
+{
+	FCombatDebrisPool& Pool = Pools.FindOrAdd(Collection);
+
+	// reuse a pooled actor if we have any
+	while (!Pool.FreeActors.IsEmpty())
+	{
+		AGeometryCollectionActor* DebrisActor = Pool.FreeActors.Pop(EAllowShrinking::No);
+
+		if (IsValid(DebrisActor))
+		{
+			return DebrisActor;
+		}
+
+		// the pooled actor was destroyed externally
+		--Pool.NumCreated;
+	}
+
+	// spawn a new one
+	return CreateDebrisActor(Collection);
+}
+
+AGeometryCollectionActor* UCombatDebrisSubsystem::CreateDebrisActor(UGeometryCollection* Collection)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.ObjectFlags |= RF_Transient;
+
+	AGeometryCollectionActor* DebrisActor = GetWorld()->SpawnActor<AGeometryCollectionActor>(AGeometryCollectionActor::StaticClass(), FTransform::Identity, SpawnParams);
+
+	if (!DebrisActor)
+	{
+		return nullptr;
+	}
+
+	UGeometryCollectionComponent* GeometryComponent = DebrisActor->GetGeometryCollectionComponent();
+
+	// assign the fractured asset
+	GeometryComponent->SetRestCollection(Collection);
+
+	// debris is purely cosmetic, so pawns and the camera shouldn't collide with it
+	GeometryComponent->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+	GeometryComponent->SetCollisionResponseToChannel(ECC_Camera, ECR_Ignore);
+	GeometryComponent->SetCanEverAffectNavigation(false);
+
+	// start inactive
+	DeactivateDebrisActor(DebrisActor);
+
+	++Pools.FindOrAdd(Collection).NumCreated;
+
+	return DebrisActor;
+}
+
+void UCombatDebrisSubsystem::ReleaseDebris(int32 ActiveIndex)
+{
+	// remove the debris from the active list, preserving the age order
+	const FCombatActiveDebris Debris = ActiveDebris[ActiveIndex];
+	ActiveDebris.RemoveAt(ActiveIndex, EAllowShrinking::No);
+
+	DEC_DWORD_STAT(STAT_CombatActiveDebris);
+
+	if (!IsValid(Debris.Actor))
+	{
+		// the actor was destroyed externally, so forget about it
+		if (FCombatDebrisPool* Pool = Pools.Find(Debris.Collection))
+		{
+			--Pool->NumCreated;
+		}
+
+		return;
+	}
+
+	// deactivate and return the actor to its pool
+	DeactivateDebrisActor(Debris.Actor);
+
+	Pools.FindOrAdd(Debris.Collection).FreeActors.Add(Debris.Actor);
+}
+
+void UCombatDebrisSubsystem::DeactivateDebrisActor(AGeometryCollectionActor* DebrisActor)
+{
+	UGeometryCollectionComponent* GeometryComponent = DebrisActor->GetGeometryCollectionComponent();
+
+	// stop simulating and hide the debris so inactive actors cost nothing
+	GeometryComponent->SetSimulatePhysics(false);
+	DebrisActor->SetActorEnableCollision(false);
+	DebrisActor->SetActorHiddenInGame(true);
+}
+
+void UCombatDebrisSubsystem::TickDebris(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatDebrisTick);
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	for (int32 i = ActiveDebris.Num() - 1; i >= 0; --i)
+	{
+		FCombatActiveDebris& Debris = ActiveDebris[i];
+
+		// has the debris expired?
+		if (CurrentTime >= Debris.ExpireTime || !IsValid(Debris.Actor))
+		{
+			ReleaseDebris(i);
+			continue;
+		}
+
+		if (Debris.bFrozen)
+		{
+			continue;
+		}
+
+		// the pieces are moving as long as their combined bounds are. Sample every tick so there's a fresh reading at the freeze time
+		UGeometryCollectionComponent* GeometryComponent = Debris.Actor->GetGeometryCollectionComponent();
+
+		const FBoxSphereBounds& Bounds = GeometryComponent->Bounds;
+		const double Elapsed = CurrentTime - Debris.LastBoundsTime;
+		const double Moved = FVector::Dist(Bounds.Origin, Debris.LastBounds.Origin) + FVector::Dist(Bounds.BoxExtent, Debris.LastBounds.BoxExtent);
+
+		Debris.LastBounds = Bounds;
+		Debris.LastBoundsTime = CurrentTime;
+
+		// put the debris to rest once it's had time to scatter and has settled. Freezing earlier would leave pieces hanging in the air
+		if (CurrentTime >= Debris.FreezeTime && Elapsed > 0.0 && Moved <= CVarCombatDebrisRestSpeed.GetValueOnGameThread() * Elapsed)
+		{
+			Debris.bFrozen = true;
+			GeometryComponent->SetSimulatePhysics(false);
+		}
+	}
+
+	// stop ticking once there's no more active debris
+	if (ActiveDebris.IsEmpty())
+	{
+		SetTickEnabled(false);
+	}
+}
+
+void UCombatDebrisSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// debris timing doesn't need to be exact, so only check a few times per second, and only while there's debris out
+	SetupTick(&UCombatDebrisSubsystem::TickDebris, TG_PostUpdateWork, TEXT("CombatDebrisSubsystem::TickDebris"), 0.25f, false);
+}
+
+void UCombatDebrisSubsystem::Deinitialize()
+{
+	SET_DWORD_STAT(STAT_CombatActiveDebris, 0);
+
+	// the world owns the debris actors, so we only need to drop our references
+	ActiveDebris.Empty();
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
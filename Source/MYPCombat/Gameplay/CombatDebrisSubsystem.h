@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "CombatDebrisSubsystem.generated.h"
+
+class AGeometryCollectionActor;
+class UGeometryCollection;
+
+/**
+ *  Pool of inactive debris actors for a single geometry collection asset
+ */
+USTRUCT()
+struct FCombatDebrisPool
+{
+	GENERATED_BODY()
+
+	/** Inactive debris actors ready to be reused */
+	UPROPERTY()
+	TArray<TObjectPtr<AGeometryCollectionActor>> FreeActors;
+
+	/** Total number of debris actors created for this asset */
+	int32 NumCreated = 0;
+};
+
+/**
+ *  A single piece of active debris in the level
+ */
+USTRUCT()
+struct FCombatActiveDebris
+{
+	GENERATED_BODY()
+
+	/** Debris actor */
+	UPROPERTY()
+	TObjectPtr<AGeometryCollectionActor> Actor;
+
+	/** Geometry collection asset the actor was drawn from */
+	UPROPERTY()
+	TObjectPtr<UGeometryCollection> Collection;
+
+	/** World time after which the debris stops simulating, as soon as it has come to rest */
+	double FreezeTime = 0.0;
+
+	/** Bounds of the debris the last time it was checked, used to tell whether it's still moving */
+	FBoxSphereBounds LastBounds;
+
+	/** World time the bounds were last checked */
+	double LastBoundsTime = 0.0;
+
+	/** World time at which the debris is returned to the pool */
+	double ExpireTime = 0.0;
+
+	/** If true, the debris has already stopped simulating */
+	bool bFrozen = false;
+};
+
+/**
+ *  Spawns pre-fractured Geometry Collection debris from per-asset pools.
+ *  Debris stops simulating once it has scattered and settled, is returned to its pool after its lifetime,
+ *  and the oldest debris is recycled when the active cap is reached.
+ *  This keeps the physics cost of destruction bounded regardless of how many breakables are in the level.
+ */
+UCLASS()
+class UCombatDebrisSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Inactive debris pools, keyed by geometry collection asset */
+	UPROPERTY()
+	TMap<TObjectPtr<UGeometryCollection>, FCombatDebrisPool> Pools;
+
+	/** Active debris, oldest first */
+	UPROPERTY()
+	TArray<FCombatActiveDebris> ActiveDebris;
+
+public:
+
+	/**
+	 *  Spawns debris for the given geometry collection at the provided transform.
+	 *  @param Collection	Pre-fractured geometry collection asset
+	 *  @param Transform	World transform of the debris
+	 *  @param Impulse		Velocity change to apply to the debris
+	 *  @param FreezeDelay	Minimum time the debris simulates before it's put to rest. Pieces still moving keep simulating until they settle
+	 */
+	void SpawnDebris(UGeometryCollection* Collection, const FTransform& Transform, const FVector& Impulse, float FreezeDelay);
+
+	/** Creates inactive debris actors for the given collection so they don't have to be spawned during gameplay */
+	void PrewarmDebris(UGeometryCollection* Collection, int32 Count);
+
+	/** Returns the number of debris actors currently active */
+	int32 GetNumActiveDebris() const { return ActiveDebris.Num(); }
+
+protected:
+
+	/** Gets a debris actor for the collection, either from the pool or by spawning a new one */
+	AGeometryCollectionActor* AcquireDebrisActor(UGeometryCollection* Collection);
+
+	/** Spawns a new, inactive debris actor for the collection */
+	AGeometryCollectionActor* CreateDebrisActor(UGeometryCollection* Collection);
+
+	/** Deactivates the active debris at the given index and returns it to its pool */
+	void ReleaseDebris(int32 ActiveIndex);
+
+	/** Disables rendering, collision and physics on a debris actor */
+	static void DeactivateDebrisActor(AGeometryCollectionActor* DebrisActor);
+
+	/** Freezes and expires active debris */
+	void TickDebris(float DeltaTime);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Sets up the debris tick */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Drops the debris pools */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
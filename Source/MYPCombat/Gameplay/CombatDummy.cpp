@@ -0,0 +1,203 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatDummy.h"
+#include "Components/SceneComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "PhysicsEngine/PhysicsConstraintComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "MYPTimerSubsystem.h"
+#include "CombatPhysicsSleepSubsystem.h"
+#include "CombatCollisionChannels.h"
+#include "CombatFeedbackProfile.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "MYPTickAudit.h"
+#include "MYP.h"
+
+MYP_AUDIT_TICK(ACombatDummy);
+
+ACombatDummy::ACombatDummy()
+{
+	// dummies are driven entirely by physics and damage events, so they don't need to tick
+ 	PrimaryActorTick.bCanEverTick = false;
+
+	// replicate hits, but keep the dummy dormant between them. The physics body isn't replicated, each machine simulates its own
+	bReplicates = true;
+	NetDormancy = DORM_Initial;
+
+	// create the root
+	Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	SetRootComponent(Root);
+
+	// create the base plate
+	BasePlate = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Base Plate"));
+	BasePlate->SetupAttachment(RootComponent);
+
+	// create the dummy
+	Dummy = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Dummy"));
+	Dummy->SetupAttachment(RootComponent);
+
+	Dummy->SetSimulatePhysics(true);
+
+	// use the prop channel so player melee sweeps can find the dummy
+	Dummy->SetCollisionObjectType(ECC_CombatProp);
+
+	// start asleep so idle dummies don't keep their constraint in the solver
+	Dummy->BodyInstance.bStartAwake = false;
+
+	// create the physics constraint
+	PhysicsConstraint = CreateDefaultSubobject<UPhysicsConstraintComponent>(TEXT("Physics Constraint"));
+	PhysicsConstraint->SetupAttachment(RootComponent);
+
+	PhysicsConstraint->SetConstrainedComponents(BasePlate, NAME_None, Dummy, NAME_None);
+}
+
+void ACombatDummy::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// track the dummy's body in the level-wide sleep report
+	if (UCombatPhysicsSleepSubsystem* SleepSubsystem = GetWorld()->GetSubsystem<UCombatPhysicsSleepSubsystem>())
+	{
+		SleepSubsystem->RegisterBody(Dummy);
+	}
+
+	// in case the dummy was placed awake, let it settle and go to sleep
+	if (Dummy->RigidBodyIsAwake())
+	{
+		StartSettleCheck();
+	}
+}
+
+void ACombatDummy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// stop tracking the dummy's body
+	if (UCombatPhysicsSleepSubsystem* SleepSubsystem = GetWorld()->GetSubsystem<UCombatPhysicsSleepSubsystem>())
+	{
+		SleepSubsystem->UnregisterBody(Dummy);
+	}
+}
+
+void ACombatDummy::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ACombatDummy, LastHit, Params);
+}
+
+void ACombatDummy::StartSettleCheck()
+{
+	// reset the settled check counter
+	SettledChecks = 0;
+
+	// start the settle check timer if it's not already running
+	UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this);
+
+	if (Timers && !Timers->IsTimerActive(SettleTimer))
+	{
+		Timers->SetTimer(SettleTimer, this, &ACombatDummy::CheckSettled, SettleCheckInterval, true);
+	}
+}
+
+void ACombatDummy::CheckSettled()
+{
+	// is the dummy still moving?
+	const bool bSettled = Dummy->GetPhysicsLinearVelocity().SizeSquared() < FMath::Square(SettleLinearSpeed)
+		&& Dummy->GetPhysicsAngularVelocityInDegrees().SizeSquared() < FMath::Square(SettleAngularSpeed);
+
+	if (!bSettled)
+	{
+		SettledChecks = 0;
+		return;
+	}
+
+	// has the dummy stayed still long enough?
+	if (++SettledChecks >= SettleChecksToSleep)
+	{
+		// put the body to sleep. With the base plate static, this also takes the constraint out of the solver
+		Dummy->PutAllRigidBodiesToSleep();
+
+		// stop checking until we're hit again
+		if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+		{
+			Timers->ClearTimer(SettleTimer);
+		}
+	}
+}
+
+void ACombatDummy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
+{
+	PlayHit(DamageLocation, DamageImpulse);
+
+	// pass the hit on to clients
+	if (HasAuthority())
+	{
+		LastHit.Location = DamageLocation;
+		LastHit.Impulse = DamageImpulse;
+		++LastHit.Count;
+
+		const AGameStateBase* GameState = GetWorld()->GetGameState();
+		LastHit.ServerTime = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+
+		MARK_PROPERTY_DIRTY_FROM_NAME(ACombatDummy, LastHit, this);
+		FlushNetDormancy();
+	}
+}
+
+void ACombatDummy::PlayHit(const FVector& DamageLocation, const FVector& DamageImpulse)
+{
+	// wake the dummy up so it reacts to the hit
+	Dummy->WakeAllRigidBodies();
+
+	// apply impulse to the dummy
+	Dummy->AddImpulseAtLocation(DamageImpulse, DamageLocation);
+
+	// put the dummy back to sleep once it settles
+	StartSettleCheck();
+
+	// play the hit effects
+	const FVector DamageDirection = DamageImpulse.GetSafeNormal();
+
+	if (FeedbackProfile)
+	{
+		FeedbackProfile->HitReceived.Play(this, DamageLocation, DamageDirection.Rotation());
+	}
+
+	// call the BP handler only if it's been opted into, or there's nothing else to play
+	if (bUseBlueprintFeedback || !FeedbackProfile)
+	{
+		MYP_COUNT_BLUEPRINT_EVENT();
+		BP_OnDummyDamaged(DamageLocation, DamageDirection);
+	}
+}
+
+void ACombatDummy::OnRep_LastHit()
+{
+	// a client joining after the hit gets it with the rest of the dummy's state, so only play hits that just happened.
+	// Without a game state the client is still joining, so the hit can't be a new one
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+
+	if (!GameState || GameState->GetServerWorldTimeSeconds() - LastHit.ServerTime > MaxHitReplayAge)
+	{
+		return;
+	}
+
+	PlayHit(LastHit.Location, LastHit.Impulse);
+}
+
+void ACombatDummy::HandleDeath()
+{
+	// unused
+}
+
+void ACombatDummy::ApplyHealing(float Healing, AActor* Healer)
+{
+	// unused
+}
\ No newline at end of file
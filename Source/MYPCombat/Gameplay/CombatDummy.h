@@ -0,0 +1,150 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "CombatDamageable.h"
+#include "MYPTimerSubsystem.h"
+#include "CombatDummy.generated.h"
+
+class UStaticMeshComponent;
+class UPhysicsConstraintComponent;
+class UCombatFeedbackProfile;
+
+/**
+ *  A hit taken by a combat dummy, replicated so clients can play the reaction
+ */
+USTRUCT()
+struct FCombatDummyHit
+{
+	GENERATED_BODY()
+
+	/** World location of the hit */
+	UPROPERTY()
+	FVector_NetQuantize Location = FVector::ZeroVector;
+
+	/** Impulse applied to the dummy */
+	UPROPERTY()
+	FVector_NetQuantize10 Impulse = FVector::ZeroVector;
+
+	/** Incremented on every hit, so two identical hits in a row still replicate */
+	UPROPERTY()
+	uint8 Count = 0;
+
+	/** Server world time the hit was taken at */
+	UPROPERTY()
+	float ServerTime = 0.0f;
+};
+
+/**
+ *  A simple invincible combat training dummy
+ *  The dummy stays net dormant while nothing hits it. Hits are pushed to clients as they happen
+ */
+UCLASS(abstract)
+class ACombatDummy : public AActor, public ICombatDamageable
+{
+	GENERATED_BODY()
+	
+	/** Root component */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
+	USceneComponent* Root;
+
+	/** Static base plate */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
+	UStaticMeshComponent* BasePlate;
+
+	/** Physics enabled dummy mesh */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
+	UStaticMeshComponent* Dummy;
+
+	/** Physics constraint holding the dummy and base plate together */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
+	UPhysicsConstraintComponent* PhysicsConstraint;
+
+protected:
+
+	/** Linear speed below which the dummy is considered settled */
+	UPROPERTY(EditAnywhere, Category="Physics", meta = (ClampMin = 0, ClampMax = 100, Units = "cm/s"))
+	float SettleLinearSpeed = 5.0f;
+
+	/** Angular speed below which the dummy is considered settled */
+	UPROPERTY(EditAnywhere, Category="Physics", meta = (ClampMin = 0, ClampMax = 90, Units = "deg/s"))
+	float SettleAngularSpeed = 5.0f;
+
+	/** Time between settle checks while the dummy is awake */
+	UPROPERTY(EditAnywhere, Category="Physics", meta = (ClampMin = 0.05, ClampMax = 2, Units = "s"))
+	float SettleCheckInterval = 0.25f;
+
+	/** Number of consecutive settled checks required before the dummy is put to sleep */
+	UPROPERTY(EditAnywhere, Category="Physics", meta = (ClampMin = 1, ClampMax = 20))
+	int32 SettleChecksToSleep = 4;
+
+	/** Number of consecutive settled checks so far */
+	int32 SettledChecks = 0;
+
+	/** Timer that checks whether the dummy has settled */
+	FMYPTimerHandle SettleTimer;
+
+	/** Last hit taken on the server */
+	UPROPERTY(ReplicatedUsing=OnRep_LastHit)
+	FCombatDummyHit LastHit;
+
+	/** Hits older than this when they reach a client aren't played. Keeps clients that join late from replaying the last hit */
+	UPROPERTY(EditAnywhere, Category="Feedback", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
+	float MaxHitReplayAge = 0.5f;
+
+	/** Hit effects played natively */
+	UPROPERTY(EditAnywhere, Category="Feedback")
+	TObjectPtr<UCombatFeedbackProfile> FeedbackProfile;
+
+	/** If true, the On Dummy Damaged Blueprint event is called on top of the feedback profile. It's always called if there's no profile */
+	UPROPERTY(EditAnywhere, Category="Feedback")
+	bool bUseBlueprintFeedback = false;
+
+public:	
+	
+	/** Constructor */
+	ACombatDummy();
+
+	// ~Begin CombatDamageable interface
+
+		/** Handles damage and knockback events */
+	virtual void ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse) override;
+
+	/** Handles death events */
+	virtual void HandleDeath() override;
+
+	/** Handles healing events */
+	virtual void ApplyHealing(float Healing, AActor* Healer) override;
+
+	// ~End CombatDamageable interface
+
+protected:
+
+	/** Initialization */
+	virtual void BeginPlay() override;
+
+	/** Cleanup */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Registers the replicated hit */
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Knocks the dummy around and plays the hit effects */
+	void PlayHit(const FVector& DamageLocation, const FVector& DamageImpulse);
+
+	/** Replays a recent hit taken on the server */
+	UFUNCTION()
+	void OnRep_LastHit();
+
+	/** Starts checking whether the dummy has settled so it can be put to sleep */
+	void StartSettleCheck();
+
+	/** Puts the dummy to sleep once it has stayed still long enough */
+	void CheckSettled();
+
+	/** Blueprint handle to apply damage effects */
+	UFUNCTION(BlueprintImplementableEvent, Category="Combat", meta = (DisplayName = "On Dummy Damaged"))
+	void BP_OnDummyDamaged(const FVector& Location, const FVector& Direction);
+};
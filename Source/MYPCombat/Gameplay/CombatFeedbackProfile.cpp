@@ -1,4 +1,4 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 
-#include "CombatActivatable.h"
\ No newline at end of file
+#include "CombatFeedbackProfile.h"
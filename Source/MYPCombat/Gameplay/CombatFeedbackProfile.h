@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "MYPFeedbackEffect.h"
+#include "CombatFeedbackProfile.generated.h"
+
+/**
+ *  Hit and destruction feedback for a combat actor.
+ *  Played natively on every hit, so actors only need Blueprint damage events for behavior the profile can't express.
+ */
+UCLASS(BlueprintType)
+class UCombatFeedbackProfile : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Played at the impact point when the owner lands a hit */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Feedback")
+	FMYPFeedbackEffect HitDealt;
+
+	/** Played at the impact point when the owner is hit, facing along the hit direction */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Feedback")
+	FMYPFeedbackEffect HitReceived;
+
+	/** Played at the owner's location when it's destroyed or dies */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Feedback")
+	FMYPFeedbackEffect Destroyed;
+};
@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatHazardZoneComponent.h"
+#include "GameFramework/Actor.h"
+#include "CombatDamageable.h"
+#include "CombatDamageSubsystem.h"
+#include "CombatCollisionChannels.h"
+#include "MYPTickAudit.h"
+
+MYP_AUDIT_TICK(UCombatHazardZoneComponent);
+
+UCombatHazardZoneComponent::UCombatHazardZoneComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	// only overlap characters and damageable props. Membership changes on enter and exit only, never per contact
+	SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	SetCollisionObjectType(ECC_WorldDynamic);
+	SetCollisionResponseToAllChannels(ECR_Ignore);
+	SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
+	SetCollisionResponseToChannel(ECC_CombatProp, ECR_Overlap);
+	SetGenerateOverlapEvents(true);
+
+	// keep the zone out of navigation and character movement
+	SetCanEverAffectNavigation(false);
+	CanCharacterStepUpOn = ECB_No;
+}
+
+void UCombatHazardZoneComponent::SetDamage(float NewDamage, float NewDamageInterval)
+{
+	Damage = FMath::Max(0.0f, NewDamage);
+	DamageInterval = FMath::Max(0.05f, NewDamageInterval);
+}
+
+void UCombatHazardZoneComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	OnComponentBeginOverlap.AddUniqueDynamic(this, &UCombatHazardZoneComponent::OnZoneBeginOverlap);
+	OnComponentEndOverlap.AddUniqueDynamic(this, &UCombatHazardZoneComponent::OnZoneEndOverlap);
+}
+
+void UCombatHazardZoneComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// stop all damage timers
+	if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+	{
+		for (TPair<TWeakObjectPtr<AActor>, FHazardMember>& Member : Members)
+		{
+			Timers->ClearTimer(Member.Value.DamageTimer);
+		}
+	}
+
+	Members.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UCombatHazardZoneComponent::OnZoneBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	// only damageable actors can join
+	if (!Cast<ICombatDamageable>(OtherActor))
+	{
+		return;
+	}
+
+	FHazardMember& Member = Members.FindOrAdd(OtherActor);
+
+	// already inside through another component?
+	if (Member.NumOverlaps++ > 0)
+	{
+		return;
+	}
+
+	// start the member's damage timer. Timers are owned by our actor, so they stop with it
+	if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+	{
+		Member.DamageTimer = Timers->SetTimer(GetOwner(), DamageInterval, FSimpleDelegate::CreateUObject(this, &UCombatHazardZoneComponent::DamageMember, TWeakObjectPtr<AActor>(OtherActor)), true);
+	}
+
+	if (bDamageOnEnter)
+	{
+		DamageMember(OtherActor);
+	}
+}
+
+void UCombatHazardZoneComponent::OnZoneEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	FHazardMember* Member = Members.Find(OtherActor);
+
+	if (!Member || --Member->NumOverlaps > 0)
+	{
+		return;
+	}
+
+	// the actor has fully left the zone
+	if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+	{
+		Timers->ClearTimer(Member->DamageTimer);
+	}
+
+	Members.Remove(OtherActor);
+}
+
+void UCombatHazardZoneComponent::DamageMember(TWeakObjectPtr<AActor> Member)
+{
+	AActor* MemberActor = Member.Get();
+
+	// the member was destroyed without leaving the zone
+	if (!MemberActor)
+	{
+		if (FHazardMember* StaleMember = Members.Find(Member))
+		{
+			if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+			{
+				Timers->ClearTimer(StaleMember->DamageTimer);
+			}
+
+			Members.Remove(Member);
+		}
+
+		return;
+	}
+
+	// queue the damage so it resolves with the rest of the frame's hits
+	FCombatDamageEvent DamageEvent;
+	DamageEvent.Target = MemberActor;
+	DamageEvent.DamageCauser = GetOwner();
+	DamageEvent.Damage = Damage;
+	DamageEvent.DamageLocation = MemberActor->GetActorLocation();
+	DamageEvent.DamageImpulse = FVector::ZeroVector;
+
+	UCombatDamageSubsystem::QueueDamage(this, DamageEvent);
+}
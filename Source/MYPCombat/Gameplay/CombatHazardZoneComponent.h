@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/BoxComponent.h"
+#include "MYPTimerSubsystem.h"
+#include "CombatHazardZoneComponent.generated.h"
+
+/**
+ *  A damage-over-time zone.
+ *  Damageable actors join the zone when they start overlapping it and leave when they stop, and each member is
+ *  damaged on its own looping timer while inside. Damage doesn't depend on how often physics reports contacts.
+ *  The box only overlaps pawns and damageable props, so ragdolls and other simulating bodies never reach it.
+ */
+UCLASS(ClassGroup="Combat", meta=(BlueprintSpawnableComponent))
+class UCombatHazardZoneComponent : public UBoxComponent
+{
+	GENERATED_BODY()
+
+	/** An actor inside the zone */
+	struct FHazardMember
+	{
+		/** Number of the actor's components overlapping the zone */
+		int32 NumOverlaps = 0;
+
+		/** Looping damage timer */
+		FMYPTimerHandle DamageTimer;
+	};
+
+	/** Actors inside the zone */
+	TMap<TWeakObjectPtr<AActor>, FHazardMember> Members;
+
+protected:
+
+	/** Damage dealt to each member every interval */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Hazard", meta = (ClampMin = 0))
+	float Damage = 10.0f;
+
+	/** Time between damage applications for each member */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Hazard", meta = (ClampMin = 0.05, Units = "s"))
+	float DamageInterval = 0.5f;
+
+	/** If true, members are damaged as soon as they enter. Otherwise the first damage comes after one interval */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Hazard")
+	bool bDamageOnEnter = true;
+
+public:
+
+	/** Constructor */
+	UCombatHazardZoneComponent();
+
+	/** Sets the damage dealt to each member and the time between applications. Applies to new members */
+	void SetDamage(float NewDamage, float NewDamageInterval);
+
+	/** Returns the number of actors inside the zone */
+	int32 GetNumMembers() const { return Members.Num(); }
+
+protected:
+
+	/** Binds the overlap handlers */
+	virtual void BeginPlay() override;
+
+	/** Stops damaging all members */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Adds a damageable actor to the zone */
+	UFUNCTION()
+	void OnZoneBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	/** Removes an actor from the zone once none of its components overlap it */
+	UFUNCTION()
+	void OnZoneEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
+	/** Damages a member. Called by its damage timer */
+	void DamageMember(TWeakObjectPtr<AActor> Member);
+};
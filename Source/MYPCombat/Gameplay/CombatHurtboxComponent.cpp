@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatHurtboxComponent.h"
+#include "GameFramework/Character.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "CombatDamageable.h"
+#include "CombatCollisionChannels.h"
+#include "CombatHurtboxSubsystem.h"
+#include "MYPTickAudit.h"
+
+MYP_AUDIT_TICK(UCombatHurtboxComponent);
+
+UCombatHurtboxComponent::UCombatHurtboxComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	// hurtboxes only answer queries, and nothing responds to them
+	SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	SetCollisionResponseToAllChannels(ECR_Ignore);
+	SetGenerateOverlapEvents(false);
+
+	// keep the hurtbox out of navigation and character movement
+	SetCanEverAffectNavigation(false);
+	CanCharacterStepUpOn = ECB_No;
+}
+
+void UCombatHurtboxComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	// use the channel for the owner's faction
+	if (const ICombatDamageable* Damageable = Cast<ICombatDamageable>(GetOwner()))
+	{
+		Faction = Damageable->GetCombatFaction();
+		SetCollisionObjectType(GetCombatFactionObjectType(Faction));
+	}
+
+	// cover the same volume as the owner's collision capsule
+	if (const ACharacter* OwningCharacter = Cast<ACharacter>(GetOwner()))
+	{
+		if (const UCapsuleComponent* OwnerCapsule = OwningCharacter->GetCapsuleComponent())
+		{
+			SetCapsuleSize(OwnerCapsule->GetUnscaledCapsuleRadius(), OwnerCapsule->GetUnscaledCapsuleHalfHeight(), false);
+		}
+	}
+}
+
+void UCombatHurtboxComponent::GatherCapsules(TArray<FCombatHurtboxCapsule>& OutCapsules, int32 OwnerIndex) const
+{
+	const ACharacter* OwningCharacter = Cast<ACharacter>(GetOwner());
+	const USkeletalMeshComponent* Mesh = OwningCharacter ? OwningCharacter->GetMesh() : nullptr;
+
+	// without bone hurtboxes, publish our own capsule
+	if (BoneHurtboxes.IsEmpty() || !Mesh)
+	{
+		const FVector AxisOffset = GetUpVector() * (GetScaledCapsuleHalfHeight() - GetScaledCapsuleRadius());
+
+		FCombatHurtboxCapsule& Capsule = OutCapsules.AddDefaulted_GetRef();
+		Capsule.Start = FVector3f(GetComponentLocation() - AxisOffset);
+		Capsule.End = FVector3f(GetComponentLocation() + AxisOffset);
+		Capsule.Radius = GetScaledCapsuleRadius();
+		Capsule.Zone = FName("Body");
+		Capsule.OwnerIndex = OwnerIndex;
+		Capsule.Faction = Faction;
+		return;
+	}
+
+	// read the bone locations from the current pose
+	for (const FCombatBoneHurtbox& BoneHurtbox : BoneHurtboxes)
+	{
+		const FVector Start = Mesh->GetSocketLocation(BoneHurtbox.StartBone);
+
+		FCombatHurtboxCapsule& Capsule = OutCapsules.AddDefaulted_GetRef();
+		Capsule.Start = FVector3f(Start);
+		Capsule.End = FVector3f(BoneHurtbox.EndBone.IsNone() ? Start : Mesh->GetSocketLocation(BoneHurtbox.EndBone));
+		Capsule.Radius = BoneHurtbox.Radius;
+		Capsule.DamageMultiplier = BoneHurtbox.DamageMultiplier;
+		Capsule.Zone = BoneHurtbox.Zone;
+		Capsule.OwnerIndex = OwnerIndex;
+		Capsule.Faction = Faction;
+	}
+}
+
+void UCombatHurtboxComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UCombatHurtboxSubsystem* HurtboxSubsystem = GetWorld()->GetSubsystem<UCombatHurtboxSubsystem>())
+	{
+		HurtboxSubsystem->RegisterHurtbox(this);
+	}
+}
+
+void UCombatHurtboxComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	if (UCombatHurtboxSubsystem* HurtboxSubsystem = GetWorld()->GetSubsystem<UCombatHurtboxSubsystem>())
+	{
+		HurtboxSubsystem->UnregisterHurtbox(this);
+	}
+}
@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/CapsuleComponent.h"
+#include "CombatDamageable.h"
+#include "CombatHurtboxComponent.generated.h"
+
+struct FCombatHurtboxCapsule;
+
+/**
+ *  A capsule between two bones of the owner's mesh, used to resolve melee hits per body part
+ */
+USTRUCT(BlueprintType)
+struct FCombatBoneHurtbox
+{
+	GENERATED_BODY()
+
+	/** Bone or socket at the start of the capsule */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Hurtbox")
+	FName StartBone;
+
+	/** Bone or socket at the end of the capsule. If none, the capsule is a sphere around the start bone */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Hurtbox")
+	FName EndBone;
+
+	/** Capsule radius */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Hurtbox", meta = (ClampMin = 1, Units = "cm"))
+	float Radius = 15.0f;
+
+	/** Damage zone reported for hits on this capsule */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Hurtbox")
+	FName Zone = FName("Body");
+
+	/** Damage multiplier for hits on this capsule */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Hurtbox", meta = (ClampMin = 0))
+	float DamageMultiplier = 1.0f;
+};
+
+/**
+ *  Query-only capsule that makes a character visible to melee sweeps.
+ *  Its object channel comes from the owner's combat faction, and it ignores every channel so it never blocks
+ *  movement, cameras or visibility traces.
+ *  Sized to the owner's collision capsule when registered.
+ *  Also publishes the owner's bone hurtboxes to the hurtbox subsystem each frame. Without any bone hurtboxes,
+ *  the component's own capsule is published instead.
+ */
+UCLASS(ClassGroup="Combat", meta=(BlueprintSpawnableComponent))
+class UCombatHurtboxComponent : public UCapsuleComponent
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Capsules attached to the owner's mesh bones */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Hurtbox")
+	TArray<FCombatBoneHurtbox> BoneHurtboxes;
+
+	/** Faction of the owner, cached on register */
+	ECombatFaction Faction = ECombatFaction::Prop;
+
+public:
+
+	/** Constructor */
+	UCombatHurtboxComponent();
+
+	/** Returns the owner's faction */
+	ECombatFaction GetFaction() const { return Faction; }
+
+	/** Adds this frame's world space hurtbox capsules to the list */
+	void GatherCapsules(TArray<FCombatHurtboxCapsule>& OutCapsules, int32 OwnerIndex) const;
+
+protected:
+
+	/** Picks the object channel for the owner's faction and matches the owner's capsule */
+	virtual void OnRegister() override;
+
+	/** Registers with the hurtbox subsystem */
+	virtual void BeginPlay() override;
+
+	/** Unregisters from the hurtbox subsystem */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+};
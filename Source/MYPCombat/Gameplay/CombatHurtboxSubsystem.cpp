@@ -0,0 +1,334 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatHurtboxSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Async/ParallelFor.h"
+#include "DrawDebugHelpers.h"
+#include "HAL/IConsoleManager.h"
+#include "CombatHurtboxComponent.h"
+#include "CombatDamageSubsystem.h"
+#include "CombatAttacker.h"
+#include "MYPFrameArena.h"
+#include "MYPAllocScope.h"
+#include "MYP.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Hurtbox Rebuild"), STAT_CombatHurtboxRebuild, STATGROUP_MYP);
+DECLARE_CYCLE_STAT(TEXT("Combat Hurtbox Queries"), STAT_CombatHurtboxQueries, STATGROUP_MYP);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Hurtbox Capsules"), STAT_CombatHurtboxCapsules, STATGROUP_MYP);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Melee Queries"), STAT_CombatMeleeQueries, STATGROUP_MYP);
+
+static TAutoConsoleVariable<bool> CVarCombatHurtboxDebug(
+	TEXT("Combat.Hurtbox.Debug"),
+	false,
+	TEXT("If true, draws the hurtbox capsules published each frame."),
+	ECVF_Cheat);
+
+static TAutoConsoleVariable<int32> CVarCombatHurtboxMinParallelQueries(
+	TEXT("Combat.Hurtbox.MinParallelQueries"),
+	4,
+	TEXT("Minimum number of queued melee queries before they're spread over worker threads."),
+	ECVF_Default);
+
+void UCombatHurtboxSubsystem::RegisterHurtbox(UCombatHurtboxComponent* Hurtbox)
+{
+	if (Hurtbox)
+	{
+		Hurtboxes.AddUnique(Hurtbox);
+	}
+}
+
+void UCombatHurtboxSubsystem::UnregisterHurtbox(UCombatHurtboxComponent* Hurtbox)
+{
+	Hurtboxes.RemoveSwap(Hurtbox);
+}
+
+void UCombatHurtboxSubsystem::QueueMeleeQuery(const FCombatMeleeQuery& Query)
+{
+	PendingQueries.Add(Query);
+}
+
+void UCombatHurtboxSubsystem::RunQuery(const FCombatMeleeQuery& Query, const AActor* AttackerKey, TArray<FCombatMeleeHit>& OutHits) const
+{
+	OutHits.Reset();
+
+	if (Nodes.IsEmpty())
+	{
+		return;
+	}
+
+	const FVector3f SweepStart(Query.Start);
+	const FVector3f SweepEnd(Query.End);
+	const FBox3f SweepBounds(SweepStart.ComponentMin(SweepEnd) - FVector3f(Query.Radius), SweepStart.ComponentMax(SweepEnd) + FVector3f(Query.Radius));
+
+	// walk the hierarchy depth first. This runs on workers, so rewind their arena once the walk is done
+	FMYPFrameArenaMark ArenaMark;
+	TArray<int32, TMYPInlineFrameAllocator<32>> Stack;
+	Stack.Add(0);
+
+	while (!Stack.IsEmpty())
+	{
+		const int32 NodeIndex = Stack.Pop(EAllowShrinking::No);
+		const FCombatHurtboxNode& Node = Nodes[NodeIndex];
+
+		if (!Node.Bounds.Intersect(SweepBounds))
+		{
+			continue;
+		}
+
+		// interior node, so visit both children
+		if (Node.Count == 0)
+		{
+			Stack.Add(Node.Index);
+			Stack.Add(NodeIndex + 1);
+			continue;
+		}
+
+		// test the leaf's capsules
+		for (int32 CapsuleIndex = Node.Index; CapsuleIndex < Node.Index + Node.Count; ++CapsuleIndex)
+		{
+			const FCombatHurtboxCapsule& Capsule = Capsules[CapsuleIndex];
+
+			if (Capsule.Faction != Query.TargetFaction || CapsuleOwnerKeys[Capsule.OwnerIndex] == AttackerKey)
+			{
+				continue;
+			}
+
+			// a swept sphere touches a capsule when their axes come within the sum of their radii
+			FVector SweepPoint;
+			FVector CapsulePoint;
+			FMath::SegmentDistToSegmentSafe(Query.Start, Query.End, FVector(Capsule.Start), FVector(Capsule.End), SweepPoint, CapsulePoint);
+
+			const double CombinedRadius = Query.Radius + Capsule.Radius;
+
+			if (FVector::DistSquared(SweepPoint, CapsulePoint) > FMath::Square(CombinedRadius))
+			{
+				continue;
+			}
+
+			FVector Normal = (SweepPoint - CapsulePoint).GetSafeNormal();
+
+			if (Normal.IsZero())
+			{
+				Normal = (Query.Start - Query.End).GetSafeNormal();
+			}
+
+			// keep one hit per actor, on its most vulnerable zone
+			FCombatMeleeHit* Hit = OutHits.FindByPredicate([&Capsule](const FCombatMeleeHit& Existing) { return Existing.OwnerIndex == Capsule.OwnerIndex; });
+
+			if (!Hit)
+			{
+				Hit = &OutHits.AddDefaulted_GetRef();
+				Hit->OwnerIndex = Capsule.OwnerIndex;
+				Hit->DamageMultiplier = -1.0f;
+			}
+
+			if (Capsule.DamageMultiplier > Hit->DamageMultiplier)
+			{
+				Hit->ImpactPoint = CapsulePoint + Normal * Capsule.Radius;
+				Hit->ImpactNormal = Normal;
+				Hit->DamageMultiplier = Capsule.DamageMultiplier;
+				Hit->Zone = Capsule.Zone;
+			}
+		}
+	}
+}
+
+void UCombatHurtboxSubsystem::RebuildHierarchy()
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatHurtboxRebuild);
+
+	Capsules.Reset();
+	CapsuleOwners.Reset();
+	CapsuleOwnerKeys.Reset();
+	Nodes.Reset();
+
+	// gather the capsules of every live hurtbox
+	for (int32 i = Hurtboxes.Num() - 1; i >= 0; --i)
+	{
+		const UCombatHurtboxComponent* Hurtbox = Hurtboxes[i].Get();
+
+		if (!Hurtbox)
+		{
+			Hurtboxes.RemoveAtSwap(i, EAllowShrinking::No);
+			continue;
+		}
+
+		// dead characters disable their hurtbox
+		if (!Hurtbox->IsCollisionEnabled())
+		{
+			continue;
+		}
+
+		const int32 OwnerIndex = CapsuleOwners.Add(Hurtbox->GetOwner());
+		CapsuleOwnerKeys.Add(Hurtbox->GetOwner());
+
+		Hurtbox->GatherCapsules(Capsules, OwnerIndex);
+	}
+
+	SET_DWORD_STAT(STAT_CombatHurtboxCapsules, Capsules.Num());
+
+	if (!Capsules.IsEmpty())
+	{
+		BuildNode(0, Capsules.Num());
+	}
+}
+
+int32 UCombatHurtboxSubsystem::BuildNode(int32 Begin, int32 End)
+{
+	const int32 NodeIndex = Nodes.AddDefaulted();
+
+	// bound the capsules and their centers
+	FBox3f Bounds(ForceInit);
+	FBox3f CenterBounds(ForceInit);
+
+	for (int32 i = Begin; i < End; ++i)
+	{
+		Bounds += Capsules[i].GetBounds();
+		CenterBounds += (Capsules[i].Start + Capsules[i].End) * 0.5f;
+	}
+
+	Nodes[NodeIndex].Bounds = Bounds;
+
+	// small ranges become leaves
+	if (End - Begin <= MaxLeafCapsules)
+	{
+		Nodes[NodeIndex].Index = Begin;
+		Nodes[NodeIndex].Count = End - Begin;
+		return NodeIndex;
+	}
+
+	// split at the median along the longest axis of the centers
+	const FVector3f CenterExtent = CenterBounds.GetSize();
+	const int32 Axis = CenterExtent.X >= CenterExtent.Y ? (CenterExtent.X >= CenterExtent.Z ? 0 : 2) : (CenterExtent.Y >= CenterExtent.Z ? 1 : 2);
+
+	MakeArrayView(Capsules.GetData() + Begin, End - Begin).Sort([Axis](const FCombatHurtboxCapsule& A, const FCombatHurtboxCapsule& B)
+	{
+		return A.Start[Axis] + A.End[Axis] < B.Start[Axis] + B.End[Axis];
+	});
+
+	const int32 Middle = Begin + (End - Begin) / 2;
+
+	// the left child always directly follows its parent
+	BuildNode(Begin, Middle);
+	const int32 RightChild = BuildNode(Middle, End);
+
+	Nodes[NodeIndex].Index = RightChild;
+	Nodes[NodeIndex].Count = 0;
+
+	return NodeIndex;
+}
+
+void UCombatHurtboxSubsystem::ResolveQueries()
+{
+	if (PendingQueries.IsEmpty())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CombatHurtboxQueries);
+	INC_DWORD_STAT_BY(STAT_CombatMeleeQueries, PendingQueries.Num());
+	MYP_ALLOC_SCOPE(CombatHurtboxQueries);
+
+	// take the queue, so hit reactions can queue new queries for the next frame
+	Swap(PendingQueries, ResolvingQueries);
+
+	// resolve the attackers on the game thread, so the workers only compare pointers
+	TArray<const AActor*, TMYPInlineFrameAllocator<16>> AttackerKeys;
+
+	for (const FCombatMeleeQuery& Query : ResolvingQueries)
+	{
+		AttackerKeys.Add(Query.Attacker.Get());
+	}
+
+	if (QueryResults.Num() < ResolvingQueries.Num())
+	{
+		QueryResults.SetNum(ResolvingQueries.Num());
+	}
+
+	// the hierarchy is read only while the queries run
+	const EParallelForFlags ParallelFlags = ResolvingQueries.Num() >= CVarCombatHurtboxMinParallelQueries.GetValueOnGameThread() ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+
+	ParallelFor(ResolvingQueries.Num(), [this, &AttackerKeys](int32 QueryIndex)
+	{
+		MYP_ALLOC_SCOPE(CombatHurtboxQueryWorker);
+		RunQuery(ResolvingQueries[QueryIndex], AttackerKeys[QueryIndex], QueryResults[QueryIndex]);
+	}, ParallelFlags);
+
+	// hand the hits to the damage subsystem
+	for (int32 QueryIndex = 0; QueryIndex < ResolvingQueries.Num(); ++QueryIndex)
+	{
+		const FCombatMeleeQuery& Query = ResolvingQueries[QueryIndex];
+		ICombatAttacker* Attacker = Cast<ICombatAttacker>(Query.Attacker.Get());
+
+		for (const FCombatMeleeHit& Hit : QueryResults[QueryIndex])
+		{
+			AActor* HitActor = CapsuleOwners[Hit.OwnerIndex].Get();
+
+			if (!HitActor)
+			{
+				continue;
+			}
+
+			// knock upwards and away from the impact
+			FCombatDamageEvent DamageEvent;
+			DamageEvent.Target = HitActor;
+			DamageEvent.DamageCauser = Query.Attacker;
+			DamageEvent.Damage = Query.Damage * Hit.DamageMultiplier;
+			DamageEvent.DamageLocation = Hit.ImpactPoint;
+			DamageEvent.DamageImpulse = (Hit.ImpactNormal * -Query.KnockbackImpulse) + (FVector::UpVector * Query.LaunchImpulse);
+
+			UCombatDamageSubsystem::QueueDamage(this, DamageEvent);
+
+			// let the attacker react to the hit
+			if (Attacker)
+			{
+				Attacker->HandleMeleeHit(HitActor, DamageEvent.Damage, Hit.ImpactPoint, Hit.ImpactNormal, Hit.Zone);
+			}
+		}
+	}
+
+	ResolvingQueries.Reset();
+}
+
+void UCombatHurtboxSubsystem::DrawDebugCapsules() const
+{
+	for (const FCombatHurtboxCapsule& Capsule : Capsules)
+	{
+		const FVector Start(Capsule.Start);
+		const FVector End(Capsule.End);
+		const FVector Axis = End - Start;
+		const FQuat Rotation = Axis.IsNearlyZero() ? FQuat::Identity : FRotationMatrix::MakeFromZ(Axis).ToQuat();
+		const FColor Color = Capsule.DamageMultiplier > 1.0f ? FColor::Red : FColor::Green;
+
+		DrawDebugCapsule(GetWorld(), (Start + End) * 0.5f, Axis.Size() * 0.5f + Capsule.Radius, Capsule.Radius, Rotation, Color);
+	}
+}
+
+void UCombatHurtboxSubsystem::TickResolve(float DeltaTime)
+{
+	RebuildHierarchy();
+	ResolveQueries();
+
+	if (CVarCombatHurtboxDebug.GetValueOnGameThread())
+	{
+		DrawDebugCapsules();
+	}
+}
+
+void UCombatHurtboxSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// meshes are posed by now, and the damage flush after physics picks up the hits on the same frame
+	SetupTick(&UCombatHurtboxSubsystem::TickResolve, TG_DuringPhysics, TEXT("CombatHurtboxSubsystem::TickResolve"));
+}
+
+void UCombatHurtboxSubsystem::Deinitialize()
+{
+	Hurtboxes.Empty();
+	PendingQueries.Empty();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,189 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatDamageable.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "CombatHurtboxSubsystem.generated.h"
+
+class UCombatHurtboxComponent;
+
+/**
+ *  A bone-attached hurtbox capsule, in world space, as published for the current frame
+ */
+struct FCombatHurtboxCapsule
+{
+	/** Ends of the capsule's axis */
+	FVector3f Start = FVector3f::ZeroVector;
+	FVector3f End = FVector3f::ZeroVector;
+
+	/** Capsule radius */
+	float Radius = 0.0f;
+
+	/** Damage multiplier for hits on this capsule */
+	float DamageMultiplier = 1.0f;
+
+	/** Name of the damage zone this capsule belongs to */
+	FName Zone;
+
+	/** Index of the owning actor in the frame's owner list */
+	int32 OwnerIndex = INDEX_NONE;
+
+	/** Faction of the owning actor */
+	ECombatFaction Faction = ECombatFaction::Prop;
+
+	/** Returns the capsule's bounding box */
+	FBox3f GetBounds() const
+	{
+		return FBox3f(Start.ComponentMin(End) - FVector3f(Radius), Start.ComponentMax(End) + FVector3f(Radius));
+	}
+};
+
+/**
+ *  Node of the flat hurtbox bounding volume hierarchy.
+ *  Leaves point to a range of capsules. Interior nodes are followed by their left child, and point to their right child
+ */
+struct FCombatHurtboxNode
+{
+	/** Bounds of everything under the node */
+	FBox3f Bounds = FBox3f(ForceInit);
+
+	/** First capsule for leaves, or right child index for interior nodes */
+	int32 Index = 0;
+
+	/** Number of capsules for leaves, or zero for interior nodes */
+	int32 Count = 0;
+};
+
+/**
+ *  A swept sphere melee query, and the damage it deals to whatever it hits
+ */
+struct FCombatMeleeQuery
+{
+	/** Actor making the attack. Its own hurtboxes are never hit */
+	TWeakObjectPtr<AActor> Attacker;
+
+	/** Only hurtboxes of this faction can be hit */
+	ECombatFaction TargetFaction = ECombatFaction::Enemy;
+
+	/** Sweep start and end */
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+
+	/** Sweep sphere radius */
+	float Radius = 0.0f;
+
+	/** Damage before zone multipliers */
+	float Damage = 0.0f;
+
+	/** Knockback impulse away from the impact */
+	float KnockbackImpulse = 0.0f;
+
+	/** Upwards launch impulse */
+	float LaunchImpulse = 0.0f;
+};
+
+/**
+ *  A melee query hit against one actor. Multiple capsules of the same actor collapse into the hit with the highest multiplier
+ */
+struct FCombatMeleeHit
+{
+	/** Index of the hit actor in the frame's owner list */
+	int32 OwnerIndex = INDEX_NONE;
+
+	/** Point on the hurtbox surface closest to the sweep */
+	FVector ImpactPoint = FVector::ZeroVector;
+
+	/** Direction from the hurtbox towards the sweep */
+	FVector ImpactNormal = FVector::ZeroVector;
+
+	/** Damage multiplier of the hit zone */
+	float DamageMultiplier = 1.0f;
+
+	/** Name of the hit zone */
+	FName Zone;
+};
+
+/**
+ *  Resolves melee attacks against per-bone hurtbox capsules instead of the physics scene.
+ *  - Hurtbox components publish their bone capsules once per frame, after animation has posed the meshes
+ *  - The capsules go into a flat bounding volume hierarchy rebuilt every frame
+ *  - Queued melee queries run against it in parallel on worker threads, during physics, without touching the physics scene
+ *  - Hits are passed to the damage subsystem, scaled by the damage multiplier of the zone that was hit
+ */
+UCLASS()
+class UCombatHurtboxSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Maximum number of capsules in a leaf node */
+	static constexpr int32 MaxLeafCapsules = 4;
+
+	/** Registered hurtbox components */
+	TArray<TWeakObjectPtr<UCombatHurtboxComponent>> Hurtboxes;
+
+	/** Capsules published this frame, reordered by the hierarchy build */
+	TArray<FCombatHurtboxCapsule> Capsules;
+
+	/** Owners of the capsules published this frame */
+	TArray<TWeakObjectPtr<AActor>> CapsuleOwners;
+
+	/** Raw owner pointers, only compared against on worker threads and never dereferenced */
+	TArray<const AActor*> CapsuleOwnerKeys;
+
+	/** Flat bounding volume hierarchy over the capsules */
+	TArray<FCombatHurtboxNode> Nodes;
+
+	/** Melee queries waiting to be resolved */
+	TArray<FCombatMeleeQuery> PendingQueries;
+
+	/** Melee queries being resolved. Kept around to reuse its allocation */
+	TArray<FCombatMeleeQuery> ResolvingQueries;
+
+	/** Results for each resolved query. Kept around to reuse the allocations */
+	TArray<TArray<FCombatMeleeHit>> QueryResults;
+
+public:
+
+	/** Adds a hurtbox component to the capsules published each frame */
+	void RegisterHurtbox(UCombatHurtboxComponent* Hurtbox);
+
+	/** Removes a hurtbox component */
+	void UnregisterHurtbox(UCombatHurtboxComponent* Hurtbox);
+
+	/** Queues a melee query to be resolved later this frame */
+	void QueueMeleeQuery(const FCombatMeleeQuery& Query);
+
+	/** Runs a single query against the current hierarchy. Safe to call from any thread while the hierarchy isn't being rebuilt */
+	void RunQuery(const FCombatMeleeQuery& Query, const AActor* AttackerKey, TArray<FCombatMeleeHit>& OutHits) const;
+
+protected:
+
+	/** Gathers the capsules from every hurtbox and rebuilds the hierarchy */
+	void RebuildHierarchy();
+
+	/** Builds the hierarchy node for a range of capsules. Returns the node index */
+	int32 BuildNode(int32 Begin, int32 End);
+
+	/** Runs the queued queries in parallel and passes their hits on as damage */
+	void ResolveQueries();
+
+	/** Draws the published capsules */
+	void DrawDebugCapsules() const;
+
+	/** Rebuilds the hierarchy and resolves the queries */
+	void TickResolve(float DeltaTime);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Sets up the resolve tick */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Drops all hurtboxes and pending queries */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
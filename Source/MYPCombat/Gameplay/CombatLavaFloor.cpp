@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatLavaFloor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "CombatHazardZoneComponent.h"
+#include "MYPTickAudit.h"
+
+MYP_AUDIT_TICK(ACombatLavaFloor);
+
+ACombatLavaFloor::ACombatLavaFloor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// create the mesh
+	RootComponent = Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
+
+	// the hazard zone deals the damage, so the mesh doesn't need to report contacts
+	Mesh->SetNotifyRigidBodyCollision(false);
+
+	// create the hazard zone. Lava is meant to kill on contact
+	HazardZone = CreateDefaultSubobject<UCombatHazardZoneComponent>(TEXT("Hazard Zone"));
+	HazardZone->SetupAttachment(Mesh);
+	HazardZone->SetDamage(Damage, DamageInterval);
+}
+
+void ACombatLavaFloor::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	// the hazard zone deals the damage, so keep it in sync with the values set on the floor
+	HazardZone->SetDamage(Damage, DamageInterval);
+
+	const UStaticMesh* FloorMesh = Mesh->GetStaticMesh();
+
+	if (!FloorMesh)
+	{
+		return;
+	}
+
+	// cover the mesh bounds, extended upwards by the contact height. The zone inherits the mesh scale, so undo it for the height
+	const FBox LocalBounds = FloorMesh->GetBoundingBox();
+	const float LocalContactHeight = ContactHeight / FMath::Max(FMath::Abs(Mesh->GetComponentScale().Z), UE_KINDA_SMALL_NUMBER);
+
+	FVector Extent = LocalBounds.GetExtent();
+	Extent.Z += LocalContactHeight * 0.5f;
+
+	HazardZone->SetRelativeLocation(LocalBounds.GetCenter() + FVector(0.0f, 0.0f, LocalContactHeight * 0.5f));
+	HazardZone->SetBoxExtent(Extent);
+}
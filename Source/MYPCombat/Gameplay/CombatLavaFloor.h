@@ -0,0 +1,52 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "CombatLavaFloor.generated.h"
+
+class UStaticMeshComponent;
+class UCombatHazardZoneComponent;
+
+/**
+ *  A basic actor that damages anything standing on it through the ICombatDamageable interface.
+ *  Damage is dealt by a hazard zone fitted over the floor mesh, at a fixed rate per actor.
+ */
+UCLASS(abstract)
+class ACombatLavaFloor : public AActor
+{
+	GENERATED_BODY()
+	
+	/** Floor mesh */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UStaticMeshComponent* Mesh;
+
+	/** Damage zone covering the top of the floor mesh */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UCombatHazardZoneComponent* HazardZone;
+
+protected:
+
+	/** Amount of damage dealt to each actor in contact with the floor */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0))
+	float Damage = 10000.0f;
+
+	/** Time between damage applications for each actor in contact with the floor */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0.05, Units = "s"))
+	float DamageInterval = 0.5f;
+
+	/** Height above the floor mesh covered by the hazard zone, so actors standing on it are inside */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 1, Units = "cm"))
+	float ContactHeight = 20.0f;
+
+public:	
+
+	/** Constructor */
+	ACombatLavaFloor();
+
+protected:
+
+	/** Forwards the damage settings to the hazard zone and fits it to the floor mesh */
+	virtual void OnConstruction(const FTransform& Transform) override;
+};
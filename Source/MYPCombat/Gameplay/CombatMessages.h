@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MYPMessageSubsystem.h"
+#include "CombatMessages.generated.h"
+
+/**
+ *  Gameplay message channels shared by the combat actors.
+ *  Activation channels are per source actor, so they're set up on the actors themselves instead.
+ */
+namespace CombatChannels
+{
+	/** Enemy deaths. Deferred, so all deaths from a damage flush are delivered together */
+	const FName EnemyDied(TEXT("Combat.EnemyDied"));
+}
+
+/**
+ *  Sent when an enemy dies. The instigator is the dead enemy
+ */
+USTRUCT(BlueprintType)
+struct FCombatEnemyDiedMessage : public FMYPMessage
+{
+	GENERATED_BODY()
+};
+
+/**
+ *  Sent to activate ICombatActivatables listening on a channel. The instigator is the actor causing the activation
+ */
+USTRUCT(BlueprintType)
+struct FCombatActivationMessage : public FMYPMessage
+{
+	GENERATED_BODY()
+};
@@ -0,0 +1,116 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatPhysicsSleepSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "MYP.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat Tracked Constraint Bodies"), STAT_CombatTrackedBodies, STATGROUP_MYP);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat Awake Constraint Bodies"), STAT_CombatAwakeBodies, STATGROUP_MYP);
+
+CSV_DEFINE_CATEGORY(MYPPhysics, true);
+
+/** Number of samples kept for the report. At the default interval this covers one minute */
+static constexpr int32 SleepReportHistorySize = 240;
+
+static FAutoConsoleCommandWithWorld CombatPhysicsSleepReportCommand(
+	TEXT("Combat.Physics.SleepReport"),
+	TEXT("Logs how many tracked constrained bodies are awake in the current world."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UCombatPhysicsSleepSubsystem* SleepSubsystem = World ? World->GetSubsystem<UCombatPhysicsSleepSubsystem>() : nullptr)
+		{
+			SleepSubsystem->LogReport();
+		}
+	}));
+
+void UCombatPhysicsSleepSubsystem::RegisterBody(UPrimitiveComponent* Body)
+{
+	if (Body)
+	{
+		TrackedBodies.AddUnique(Body);
+	}
+}
+
+void UCombatPhysicsSleepSubsystem::UnregisterBody(UPrimitiveComponent* Body)
+{
+	TrackedBodies.RemoveSwap(Body);
+}
+
+void UCombatPhysicsSleepSubsystem::LogReport() const
+{
+	// average the recorded history
+	int64 SampleTotal = 0;
+
+	for (const int32 Sample : SampleHistory)
+	{
+		SampleTotal += Sample;
+	}
+
+	const float AverageAwake = SampleHistory.Num() > 0 ? float(SampleTotal) / SampleHistory.Num() : 0.0f;
+
+	UE_LOG(MYPLog, Log, TEXT("Constraint sleep report: %d tracked, %d awake, %.1f average awake over %d samples, %d peak awake"),
+		TrackedBodies.Num(), LastAwakeBodies, AverageAwake, SampleHistory.Num(), PeakAwakeBodies);
+}
+
+void UCombatPhysicsSleepSubsystem::SampleBodies(float DeltaTime)
+{
+	int32 AwakeBodies = 0;
+
+	// count the awake bodies, dropping any that were destroyed
+	for (int32 i = TrackedBodies.Num() - 1; i >= 0; --i)
+	{
+		const UPrimitiveComponent* Body = TrackedBodies[i].Get();
+
+		if (!Body)
+		{
+			TrackedBodies.RemoveAtSwap(i, EAllowShrinking::No);
+			continue;
+		}
+
+		if (Body->RigidBodyIsAwake())
+		{
+			++AwakeBodies;
+		}
+	}
+
+	// record the sample
+	LastAwakeBodies = AwakeBodies;
+	PeakAwakeBodies = FMath::Max(PeakAwakeBodies, AwakeBodies);
+
+	if (SampleHistory.Num() < SleepReportHistorySize)
+	{
+		SampleHistory.Add(AwakeBodies);
+	}
+	else
+	{
+		SampleHistory[NextSampleIndex] = AwakeBodies;
+	}
+
+	NextSampleIndex = (NextSampleIndex + 1) % SleepReportHistorySize;
+
+	SET_DWORD_STAT(STAT_CombatTrackedBodies, TrackedBodies.Num());
+	SET_DWORD_STAT(STAT_CombatAwakeBodies, AwakeBodies);
+	CSV_CUSTOM_STAT(MYPPhysics, AwakeConstraintBodies, AwakeBodies, ECsvCustomStatOp::Set);
+}
+
+void UCombatPhysicsSleepSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// sampling a few times per second is enough to see trends
+	SetupTick(&UCombatPhysicsSleepSubsystem::SampleBodies, TG_PostPhysics, TEXT("CombatPhysicsSleepSubsystem::SampleBodies"), 0.25f);
+}
+
+void UCombatPhysicsSleepSubsystem::Deinitialize()
+{
+	SET_DWORD_STAT(STAT_CombatTrackedBodies, 0);
+	SET_DWORD_STAT(STAT_CombatAwakeBodies, 0);
+
+	TrackedBodies.Empty();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "CombatPhysicsSleepSubsystem.generated.h"
+
+class UPrimitiveComponent;
+
+/**
+ *  Tracks constrained physics bodies in the level and samples how many of them are awake.
+ *  An awake body keeps its constraint in the solver, so this is the number of active constraint solvers.
+ *  Results are exposed through 'stat MYP', the CSV profiler and the Combat.Physics.SleepReport console command.
+ */
+UCLASS()
+class UCombatPhysicsSleepSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Constrained bodies tracked by this subsystem */
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> TrackedBodies;
+
+	/** Ring buffer of recent awake body counts */
+	TArray<int32> SampleHistory;
+
+	/** Next write position in the sample history */
+	int32 NextSampleIndex = 0;
+
+	/** Highest awake body count seen since the world began play */
+	int32 PeakAwakeBodies = 0;
+
+	/** Awake body count from the last sample */
+	int32 LastAwakeBodies = 0;
+
+public:
+
+	/** Starts tracking a constrained physics body */
+	void RegisterBody(UPrimitiveComponent* Body);
+
+	/** Stops tracking a constrained physics body */
+	void UnregisterBody(UPrimitiveComponent* Body);
+
+	/** Logs the current, peak and recent average awake body counts */
+	void LogReport() const;
+
+protected:
+
+	/** Samples the number of awake bodies */
+	void SampleBodies(float DeltaTime);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Sets up the sampling tick */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Stops tracking bodies */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
@@ -0,0 +1,359 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatTriggerSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Components/BoxComponent.h"
+#include "MYP.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Triggers"), STAT_CombatTriggers, STATGROUP_MYP);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat Trigger Boxes"), STAT_CombatTriggerBoxes, STATGROUP_MYP);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Trigger Events"), STAT_CombatTriggerEvents, STATGROUP_MYP);
+
+void UCombatTriggerSubsystem::RegisterTrigger(AActor* Owner, const UBoxComponent* Box, FCombatTriggerDelegate&& OnEnter, FCombatTriggerDelegate&& OnExit)
+{
+	if (!Owner || !Box)
+	{
+		return;
+	}
+
+	// bake the box in world space
+	const FTransform& BoxTransform = Box->GetComponentTransform();
+
+	FTriggerBox TriggerBox;
+	TriggerBox.Center = FVector3f(BoxTransform.GetLocation());
+	TriggerBox.AxisX = FVector3f(BoxTransform.GetUnitAxis(EAxis::X));
+	TriggerBox.AxisY = FVector3f(BoxTransform.GetUnitAxis(EAxis::Y));
+	TriggerBox.AxisZ = FVector3f(BoxTransform.GetUnitAxis(EAxis::Z));
+	TriggerBox.Extent = FVector3f(Box->GetScaledBoxExtent());
+
+	FTrigger Trigger;
+	Trigger.Owner = Owner;
+	Trigger.OnEnter = MoveTemp(OnEnter);
+	Trigger.OnExit = MoveTemp(OnExit);
+
+	// don't move the trigger array while one of its callbacks is running
+	if (bRunningCallbacks)
+	{
+		PendingTriggers.Add(MoveTemp(Trigger));
+		PendingBoxes.Add(TriggerBox);
+	}
+	else
+	{
+		Triggers.Add(MoveTemp(Trigger));
+		Boxes.Add(TriggerBox);
+		bBoxGroupsDirty = true;
+	}
+
+	INC_DWORD_STAT(STAT_CombatTriggerBoxes);
+}
+
+void UCombatTriggerSubsystem::UnregisterTriggers(const AActor* Owner)
+{
+	for (FTrigger& Trigger : Triggers)
+	{
+		if (Trigger.Owner == Owner)
+		{
+			Trigger.bRemoved = true;
+		}
+	}
+
+	for (FTrigger& Trigger : PendingTriggers)
+	{
+		if (Trigger.Owner == Owner)
+		{
+			Trigger.bRemoved = true;
+		}
+	}
+
+	// the callback loop holds trigger indices, so wait until it's done
+	if (!bRunningCallbacks)
+	{
+		FlushTriggerChanges();
+	}
+}
+
+void UCombatTriggerSubsystem::RegisterPawn(APawn* Pawn)
+{
+	if (!Pawn || PawnSlots.Contains(Pawn))
+	{
+		return;
+	}
+
+	// reuse a free slot if there is one
+	for (int32 Slot = 0; Slot < PawnSlots.Num(); ++Slot)
+	{
+		if (!PawnSlots[Slot].IsValid())
+		{
+			ClearPawnSlot(Slot);
+			PawnSlots[Slot] = Pawn;
+			return;
+		}
+	}
+
+	PawnSlots.Add(Pawn);
+}
+
+void UCombatTriggerSubsystem::UnregisterPawn(const APawn* Pawn)
+{
+	const int32 Slot = PawnSlots.IndexOfByKey(Pawn);
+
+	if (Slot != INDEX_NONE)
+	{
+		PawnSlots[Slot].Reset();
+		ClearPawnSlot(Slot);
+	}
+}
+
+void UCombatTriggerSubsystem::RebuildBoxGroups()
+{
+	const int32 NumGroups = (Boxes.Num() + 3) / 4;
+	BoxGroups.SetNumUninitialized(NumGroups);
+
+	for (int32 GroupIndex = 0; GroupIndex < NumGroups; ++GroupIndex)
+	{
+		// gather the lanes. Padding lanes get a huge negative extent, so nothing is ever inside them, even once grown by a pawn's size
+		alignas(16) float Lanes[15][4];
+
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const int32 BoxIndex = GroupIndex * 4 + Lane;
+			const bool bValid = BoxIndex < Boxes.Num();
+
+			const FTriggerBox TriggerBox = bValid ? Boxes[BoxIndex] : FTriggerBox();
+			const FVector3f Extent = bValid ? TriggerBox.Extent : FVector3f(-UE_BIG_NUMBER);
+
+			Lanes[0][Lane] = TriggerBox.Center.X;
+			Lanes[1][Lane] = TriggerBox.Center.Y;
+			Lanes[2][Lane] = TriggerBox.Center.Z;
+			Lanes[3][Lane] = TriggerBox.AxisX.X;
+			Lanes[4][Lane] = TriggerBox.AxisX.Y;
+			Lanes[5][Lane] = TriggerBox.AxisX.Z;
+			Lanes[6][Lane] = TriggerBox.AxisY.X;
+			Lanes[7][Lane] = TriggerBox.AxisY.Y;
+			Lanes[8][Lane] = TriggerBox.AxisY.Z;
+			Lanes[9][Lane] = TriggerBox.AxisZ.X;
+			Lanes[10][Lane] = TriggerBox.AxisZ.Y;
+			Lanes[11][Lane] = TriggerBox.AxisZ.Z;
+			Lanes[12][Lane] = Extent.X;
+			Lanes[13][Lane] = Extent.Y;
+			Lanes[14][Lane] = Extent.Z;
+		}
+
+		FTriggerBoxGroup& Group = BoxGroups[GroupIndex];
+		Group.CenterX = VectorLoadAligned(Lanes[0]);
+		Group.CenterY = VectorLoadAligned(Lanes[1]);
+		Group.CenterZ = VectorLoadAligned(Lanes[2]);
+		Group.AxisXX = VectorLoadAligned(Lanes[3]);
+		Group.AxisXY = VectorLoadAligned(Lanes[4]);
+		Group.AxisXZ = VectorLoadAligned(Lanes[5]);
+		Group.AxisYX = VectorLoadAligned(Lanes[6]);
+		Group.AxisYY = VectorLoadAligned(Lanes[7]);
+		Group.AxisYZ = VectorLoadAligned(Lanes[8]);
+		Group.AxisZX = VectorLoadAligned(Lanes[9]);
+		Group.AxisZY = VectorLoadAligned(Lanes[10]);
+		Group.AxisZZ = VectorLoadAligned(Lanes[11]);
+		Group.ExtentX = VectorLoadAligned(Lanes[12]);
+		Group.ExtentY = VectorLoadAligned(Lanes[13]);
+		Group.ExtentZ = VectorLoadAligned(Lanes[14]);
+	}
+
+	bBoxGroupsDirty = false;
+}
+
+void UCombatTriggerSubsystem::ClearPawnSlot(int32 Slot)
+{
+	for (FTrigger& Trigger : Triggers)
+	{
+		if (Trigger.Occupants.IsValidIndex(Slot))
+		{
+			Trigger.Occupants[Slot] = false;
+		}
+	}
+}
+
+void UCombatTriggerSubsystem::FlushTriggerChanges()
+{
+	for (int32 TriggerIndex = Triggers.Num() - 1; TriggerIndex >= 0; --TriggerIndex)
+	{
+		if (Triggers[TriggerIndex].bRemoved)
+		{
+			Triggers.RemoveAt(TriggerIndex, EAllowShrinking::No);
+			Boxes.RemoveAt(TriggerIndex, EAllowShrinking::No);
+			bBoxGroupsDirty = true;
+
+			DEC_DWORD_STAT(STAT_CombatTriggerBoxes);
+		}
+	}
+
+	for (int32 PendingIndex = 0; PendingIndex < PendingTriggers.Num(); ++PendingIndex)
+	{
+		if (PendingTriggers[PendingIndex].bRemoved)
+		{
+			DEC_DWORD_STAT(STAT_CombatTriggerBoxes);
+			continue;
+		}
+
+		Triggers.Add(MoveTemp(PendingTriggers[PendingIndex]));
+		Boxes.Add(PendingBoxes[PendingIndex]);
+		bBoxGroupsDirty = true;
+	}
+
+	PendingTriggers.Reset();
+	PendingBoxes.Reset();
+}
+
+void UCombatTriggerSubsystem::TickTriggers(float DeltaTime)
+{
+	if (Triggers.IsEmpty() || PawnSlots.IsEmpty())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CombatTriggers);
+
+	if (bBoxGroupsDirty)
+	{
+		RebuildBoxGroups();
+	}
+
+	const int32 NumSlots = PawnSlots.Num();
+	NewOccupants.Init(false, BoxGroups.Num() * 4 * NumSlots);
+
+	// test each player pawn against every box, four boxes at a time
+	for (int32 Slot = 0; Slot < PawnSlots.Num(); ++Slot)
+	{
+		const APawn* Pawn = PawnSlots[Slot].Get();
+
+		if (!Pawn || !Pawn->IsPlayerControlled())
+		{
+			continue;
+		}
+
+		const FVector3f Location(Pawn->GetActorLocation());
+		const VectorRegister4Float PawnX = VectorSetFloat1(Location.X);
+		const VectorRegister4Float PawnY = VectorSetFloat1(Location.Y);
+		const VectorRegister4Float PawnZ = VectorSetFloat1(Location.Z);
+
+		// grow the boxes by the pawn's size, so we're testing its collision and not just its origin
+		float PawnRadius = 0.0f;
+		float PawnHalfHeight = 0.0f;
+		Pawn->GetSimpleCollisionCylinder(PawnRadius, PawnHalfHeight);
+
+		const VectorRegister4Float GrowXY = VectorSetFloat1(PawnRadius);
+		const VectorRegister4Float GrowZ = VectorSetFloat1(PawnHalfHeight);
+
+		for (int32 GroupIndex = 0; GroupIndex < BoxGroups.Num(); ++GroupIndex)
+		{
+			const FTriggerBoxGroup& Group = BoxGroups[GroupIndex];
+
+			const VectorRegister4Float DeltaX = VectorSubtract(PawnX, Group.CenterX);
+			const VectorRegister4Float DeltaY = VectorSubtract(PawnY, Group.CenterY);
+			const VectorRegister4Float DeltaZ = VectorSubtract(PawnZ, Group.CenterZ);
+
+			// project the pawn onto each box axis
+			const VectorRegister4Float LocalX = VectorMultiplyAdd(DeltaX, Group.AxisXX, VectorMultiplyAdd(DeltaY, Group.AxisXY, VectorMultiply(DeltaZ, Group.AxisXZ)));
+			const VectorRegister4Float LocalY = VectorMultiplyAdd(DeltaX, Group.AxisYX, VectorMultiplyAdd(DeltaY, Group.AxisYY, VectorMultiply(DeltaZ, Group.AxisYZ)));
+			const VectorRegister4Float LocalZ = VectorMultiplyAdd(DeltaX, Group.AxisZX, VectorMultiplyAdd(DeltaY, Group.AxisZY, VectorMultiply(DeltaZ, Group.AxisZZ)));
+
+			// inside when within the extent on all three axes
+			VectorRegister4Float Inside = VectorCompareLE(VectorAbs(LocalX), VectorAdd(Group.ExtentX, GrowXY));
+			Inside = VectorBitwiseAnd(Inside, VectorCompareLE(VectorAbs(LocalY), VectorAdd(Group.ExtentY, GrowXY)));
+			Inside = VectorBitwiseAnd(Inside, VectorCompareLE(VectorAbs(LocalZ), VectorAdd(Group.ExtentZ, GrowZ)));
+
+			uint32 InsideMask = VectorMaskBits(Inside);
+
+			while (InsideMask)
+			{
+				const int32 Lane = FMath::CountTrailingZeros(InsideMask);
+				NewOccupants[(GroupIndex * 4 + Lane) * NumSlots + Slot] = true;
+				InsideMask &= InsideMask - 1;
+			}
+		}
+	}
+
+	// diff against last frame's occupants
+	PendingEvents.Reset();
+
+	for (int32 TriggerIndex = 0; TriggerIndex < Triggers.Num(); ++TriggerIndex)
+	{
+		FTrigger& Trigger = Triggers[TriggerIndex];
+
+		// pawns may have registered since the trigger last ran
+		if (Trigger.Occupants.Num() < NumSlots)
+		{
+			Trigger.Occupants.SetNum(NumSlots, false);
+		}
+
+		const int32 RowStart = TriggerIndex * NumSlots;
+
+		for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+		{
+			const bool bInside = NewOccupants[RowStart + Slot];
+
+			if (Trigger.Occupants[Slot] == bInside)
+			{
+				continue;
+			}
+
+			FTriggerEvent& Event = PendingEvents.AddDefaulted_GetRef();
+			Event.TriggerIndex = TriggerIndex;
+			Event.Pawn = PawnSlots[Slot];
+			Event.bEntered = bInside;
+
+			Trigger.Occupants[Slot] = bInside;
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_CombatTriggerEvents, PendingEvents.Num());
+
+	// run the callbacks. Triggers removed by a callback are only flagged until we're done
+	bRunningCallbacks = true;
+
+	for (const FTriggerEvent& Event : PendingEvents)
+	{
+		FTrigger& Trigger = Triggers[Event.TriggerIndex];
+		APawn* Pawn = Event.Pawn.Get();
+
+		if (Trigger.bRemoved || !Pawn)
+		{
+			continue;
+		}
+
+		if (Event.bEntered)
+		{
+			Trigger.OnEnter.ExecuteIfBound(Pawn);
+		}
+		else
+		{
+			Trigger.OnExit.ExecuteIfBound(Pawn);
+		}
+	}
+
+	bRunningCallbacks = false;
+
+	FlushTriggerChanges();
+}
+
+void UCombatTriggerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// test after physics, once the pawns have moved for the frame
+	SetupTick(&UCombatTriggerSubsystem::TickTriggers, TG_PostPhysics, TEXT("CombatTriggerSubsystem::TickTriggers"));
+}
+
+void UCombatTriggerSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_CombatTriggerBoxes, Triggers.Num());
+
+	Triggers.Empty();
+	PendingTriggers.Empty();
+	PendingBoxes.Empty();
+	Boxes.Empty();
+	BoxGroups.Empty();
+	PawnSlots.Empty();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,166 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+#include "MYPTickableWorldSubsystem.h"
+#include "CombatTriggerSubsystem.generated.h"
+
+class APawn;
+class UBoxComponent;
+
+/** Trigger enter or exit callback */
+DECLARE_DELEGATE_OneParam(FCombatTriggerDelegate, APawn* /*Pawn*/);
+
+/**
+ *  Tests player pawns against trigger boxes without going through physics.
+ *  - Trigger volumes register an oriented box and get enter and exit callbacks, so they don't need overlap bodies
+ *  - Only registered pawns that are currently player controlled are tested. Simulating props, enemies and ragdolls never are
+ *  - Boxes are packed four to a group and tested against each pawn's location in a single SIMD pass per frame.
+ *    Each box is grown by the pawn's collision cylinder first, so pawns trigger as soon as their capsule reaches it, like an overlap would
+ */
+UCLASS()
+class UCombatTriggerSubsystem : public UMYPTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** An oriented trigger box, in world space */
+	struct FTriggerBox
+	{
+		/** Box center */
+		FVector3f Center = FVector3f::ZeroVector;
+
+		/** Box axes. Unit length */
+		FVector3f AxisX = FVector3f::ForwardVector;
+		FVector3f AxisY = FVector3f::RightVector;
+		FVector3f AxisZ = FVector3f::UpVector;
+
+		/** Box half extents along each axis */
+		FVector3f Extent = FVector3f::ZeroVector;
+	};
+
+	/** Four trigger boxes packed for SIMD, one box per lane */
+	struct FTriggerBoxGroup
+	{
+		VectorRegister4Float CenterX;
+		VectorRegister4Float CenterY;
+		VectorRegister4Float CenterZ;
+
+		VectorRegister4Float AxisXX;
+		VectorRegister4Float AxisXY;
+		VectorRegister4Float AxisXZ;
+
+		VectorRegister4Float AxisYX;
+		VectorRegister4Float AxisYY;
+		VectorRegister4Float AxisYZ;
+
+		VectorRegister4Float AxisZX;
+		VectorRegister4Float AxisZY;
+		VectorRegister4Float AxisZZ;
+
+		VectorRegister4Float ExtentX;
+		VectorRegister4Float ExtentY;
+		VectorRegister4Float ExtentZ;
+	};
+
+	/** A registered trigger */
+	struct FTrigger
+	{
+		/** Actor that registered the trigger */
+		TWeakObjectPtr<AActor> Owner;
+
+		/** Called when a pawn enters the box */
+		FCombatTriggerDelegate OnEnter;
+
+		/** Called when a pawn leaves the box */
+		FCombatTriggerDelegate OnExit;
+
+		/** Pawn slots currently inside the box, one bit per slot. Grown as pawns register */
+		TBitArray<> Occupants;
+
+		/** If true, the trigger was unregistered while callbacks were running and will be removed after */
+		bool bRemoved = false;
+	};
+
+	/** A pending enter or exit callback */
+	struct FTriggerEvent
+	{
+		/** Index of the trigger */
+		int32 TriggerIndex = INDEX_NONE;
+
+		/** Pawn that entered or left */
+		TWeakObjectPtr<APawn> Pawn;
+
+		/** If true, the pawn entered the box. Otherwise it left */
+		bool bEntered = false;
+	};
+
+	/** Registered triggers */
+	TArray<FTrigger> Triggers;
+
+	/** Trigger boxes, parallel to the triggers */
+	TArray<FTriggerBox> Boxes;
+
+	/** Triggers registered while callbacks were running, and their boxes. Added once the callbacks are done */
+	TArray<FTrigger> PendingTriggers;
+	TArray<FTriggerBox> PendingBoxes;
+
+	/** Trigger boxes packed for SIMD. Rebuilt when triggers are added or removed */
+	TArray<FTriggerBoxGroup> BoxGroups;
+
+	/** Registered pawns. Slots are stable so they can be used as occupant bits */
+	TArray<TWeakObjectPtr<APawn>> PawnSlots;
+
+	/** Occupants found this frame, one row of pawn slot bits per packed box. Kept around to reuse the allocation */
+	TBitArray<> NewOccupants;
+
+	/** Callbacks to run this frame. Kept around to reuse the allocation */
+	TArray<FTriggerEvent> PendingEvents;
+
+	/** If true, the packed boxes need rebuilding */
+	bool bBoxGroupsDirty = false;
+
+	/** If true, trigger callbacks are running */
+	bool bRunningCallbacks = false;
+
+public:
+
+	/** Registers a trigger with the bounds of a box component. The box is assumed not to move */
+	void RegisterTrigger(AActor* Owner, const UBoxComponent* Box, FCombatTriggerDelegate&& OnEnter, FCombatTriggerDelegate&& OnExit = FCombatTriggerDelegate());
+
+	/** Removes all triggers registered by an actor. No exit callbacks are run */
+	void UnregisterTriggers(const AActor* Owner);
+
+	/** Adds a pawn to the set tested against the triggers. It's only tested while it's player controlled */
+	void RegisterPawn(APawn* Pawn);
+
+	/** Removes a pawn. No exit callbacks are run */
+	void UnregisterPawn(const APawn* Pawn);
+
+protected:
+
+	/** Packs the trigger boxes into SIMD groups */
+	void RebuildBoxGroups();
+
+	/** Clears a pawn slot from every trigger */
+	void ClearPawnSlot(int32 Slot);
+
+	/** Removes the unregistered triggers, and adds the ones registered while callbacks were running */
+	void FlushTriggerChanges();
+
+	/** Tests the pawns against the triggers and runs the enter and exit callbacks */
+	void TickTriggers(float DeltaTime);
+
+public:
+
+	// ~begin UWorldSubsystem interface
+
+	/** Sets up the trigger tick */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Drops all triggers and pawns */
+	virtual void Deinitialize() override;
+
+	// ~end UWorldSubsystem interface
+};
@@ -0,0 +1,20 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatActivatable.h"
+#include "MYPMessageSubsystem.h"
+#include "CombatMessages.h"
+
+void ICombatActivatable::ListenForActivation(FName Channel)
+{
+	UObject* ActivatableObject = _getUObject();
+
+	if (UMYPMessageSubsystem* Messages = UMYPMessageSubsystem::Get(ActivatableObject))
+	{
+		// the subscription is bound to the object, so the interface pointer stays valid while it's called
+		Messages->Subscribe<FCombatActivationMessage>(Channel, ActivatableObject, [this](FName, const FCombatActivationMessage& Message)
+		{
+			ActivateInteraction(Message.Instigator.Get());
+		});
+	}
+}
@@ -33,4 +33,7 @@ public:
 	/** Deactivates the Interactable Actor */
 	UFUNCTION(BlueprintCallable, Category="Activatable")
 	virtual void DeactivateInteraction(AActor* ActivationInstigator) = 0;
+
+	/** Subscribes this actor to activation messages on the given channel */
+	void ListenForActivation(FName Channel);
 };
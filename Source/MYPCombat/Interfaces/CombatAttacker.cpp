@@ -0,0 +1,9 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatAttacker.h"
+
+void ICombatAttacker::HandleMeleeHit(AActor* HitActor, float Damage, const FVector& ImpactPoint, const FVector& ImpactNormal, FName Zone)
+{
+	// no-op by default
+}
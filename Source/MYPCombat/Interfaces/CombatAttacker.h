@@ -33,4 +33,7 @@ public:
 	/** Performs a charged attack's check to loop the charge animation. Usually called from a montage's AnimNotify */
 	UFUNCTION(BlueprintCallable, Category="Attacker")
 	virtual void CheckChargedAttack() = 0;
+
+	/** Notifies the attacker that one of its melee queries hit an actor's hurtbox. Damage already includes the zone multiplier */
+	virtual void HandleMeleeHit(AActor* HitActor, float Damage, const FVector& ImpactPoint, const FVector& ImpactNormal, FName Zone);
 };
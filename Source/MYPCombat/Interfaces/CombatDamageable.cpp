@@ -0,0 +1,20 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatDamageable.h"
+
+// Add default functionality here for any ICombatDamageable functions that are not pure virtual.
+
+void ICombatDamageable::ApplyDamageBatch(TConstArrayView<FCombatDamageEvent> DamageEvents)
+{
+	// pass each damage event through the regular damage handler
+	for (const FCombatDamageEvent& DamageEvent : DamageEvents)
+	{
+		ApplyDamage(DamageEvent.Damage, DamageEvent.DamageCauser.Get(), DamageEvent.DamageLocation, DamageEvent.DamageImpulse);
+	}
+}
+
+ECombatFaction ICombatDamageable::GetCombatFaction() const
+{
+	return ECombatFaction::Prop;
+}
@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "CombatDamageable.generated.h"
+
+/**
+ *  Side a damageable actor fights on. Decides which melee sweeps can hit it
+ */
+UENUM(BlueprintType)
+enum class ECombatFaction : uint8
+{
+	Player,
+	Enemy,
+	Prop
+};
+
+/**
+ *  A single queued damage event.
+ *  Damage events are collected during the frame and resolved together by the Combat Damage Subsystem
+ */
+USTRUCT(BlueprintType)
+struct FCombatDamageEvent
+{
+	GENERATED_BODY()
+
+	/** Actor receiving the damage */
+	UPROPERTY(BlueprintReadWrite, Category="Damage")
+	TWeakObjectPtr<AActor> Target;
+
+	/** Actor that caused the damage */
+	UPROPERTY(BlueprintReadWrite, Category="Damage")
+	TWeakObjectPtr<AActor> DamageCauser;
+
+	/** Amount of damage to apply */
+	UPROPERTY(BlueprintReadWrite, Category="Damage")
+	float Damage = 0.0f;
+
+	/** World location of the hit */
+	UPROPERTY(BlueprintReadWrite, Category="Damage")
+	FVector DamageLocation = FVector::ZeroVector;
+
+	/** Knockback impulse to apply */
+	UPROPERTY(BlueprintReadWrite, Category="Damage")
+	FVector DamageImpulse = FVector::ZeroVector;
+};
+
+/**
+ *  CombatDamageable interface
+ *  Provides functionality to handle damage, healing, knockback and death
+ */
+UINTERFACE(MinimalAPI, NotBlueprintable)
+class UCombatDamageable : public UInterface
+{
+	GENERATED_BODY()
+};
+
+class ICombatDamageable
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Handles damage and knockback events */
+	UFUNCTION(BlueprintCallable, Category="Damageable")
+	virtual void ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse) = 0;
+
+	/** Handles death events */
+	UFUNCTION(BlueprintCallable, Category="Damageable")
+	virtual void HandleDeath() = 0;
+
+	/** Handles healing events */
+	UFUNCTION(BlueprintCallable, Category="Damageable")
+	virtual void ApplyHealing(float Healing, AActor* Healer) = 0;
+
+	/**
+	 *  Handles all damage events received by this actor in a single frame.
+	 *  By default, each event is passed to ApplyDamage in order.
+	 *  Override to coalesce UI and effects updates across the whole batch.
+	 */
+	virtual void ApplyDamageBatch(TConstArrayView<FCombatDamageEvent> DamageEvents);
+
+	/** Returns the faction this actor belongs to. Damageables are props unless they say otherwise */
+	virtual ECombatFaction GetCombatFaction() const;
+};
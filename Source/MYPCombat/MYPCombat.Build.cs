@@ -0,0 +1,43 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class MYPCombat : ModuleRules
+{
+	public MYPCombat(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] {
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"InputCore",
+			"EnhancedInput",
+			"AIModule",
+			"NavigationSystem",
+			"StateTreeModule",
+			"GameplayStateTreeModule",
+			"UMG",
+			"Slate",
+			"PhysicsCore",
+			"Chaos",
+			"GeometryCollectionEngine",
+			"AnimationBudgetAllocator",
+			"MYP"
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "Json", "NetCore" });
+
+		// nothing outside this module includes its headers, so its folders stay private
+		PrivateIncludePaths.AddRange(new string[] {
+			"MYPCombat",
+			"MYPCombat/AI",
+			"MYPCombat/Animation",
+			"MYPCombat/Gameplay",
+			"MYPCombat/Interfaces",
+			"MYPCombat/Simulation",
+			"MYPCombat/UI"
+		});
+	}
+}
@@ -0,0 +1,126 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatSimulationBot.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "NavigationSystem.h"
+#include "NavigationPath.h"
+#include "CombatCharacter.h"
+#include "CombatEnemy.h"
+#include "CombatEnemySpawner.h"
+
+void ACombatSimulationBot::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	ACombatCharacter* Character = Cast<ACombatCharacter>(GetPawn());
+
+	if (!Character || Character->IsDead())
+	{
+		return;
+	}
+
+	// targets move and die, but picking one means iterating actors and pathing, so don't do it every frame
+	RetargetTimeLeft -= DeltaSeconds;
+
+	if (RetargetTimeLeft <= 0.0f || !Target.IsValid())
+	{
+		RetargetTimeLeft = RetargetInterval;
+		ChooseTarget(Character);
+	}
+
+	const AActor* CurrentTarget = Target.Get();
+
+	if (!CurrentTarget)
+	{
+		return;
+	}
+
+	const FVector Location = Character->GetActorLocation();
+	const FVector ToTarget = CurrentTarget->GetActorLocation() - Location;
+
+	// in range of an enemy, so turn to face it and keep pressing attack. The input cache strings the presses into combos
+	if (bTargetIsEnemy && ToTarget.SizeSquared2D() <= FMath::Square(AttackRange))
+	{
+		const FRotator Facing(0.0f, ToTarget.Rotation().Yaw, 0.0f);
+		SetControlRotation(Facing);
+		Character->SetActorRotation(Facing);
+
+		AttackTimeLeft -= DeltaSeconds;
+
+		if (AttackTimeLeft <= 0.0f)
+		{
+			AttackTimeLeft = AttackInterval;
+
+			Character->DoComboAttackStart();
+			Character->DoComboAttackEnd();
+		}
+
+		return;
+	}
+
+	// skip the path points we've already reached
+	while (PathPoints.IsValidIndex(PathIndex) && FVector::DistSquared2D(PathPoints[PathIndex], Location) <= FMath::Square(WaypointRadius))
+	{
+		++PathIndex;
+	}
+
+	// walk towards the next point, or straight at the target if the path ran out
+	const FVector Goal = PathPoints.IsValidIndex(PathIndex) ? PathPoints[PathIndex] : CurrentTarget->GetActorLocation();
+
+	SetControlRotation(FRotator(0.0f, (Goal - Location).Rotation().Yaw, 0.0f));
+	Character->DoMove(0.0f, 1.0f);
+}
+
+void ACombatSimulationBot::ChooseTarget(const ACombatCharacter* Character)
+{
+	const FVector Location = Character->GetActorLocation();
+
+	AActor* BestTarget = nullptr;
+	float BestDistanceSquared = TNumericLimits<float>::Max();
+
+	// the nearest enemy still standing
+	for (TActorIterator<ACombatEnemy> It(GetWorld()); It; ++It)
+	{
+		const float DistanceSquared = FVector::DistSquared(It->GetActorLocation(), Location);
+
+		if (It->CurrentHP > 0.0f && DistanceSquared < BestDistanceSquared)
+		{
+			BestTarget = *It;
+			BestDistanceSquared = DistanceSquared;
+		}
+	}
+
+	bTargetIsEnemy = BestTarget != nullptr;
+
+	// nobody to fight, so go where the next enemies will come from
+	if (!bTargetIsEnemy)
+	{
+		for (TActorIterator<ACombatEnemySpawner> It(GetWorld()); It; ++It)
+		{
+			const float DistanceSquared = FVector::DistSquared(It->GetActorLocation(), Location);
+
+			if (!It->IsDepleted() && DistanceSquared < BestDistanceSquared)
+			{
+				BestTarget = *It;
+				BestDistanceSquared = DistanceSquared;
+			}
+		}
+	}
+
+	Target = BestTarget;
+
+	PathPoints.Reset();
+	PathIndex = 0;
+
+	if (!BestTarget)
+	{
+		return;
+	}
+
+	if (const UNavigationPath* Path = UNavigationSystemV1::FindPathToLocationSynchronously(GetWorld(), Location, BestTarget->GetActorLocation(), GetPawn()))
+	{
+		PathPoints = Path->PathPoints;
+	}
+}
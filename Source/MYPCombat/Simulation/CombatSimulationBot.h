@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/PlayerController.h"
+#include "CombatSimulationBot.generated.h"
+
+class ACombatCharacter;
+
+/**
+ *  Scripted stand-in for the player in headless combat simulations.
+ *  It's a player controller so enemies and spawners find its character the same way they'd find a human's.
+ *  - Fights the nearest living enemy with combo attacks
+ *  - With nobody to fight, walks to the nearest spawner that still has enemies to send, setting off its activation volume on the way
+ *  - Follows navmesh paths, which it only refreshes every so often
+ */
+UCLASS()
+class ACombatSimulationBot : public APlayerController
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Distance to an enemy at which the bot stops and attacks */
+	UPROPERTY(EditAnywhere, Category="Simulation", meta = (ClampMin = 0, ClampMax = 500, Units = "cm"))
+	float AttackRange = 150.0f;
+
+	/** Time between combo attack presses while in range */
+	UPROPERTY(EditAnywhere, Category="Simulation", meta = (ClampMin = 0, ClampMax = 2, Units = "s"))
+	float AttackInterval = 0.25f;
+
+	/** Time between picking a target and pathing to it */
+	UPROPERTY(EditAnywhere, Category="Simulation", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
+	float RetargetInterval = 0.5f;
+
+	/** Distance at which a path point counts as reached */
+	UPROPERTY(EditAnywhere, Category="Simulation", meta = (ClampMin = 0, ClampMax = 500, Units = "cm"))
+	float WaypointRadius = 75.0f;
+
+	/** Enemy or spawner the bot is heading for */
+	TWeakObjectPtr<AActor> Target;
+
+	/** If true, the target is an enemy to attack rather than a place to go */
+	bool bTargetIsEnemy = false;
+
+	/** Path to the target, as found when it was picked */
+	TArray<FVector> PathPoints;
+
+	/** Path point the bot is walking towards */
+	int32 PathIndex = 0;
+
+	/** Time left until the next retarget */
+	float RetargetTimeLeft = 0.0f;
+
+	/** Time left until the next attack press */
+	float AttackTimeLeft = 0.0f;
+
+public:
+
+	/** Drives the possessed character */
+	virtual void Tick(float DeltaSeconds) override;
+
+protected:
+
+	/** Picks the nearest enemy, or the nearest spawner if no enemy is alive, and finds a path to it */
+	void ChooseTarget(const ACombatCharacter* Character);
+};
@@ -0,0 +1,787 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatSimulationHost.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerStart.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UnrealType.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadHeartBeat.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "MYPHeadlessWorld.h"
+#include "MYPMessageSubsystem.h"
+#include "MYPRandomSubsystem.h"
+#include "CombatSimulationBot.h"
+#include "CombatCharacter.h"
+#include "CombatEnemy.h"
+#include "CombatEnemySpawner.h"
+#include "CombatDamageSubsystem.h"
+#include "CombatMessages.h"
+#include "MYP.h"
+
+static FAutoConsoleCommand CombatSimRunCommand(
+	TEXT("Combat.Sim.Run"),
+	TEXT("Simulates headless fights against a scripted player for balancing, and writes the results as JSON.\n")
+	TEXT("Config=<file> lists the level, the number of runs and the parameter sets. Worlds=<n> sets how many fights each process simulates at a time (default 4).\n")
+	TEXT("Workers=<n> spreads the fights over worker processes, usually one per core. Jobs=<first>-<last> simulates only those fights, as the workers do.\n")
+	TEXT("Output=<file> sets the results file, which defaults to Saved/Simulations.\n")
+	TEXT("-CombatSimConfig=<file> and -CombatSimOutput=<file> on the command line stand in for Config and Output. Workers get their paths that way, since -ExecCmds splits on commas."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString Params = FString::Join(Args, TEXT(" "));
+
+		FString ConfigFile;
+
+		if (!FParse::Value(*Params, TEXT("Config="), ConfigFile) && !FParse::Value(FCommandLine::Get(), TEXT("CombatSimConfig="), ConfigFile))
+		{
+			UE_LOG(MYPLog, Error, TEXT("Combat.Sim.Run needs a Config=<file>, or -CombatSimConfig=<file> on the command line"));
+			return;
+		}
+
+		FCombatSimulationConfig Config;
+
+		if (!Config.LoadFromFile(ConfigFile))
+		{
+			return;
+		}
+
+		int32 NumWorlds = 4;
+		FParse::Value(*Params, TEXT("Worlds="), NumWorlds);
+
+		int32 NumWorkers = 0;
+		FParse::Value(*Params, TEXT("Workers="), NumWorkers);
+
+		FString Output = FPaths::ProjectSavedDir() / TEXT("Simulations") / FString::Printf(TEXT("CombatSim-%s.json"), *FDateTime::Now().ToString());
+
+		if (!FParse::Value(*Params, TEXT("Output="), Output))
+		{
+			FParse::Value(FCommandLine::Get(), TEXT("CombatSimOutput="), Output);
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		TArray<FCombatSimulationResult> Results;
+
+		// a worker only simulates its share of the jobs, and leaves the summary to the coordinator
+		FString JobRange;
+
+		if (FParse::Value(*Params, TEXT("Jobs="), JobRange))
+		{
+			FString FirstJob, LastJob;
+
+			if (!JobRange.Split(TEXT("-"), &FirstJob, &LastJob))
+			{
+				FirstJob = LastJob = JobRange;
+			}
+
+			if (!FCombatSimulationHost::RunJobs(Config, FCString::Atoi(*FirstJob), FCString::Atoi(*LastJob), NumWorlds, Results))
+			{
+				UE_LOG(MYPLog, Error, TEXT("Fights %s couldn't all be simulated"), *JobRange);
+			}
+
+			FCombatSimulationHost::SaveResults(Output, Results, {});
+			return;
+		}
+
+		bool bSucceeded = false;
+
+		if (NumWorkers > 0)
+		{
+			bSucceeded = FCombatSimulationHost::RunWorkers(FPaths::ConvertRelativePathToFull(ConfigFile), Config, NumWorkers, NumWorlds, Output, Results);
+		}
+		else
+		{
+			bSucceeded = FCombatSimulationHost::RunJobs(Config, 0, Config.GetNumJobs() - 1, NumWorlds, Results);
+		}
+
+		if (!bSucceeded)
+		{
+			UE_LOG(MYPLog, Warning, TEXT("Some fights couldn't be simulated, the results are incomplete"));
+		}
+
+		const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+		UE_LOG(MYPLog, Display, TEXT("Simulated %d fights in %.1f s, %.0f fights per hour"), Results.Num(), WallSeconds, WallSeconds > 0.0 ? Results.Num() * 3600.0 / WallSeconds : 0.0);
+
+		TArray<FCombatSimulationSummary> Summaries;
+		FCombatSimulationHost::Summarize(Config, Results, Summaries);
+		FCombatSimulationHost::LogSummaries(Summaries);
+		FCombatSimulationHost::SaveResults(Output, Results, Summaries);
+	}));
+
+namespace CombatSimulation
+{
+	/** Returns true if the actor's class, or one of its parents, has the given name */
+	static bool IsOfClassNamed(const AActor* Actor, const FString& ClassName)
+	{
+		for (const UClass* Class = Actor->GetClass(); Class; Class = Class->GetSuperClass())
+		{
+			if (Class->GetName() == ClassName)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 *  A single fight, in a world of its own.
+	 *  The world is set up and play begins on construction, and it's torn down on destruction.
+	 */
+	class FFight
+	{
+		/** World the fight takes place in. Declared first, so it's the last thing torn down */
+		FMYPHeadlessWorld HeadlessWorld;
+
+		/** Config shared by every fight */
+		const FCombatSimulationConfig& Config;
+
+		/** Overrides for this fight */
+		const FCombatSimulationParameterSet& ParameterSet;
+
+		/** Character the bot plays as */
+		TWeakObjectPtr<ACombatCharacter> Character;
+
+		/** Spawners in the level. The fight is cleared when they're all depleted */
+		TArray<TWeakObjectPtr<ACombatEnemySpawner>> Spawners;
+
+		/** Enemies placed in the level rather than spawned. Killing them doesn't bring any spawner closer to depletion */
+		TSet<TObjectKey<AActor>> PlacedEnemies;
+
+		/** Enemy deaths the spawners needed to be depleted when the fight started */
+		int32 InitialEnemiesLeft = 0;
+
+		/** Kills of enemies that came from a spawner */
+		int32 SpawnedEnemiesKilled = 0;
+
+		/** Outcome so far */
+		FCombatSimulationResult Result;
+
+		/** Real time the fight started at */
+		double StartTime = 0.0;
+
+		/** If true, the fight is over or couldn't start */
+		bool bFinished = false;
+
+	public:
+
+		FFight(const FCombatSimulationConfig& InConfig, int32 Job);
+
+		/** Returns true if the level loaded and the bot has a character to play. Only meaningful before the fight is stepped */
+		bool IsValid() const { return Character.IsValid(); }
+
+		/** Returns true once the fight is over */
+		bool IsFinished() const { return bFinished; }
+
+		/** Returns the outcome */
+		const FCombatSimulationResult& GetResult() const { return Result; }
+
+		/** Advances the fight by one time step, and checks whether it's over */
+		void Step();
+
+	protected:
+
+		/** Applies the parameter set's overrides to a loaded or spawning actor */
+		void ApplyOverrides(AActor* Actor) const;
+
+		/** Spawns the bot and its character at the level's player start */
+		void SpawnBot();
+
+		/** Ends the fight */
+		void Finish();
+	};
+
+	FFight::FFight(const FCombatSimulationConfig& InConfig, int32 Job)
+		: HeadlessWorld(FName(*FString::Printf(TEXT("CombatSim_%d"), Job)), InConfig.LevelPath)
+		, Config(InConfig)
+		, ParameterSet(InConfig.ParameterSets[Job / InConfig.RunsPerSet])
+	{
+		Result.Job = Job;
+		Result.ParameterSet = ParameterSet.Name;
+		Result.Seed = InConfig.Seed + Job % InConfig.RunsPerSet;
+
+		StartTime = FPlatformTime::Seconds();
+
+		if (!HeadlessWorld.HasLevel())
+		{
+			bFinished = true;
+			return;
+		}
+
+		UWorld* World = HeadlessWorld.GetWorld();
+
+		// adjust the level's actors before they begin play, and anything spawned later before it's initialized
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			ApplyOverrides(*It);
+
+			if (It->IsA<ACombatEnemy>())
+			{
+				PlacedEnemies.Add(*It);
+			}
+		}
+
+		World->AddOnActorPreSpawnInitialization(FOnActorSpawned::FDelegate::CreateRaw(this, &FFight::ApplyOverrides));
+
+		// seed the world before anything draws from it
+		if (UMYPRandomSubsystem* Random = UMYPRandomSubsystem::Get(World))
+		{
+			Random->SetWorldSeed(Result.Seed);
+		}
+
+		HeadlessWorld.BeginPlay();
+
+		SpawnBot();
+
+		if (!Character.IsValid())
+		{
+			bFinished = true;
+			return;
+		}
+
+		for (TActorIterator<ACombatEnemySpawner> It(World); It; ++It)
+		{
+			Spawners.Add(*It);
+			InitialEnemiesLeft += It->GetEnemiesLeft();
+
+			if (Config.bActivateAllSpawners)
+			{
+				It->ActivateInteraction(Character.Get());
+			}
+		}
+
+		// count the kills
+		if (UMYPMessageSubsystem* Messages = UMYPMessageSubsystem::Get(World))
+		{
+			Messages->Subscribe<FCombatEnemyDiedMessage>(CombatChannels::EnemyDied, Character.Get(), [this](FName Channel, const FCombatEnemyDiedMessage& Message)
+			{
+				++Result.EnemiesKilled;
+
+				if (!PlacedEnemies.Contains(Message.Instigator.Get()))
+				{
+					++SpawnedEnemiesKilled;
+				}
+			});
+		}
+
+		// and the damage the bot takes. The modifier only reads the event
+		if (UCombatDamageSubsystem* DamageSubsystem = World->GetSubsystem<UCombatDamageSubsystem>())
+		{
+			DamageSubsystem->AddDamageModifier(FOnModifyCombatDamage::FDelegate::CreateLambda([this](FCombatDamageEvent& DamageEvent)
+			{
+				if (DamageEvent.Target.Get() == Character.Get())
+				{
+					Result.DamageTaken += DamageEvent.Damage;
+				}
+			}));
+		}
+	}
+
+	void FFight::ApplyOverrides(AActor* Actor) const
+	{
+		for (const FCombatSimulationOverride& Override : ParameterSet.Overrides)
+		{
+			if (!IsOfClassNamed(Actor, Override.ClassName))
+			{
+				continue;
+			}
+
+			const FProperty* Property = FindFProperty<FProperty>(Actor->GetClass(), Override.PropertyName);
+
+			if (!Property || !Property->ImportText_InContainer(*Override.Value, Actor, Actor, PPF_None))
+			{
+				UE_LOG(MYPLog, Warning, TEXT("%s: couldn't set %s.%s to '%s'"), *ParameterSet.Name, *Override.ClassName, *Override.PropertyName.ToString(), *Override.Value);
+			}
+		}
+	}
+
+	void FFight::SpawnBot()
+	{
+		UWorld* World = HeadlessWorld.GetWorld();
+
+		UClass* CharacterClass = ::LoadClass<ACombatCharacter>(nullptr, *Config.CharacterClassPath);
+
+		if (!CharacterClass)
+		{
+			UE_LOG(MYPLog, Error, TEXT("Couldn't load the simulated character %s"), *Config.CharacterClassPath);
+			return;
+		}
+
+		FTransform SpawnTransform = FTransform::Identity;
+
+		TActorIterator<APlayerStart> PlayerStartIt(World);
+
+		if (PlayerStartIt)
+		{
+			SpawnTransform = PlayerStartIt->GetActorTransform();
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		ACombatCharacter* SpawnedCharacter = World->SpawnActor<ACombatCharacter>(CharacterClass, SpawnTransform, SpawnParams);
+		ACombatSimulationBot* Bot = World->SpawnActor<ACombatSimulationBot>(SpawnParams);
+
+		if (SpawnedCharacter && Bot)
+		{
+			Bot->Possess(SpawnedCharacter);
+			Character = SpawnedCharacter;
+		}
+	}
+
+	void FFight::Step()
+	{
+		if (bFinished)
+		{
+			return;
+		}
+
+		HeadlessWorld.Tick(Config.TimeStep);
+		Result.SimSeconds += Config.TimeStep;
+
+		// a dead character waits to respawn, which a real player would count as a loss
+		const ACombatCharacter* CurrentCharacter = Character.Get();
+
+		if (!CurrentCharacter || CurrentCharacter->IsDead())
+		{
+			Result.bBotDied = true;
+			Finish();
+			return;
+		}
+
+		int32 EnemiesLeft = 0;
+
+		for (const TWeakObjectPtr<ACombatEnemySpawner>& Spawner : Spawners)
+		{
+			if (Spawner.IsValid())
+			{
+				EnemiesLeft += Spawner->GetEnemiesLeft();
+			}
+		}
+
+		// the spawners hear about deaths on the same message as the kill count, so by now every kill should have brought one closer
+		// to depletion. If not, the spawners are missing deaths and the fight can only time out
+		ensureMsgf(InitialEnemiesLeft - EnemiesLeft >= SpawnedEnemiesKilled, TEXT("Fight %d: %d spawned enemies were killed, but the spawners only counted %d deaths"),
+			Result.Job, SpawnedEnemiesKilled, InitialEnemiesLeft - EnemiesLeft);
+
+		if (EnemiesLeft == 0)
+		{
+			Result.bCleared = true;
+			Finish();
+		}
+		else if (Result.SimSeconds >= Config.MaxSimTime)
+		{
+			Finish();
+		}
+	}
+
+	void FFight::Finish()
+	{
+		bFinished = true;
+		Result.WallSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const TCHAR* Outcome = Result.bCleared ? TEXT("cleared") : Result.bBotDied ? TEXT("died") : TEXT("timed out");
+
+		UE_LOG(MYPLog, Display, TEXT("Fight %d (%s, seed %d) %s after %.1f s, %.1f damage taken, %d kills, simulated in %.2f s"),
+			Result.Job, *Result.ParameterSet, Result.Seed, Outcome, Result.SimSeconds, Result.DamageTaken, Result.EnemiesKilled, Result.WallSeconds);
+	}
+}
+
+bool FCombatSimulationConfig::LoadFromFile(const FString& Filename)
+{
+	FString Json;
+	TSharedPtr<FJsonObject> Root;
+
+	if (!FFileHelper::LoadFileToString(Json, *Filename) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+	{
+		UE_LOG(MYPLog, Error, TEXT("Couldn't read the simulation config %s"), *Filename);
+		return false;
+	}
+
+	Root->TryGetStringField(TEXT("Level"), LevelPath);
+	Root->TryGetStringField(TEXT("Character"), CharacterClassPath);
+	Root->TryGetNumberField(TEXT("Runs"), RunsPerSet);
+	Root->TryGetNumberField(TEXT("TimeStep"), TimeStep);
+	Root->TryGetNumberField(TEXT("MaxSimTime"), MaxSimTime);
+	Root->TryGetNumberField(TEXT("Seed"), Seed);
+	Root->TryGetBoolField(TEXT("ActivateAllSpawners"), bActivateAllSpawners);
+
+	RunsPerSet = FMath::Max(RunsPerSet, 1);
+	TimeStep = FMath::Max(TimeStep, UE_KINDA_SMALL_NUMBER);
+
+	ParameterSets.Reset();
+
+	const TArray<TSharedPtr<FJsonValue>>* SetValues = nullptr;
+
+	if (Root->TryGetArrayField(TEXT("ParameterSets"), SetValues))
+	{
+		for (const TSharedPtr<FJsonValue>& SetValue : *SetValues)
+		{
+			const TSharedPtr<FJsonObject>* SetObject = nullptr;
+
+			if (!SetValue->TryGetObject(SetObject))
+			{
+				continue;
+			}
+
+			FCombatSimulationParameterSet& ParameterSet = ParameterSets.AddDefaulted_GetRef();
+
+			if (!(*SetObject)->TryGetStringField(TEXT("Name"), ParameterSet.Name))
+			{
+				ParameterSet.Name = FString::Printf(TEXT("Set%d"), ParameterSets.Num() - 1);
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>* OverrideValues = nullptr;
+
+			if (!(*SetObject)->TryGetArrayField(TEXT("Overrides"), OverrideValues))
+			{
+				continue;
+			}
+
+			for (const TSharedPtr<FJsonValue>& OverrideValue : *OverrideValues)
+			{
+				const TSharedPtr<FJsonObject>* OverrideObject = nullptr;
+
+				if (!OverrideValue->TryGetObject(OverrideObject))
+				{
+					continue;
+				}
+
+				// values may be written as JSON numbers or strings, either reads back as text
+				FCombatSimulationOverride& Override = ParameterSet.Overrides.AddDefaulted_GetRef();
+				FString PropertyName;
+
+				(*OverrideObject)->TryGetStringField(TEXT("Class"), Override.ClassName);
+				(*OverrideObject)->TryGetStringField(TEXT("Property"), PropertyName);
+				(*OverrideObject)->TryGetStringField(TEXT("Value"), Override.Value);
+
+				Override.PropertyName = FName(*PropertyName);
+			}
+		}
+	}
+
+	// with no parameter sets, simulate the level as authored
+	if (ParameterSets.IsEmpty())
+	{
+		ParameterSets.AddDefaulted_GetRef().Name = TEXT("Default");
+	}
+
+	return true;
+}
+
+bool FCombatSimulationHost::RunJobs(const FCombatSimulationConfig& Config, int32 FirstJob, int32 LastJob, int32 NumWorlds, TArray<FCombatSimulationResult>& OutResults)
+{
+	FirstJob = FMath::Max(FirstJob, 0);
+	LastJob = FMath::Min(LastJob, Config.GetNumJobs() - 1);
+	NumWorlds = FMath::Max(NumWorlds, 1);
+
+	UE_LOG(MYPLog, Display, TEXT("Simulating fights %d to %d, %d at a time"), FirstJob, LastJob, NumWorlds);
+
+	TArray<TUniquePtr<CombatSimulation::FFight>> Fights;
+	int32 NextJob = FirstJob;
+
+	while (NextJob <= LastJob || !Fights.IsEmpty())
+	{
+		// keep every world busy
+		while (Fights.Num() < NumWorlds && NextJob <= LastJob)
+		{
+			TUniquePtr<CombatSimulation::FFight> Fight = MakeUnique<CombatSimulation::FFight>(Config, NextJob++);
+
+			// the level or the character is missing, so every other fight would fail the same way
+			if (!Fight->IsValid())
+			{
+				UE_LOG(MYPLog, Error, TEXT("Couldn't set up a fight in %s, stopping"), *Config.LevelPath);
+
+				Fights.Reset();
+				CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+				return false;
+			}
+
+			Fights.Add(MoveTemp(Fight));
+		}
+
+		// the worlds share a frame, as they would share the engine loop
+		++GFrameCounter;
+
+		for (const TUniquePtr<CombatSimulation::FFight>& Fight : Fights)
+		{
+			Fight->Step();
+		}
+
+		// retire the finished fights, freeing their worlds for the next jobs
+		const int32 NumFinished = Fights.RemoveAll([&OutResults](const TUniquePtr<CombatSimulation::FFight>& Fight)
+		{
+			if (Fight->IsFinished())
+			{
+				OutResults.Add(Fight->GetResult());
+				return true;
+			}
+
+			return false;
+		});
+
+		if (NumFinished > 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		// the engine loop isn't running, so let the hang detector know we're still going
+		FThreadHeartBeat::Get().HeartBeat();
+	}
+
+	return true;
+}
+
+bool FCombatSimulationHost::RunWorkers(const FString& ConfigFile, const FCombatSimulationConfig& Config, int32 NumWorkers, int32 WorldsPerWorker, const FString& Output, TArray<FCombatSimulationResult>& OutResults)
+{
+	const int32 NumJobs = Config.GetNumJobs();
+	NumWorkers = FMath::Clamp(NumWorkers, 1, NumJobs);
+
+	// the editor binary needs to be told which project to run, and to run it as a game
+	FString BaseParams;
+
+#if WITH_EDITOR
+	BaseParams = FString::Printf(TEXT("\"%s\" -game "), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()));
+#endif
+
+	BaseParams += TEXT("-nullrhi -nosound -nosplash -unattended -NoVerifyGC");
+
+	TArray<FProcHandle> Workers;
+	TArray<FString> WorkerOutputs;
+
+	for (int32 Worker = 0; Worker < NumWorkers; ++Worker)
+	{
+		// split the jobs into contiguous ranges as even as they can be
+		const int32 FirstJob = NumJobs * Worker / NumWorkers;
+		const int32 LastJob = NumJobs * (Worker + 1) / NumWorkers - 1;
+
+		const FString WorkerOutput = FPaths::ConvertRelativePathToFull(FPaths::GetBaseFilename(Output, false) + FString::Printf(TEXT(".Worker%d.json"), Worker));
+
+		// paths go in switches of their own, quoted, since they may hold spaces or the commas -ExecCmds splits commands on
+		const FString Params = FString::Printf(TEXT("%s -CombatSimConfig=\"%s\" -CombatSimOutput=\"%s\" -ExecCmds=\"Combat.Sim.Run Worlds=%d Jobs=%d-%d,quit\""),
+			*BaseParams, *ConfigFile, *WorkerOutput, WorldsPerWorker, FirstJob, LastJob);
+
+		FProcHandle Handle = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Params, false, true, true, nullptr, 0, nullptr, nullptr);
+
+		if (!Handle.IsValid())
+		{
+			UE_LOG(MYPLog, Error, TEXT("Couldn't launch simulation worker %d"), Worker);
+			continue;
+		}
+
+		UE_LOG(MYPLog, Display, TEXT("Launched simulation worker %d with fights %d to %d"), Worker, FirstJob, LastJob);
+
+		Workers.Add(Handle);
+		WorkerOutputs.Add(WorkerOutput);
+	}
+
+	bool bSucceeded = Workers.Num() == NumWorkers;
+
+	for (int32 Worker = 0; Worker < Workers.Num(); ++Worker)
+	{
+		FPlatformProcess::WaitForProc(Workers[Worker]);
+
+		int32 ReturnCode = 0;
+		FPlatformProcess::GetProcReturnCode(Workers[Worker], &ReturnCode);
+		FPlatformProcess::CloseProc(Workers[Worker]);
+
+		if (ReturnCode != 0 || !LoadResults(WorkerOutputs[Worker], OutResults))
+		{
+			UE_LOG(MYPLog, Error, TEXT("Simulation worker %d failed with code %d"), Worker, ReturnCode);
+			bSucceeded = false;
+		}
+
+		IFileManager::Get().Delete(*WorkerOutputs[Worker], false, false, true);
+	}
+
+	// put the results back in job order, however the workers finished
+	OutResults.Sort([](const FCombatSimulationResult& A, const FCombatSimulationResult& B) { return A.Job < B.Job; });
+
+	return bSucceeded;
+}
+
+void FCombatSimulationHost::Summarize(const FCombatSimulationConfig& Config, TConstArrayView<FCombatSimulationResult> Results, TArray<FCombatSimulationSummary>& OutSummaries)
+{
+	OutSummaries.Reset();
+
+	TArray<float> ClearTimes;
+
+	for (const FCombatSimulationParameterSet& ParameterSet : Config.ParameterSets)
+	{
+		FCombatSimulationSummary& Summary = OutSummaries.AddDefaulted_GetRef();
+		Summary.ParameterSet = ParameterSet.Name;
+
+		ClearTimes.Reset();
+
+		for (const FCombatSimulationResult& Result : Results)
+		{
+			if (Result.ParameterSet != ParameterSet.Name)
+			{
+				continue;
+			}
+
+			++Summary.Runs;
+			Summary.MeanDamageTaken += Result.DamageTaken;
+			Summary.MeanEnemiesKilled += Result.EnemiesKilled;
+
+			if (Result.bBotDied)
+			{
+				++Summary.Deaths;
+			}
+
+			if (Result.bCleared)
+			{
+				++Summary.Clears;
+				ClearTimes.Add(Result.SimSeconds);
+			}
+		}
+
+		if (Summary.Runs > 0)
+		{
+			Summary.MeanDamageTaken /= Summary.Runs;
+			Summary.MeanEnemiesKilled /= Summary.Runs;
+		}
+
+		if (!ClearTimes.IsEmpty())
+		{
+			ClearTimes.Sort();
+
+			float Sum = 0.0f;
+
+			for (const float ClearTime : ClearTimes)
+			{
+				Sum += ClearTime;
+			}
+
+			Summary.MeanTimeToClear = Sum / ClearTimes.Num();
+			Summary.MedianTimeToClear = ClearTimes[ClearTimes.Num() / 2];
+		}
+	}
+}
+
+bool FCombatSimulationHost::SaveResults(const FString& Filename, TConstArrayView<FCombatSimulationResult> Results, TConstArrayView<FCombatSimulationSummary> Summaries)
+{
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+	Root->SetStringField(TEXT("Machine"), FPlatformProcess::ComputerName());
+
+	TArray<TSharedPtr<FJsonValue>> SummaryValues;
+
+	for (const FCombatSimulationSummary& Summary : Summaries)
+	{
+		TSharedRef<FJsonObject> SummaryObject = MakeShared<FJsonObject>();
+		SummaryObject->SetStringField(TEXT("ParameterSet"), Summary.ParameterSet);
+		SummaryObject->SetNumberField(TEXT("Runs"), Summary.Runs);
+		SummaryObject->SetNumberField(TEXT("Clears"), Summary.Clears);
+		SummaryObject->SetNumberField(TEXT("Deaths"), Summary.Deaths);
+		SummaryObject->SetNumberField(TEXT("MeanTimeToClear"), Summary.MeanTimeToClear);
+		SummaryObject->SetNumberField(TEXT("MedianTimeToClear"), Summary.MedianTimeToClear);
+		SummaryObject->SetNumberField(TEXT("MeanDamageTaken"), Summary.MeanDamageTaken);
+		SummaryObject->SetNumberField(TEXT("MeanEnemiesKilled"), Summary.MeanEnemiesKilled);
+
+		SummaryValues.Add(MakeShared<FJsonValueObject>(SummaryObject));
+	}
+
+	Root->SetArrayField(TEXT("Summaries"), SummaryValues);
+
+	TArray<TSharedPtr<FJsonValue>> ResultValues;
+
+	for (const FCombatSimulationResult& Result : Results)
+	{
+		TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+		ResultObject->SetNumberField(TEXT("Job"), Result.Job);
+		ResultObject->SetStringField(TEXT("ParameterSet"), Result.ParameterSet);
+		ResultObject->SetNumberField(TEXT("Seed"), Result.Seed);
+		ResultObject->SetBoolField(TEXT("Cleared"), Result.bCleared);
+		ResultObject->SetBoolField(TEXT("BotDied"), Result.bBotDied);
+		ResultObject->SetNumberField(TEXT("SimSeconds"), Result.SimSeconds);
+		ResultObject->SetNumberField(TEXT("DamageTaken"), Result.DamageTaken);
+		ResultObject->SetNumberField(TEXT("EnemiesKilled"), Result.EnemiesKilled);
+		ResultObject->SetNumberField(TEXT("WallSeconds"), Result.WallSeconds);
+
+		ResultValues.Add(MakeShared<FJsonValueObject>(ResultObject));
+	}
+
+	Root->SetArrayField(TEXT("Results"), ResultValues);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+	if (!FJsonSerializer::Serialize(Root, Writer) || !FFileHelper::SaveStringToFile(Json, *Filename))
+	{
+		UE_LOG(MYPLog, Error, TEXT("Couldn't write the simulation results to %s"), *Filename);
+		return false;
+	}
+
+	UE_LOG(MYPLog, Display, TEXT("Wrote %d simulation results to %s"), Results.Num(), *FPaths::ConvertRelativePathToFull(Filename));
+	return true;
+}
+
+bool FCombatSimulationHost::LoadResults(const FString& Filename, TArray<FCombatSimulationResult>& OutResults)
+{
+	FString Json;
+	TSharedPtr<FJsonObject> Root;
+
+	if (!FFileHelper::LoadFileToString(Json, *Filename) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+	{
+		UE_LOG(MYPLog, Error, TEXT("Couldn't read simulation results from %s"), *Filename);
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* ResultValues = nullptr;
+
+	if (Root->TryGetArrayField(TEXT("Results"), ResultValues))
+	{
+		for (const TSharedPtr<FJsonValue>& ResultValue : *ResultValues)
+		{
+			const TSharedPtr<FJsonObject>* ResultObject = nullptr;
+
+			if (!ResultValue->TryGetObject(ResultObject))
+			{
+				continue;
+			}
+
+			FCombatSimulationResult& Result = OutResults.AddDefaulted_GetRef();
+			(*ResultObject)->TryGetNumberField(TEXT("Job"), Result.Job);
+			(*ResultObject)->TryGetStringField(TEXT("ParameterSet"), Result.ParameterSet);
+			(*ResultObject)->TryGetNumberField(TEXT("Seed"), Result.Seed);
+			(*ResultObject)->TryGetBoolField(TEXT("Cleared"), Result.bCleared);
+			(*ResultObject)->TryGetBoolField(TEXT("BotDied"), Result.bBotDied);
+			(*ResultObject)->TryGetNumberField(TEXT("SimSeconds"), Result.SimSeconds);
+			(*ResultObject)->TryGetNumberField(TEXT("DamageTaken"), Result.DamageTaken);
+			(*ResultObject)->TryGetNumberField(TEXT("EnemiesKilled"), Result.EnemiesKilled);
+			(*ResultObject)->TryGetNumberField(TEXT("WallSeconds"), Result.WallSeconds);
+		}
+	}
+
+	return true;
+}
+
+void FCombatSimulationHost::LogSummaries(TConstArrayView<FCombatSimulationSummary> Summaries)
+{
+	UE_LOG(MYPLog, Display, TEXT("%-32s %6s %7s %7s %10s %10s %10s %8s"), TEXT("Parameter set"), TEXT("Runs"), TEXT("Clears"), TEXT("Deaths"), TEXT("Mean clear"), TEXT("Median"), TEXT("Damage"), TEXT("Kills"));
+
+	for (const FCombatSimulationSummary& Summary : Summaries)
+	{
+		UE_LOG(MYPLog, Display, TEXT("%-32s %6d %7d %7d %9.1fs %9.1fs %10.2f %8.1f"), *Summary.ParameterSet, Summary.Runs, Summary.Clears, Summary.Deaths,
+			Summary.MeanTimeToClear, Summary.MedianTimeToClear, Summary.MeanDamageTaken, Summary.MeanEnemiesKilled);
+	}
+}
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,168 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ *  Sets a property on every actor of a class, as the actor is loaded or spawned
+ */
+struct FCombatSimulationOverride
+{
+	/** Native or Blueprint class name, as in CombatEnemy or BP_CombatEnemy_C. Subclasses match too */
+	FString ClassName;
+
+	/** Property to set */
+	FName PropertyName;
+
+	/** Value in the property's text format */
+	FString Value;
+};
+
+/**
+ *  A named set of overrides to simulate. Results are grouped by it
+ */
+struct FCombatSimulationParameterSet
+{
+	/** Name the results are reported under */
+	FString Name;
+
+	/** Overrides applied to the level and everything spawned into it */
+	TArray<FCombatSimulationOverride> Overrides;
+};
+
+/**
+ *  What to simulate and how, read from a JSON file:
+ *  { "Level": "/Game/Variant_Combat/Lvl_Combat", "Runs": 20, "TimeStep": 0.0333, "MaxSimTime": 600, "Seed": 1,
+ *    "ParameterSets": [ { "Name": "SlowCharge", "Overrides": [ { "Class": "CombatEnemy", "Property": "MinChargeLoops", "Value": 4 } ] } ] }
+ */
+struct FCombatSimulationConfig
+{
+	/** Level every fight takes place in */
+	FString LevelPath = TEXT("/Game/Variant_Combat/Lvl_Combat");
+
+	/** Character the bot plays as */
+	FString CharacterClassPath = TEXT("/Game/Variant_Combat/Blueprints/BP_CombatCharacter.BP_CombatCharacter_C");
+
+	/** Fights simulated for each parameter set */
+	int32 RunsPerSet = 10;
+
+	/** Fixed time step every world is advanced by */
+	float TimeStep = 1.0f / 30.0f;
+
+	/** Simulated time after which a fight is given up on */
+	float MaxSimTime = 600.0f;
+
+	/** Seed of each parameter set's first run. Later runs count up from it, so run N of every set plays out from the same seed */
+	int32 Seed = 0;
+
+	/** If true, spawners waiting for an activation volume start right away instead */
+	bool bActivateAllSpawners = false;
+
+	/** Parameter sets to compare */
+	TArray<FCombatSimulationParameterSet> ParameterSets;
+
+	/** Reads the config. Returns false if the file is missing or isn't valid JSON */
+	bool LoadFromFile(const FString& Filename);
+
+	/** Returns the total number of fights, one job each */
+	int32 GetNumJobs() const { return ParameterSets.Num() * RunsPerSet; }
+};
+
+/**
+ *  Outcome of one simulated fight
+ */
+struct FCombatSimulationResult
+{
+	/** Job the fight was run for */
+	int32 Job = INDEX_NONE;
+
+	/** Parameter set the fight was run with */
+	FString ParameterSet;
+
+	/** Random seed of the fight's world. Simulating the same job with the same config plays the same fight again */
+	int32 Seed = 0;
+
+	/** If true, every spawner in the level was depleted */
+	bool bCleared = false;
+
+	/** If true, the bot's character died first */
+	bool bBotDied = false;
+
+	/** Simulated time the fight lasted */
+	float SimSeconds = 0.0f;
+
+	/** Damage dealt to the bot's character, including any overkill */
+	float DamageTaken = 0.0f;
+
+	/** Enemies that died during the fight */
+	int32 EnemiesKilled = 0;
+
+	/** Real time the fight took to simulate */
+	double WallSeconds = 0.0;
+};
+
+/**
+ *  Results of one parameter set, summed over its fights
+ */
+struct FCombatSimulationSummary
+{
+	/** Parameter set name */
+	FString ParameterSet;
+
+	/** Fights simulated */
+	int32 Runs = 0;
+
+	/** Fights that ended with the level cleared */
+	int32 Clears = 0;
+
+	/** Fights that ended with the bot dead */
+	int32 Deaths = 0;
+
+	/** Mean time to clear, over the cleared fights only */
+	float MeanTimeToClear = 0.0f;
+
+	/** Median time to clear, over the cleared fights only */
+	float MedianTimeToClear = 0.0f;
+
+	/** Mean damage taken per fight */
+	float MeanDamageTaken = 0.0f;
+
+	/** Mean enemies killed per fight */
+	float MeanEnemiesKilled = 0.0f;
+};
+
+/**
+ *  Runs headless fights for balancing, many worlds at a time.
+ *  Each world loads its own copy of the level, applies its parameter set's overrides and lets a scripted bot play it
+ *  at a fixed time step, as fast as the machine allows. Worlds have to tick on the game thread, so a process runs
+ *  its worlds in turn, and spreading the jobs over worker processes is what uses the other cores.
+ *  Run with Combat.Sim.Run, usually from the command line of a headless game launch:
+ *    -game -nullrhi -nosound -unattended -ExecCmds="Combat.Sim.Run Config=<file> Workers=<cores>,quit"
+ */
+class FCombatSimulationHost
+{
+public:
+
+	/** Simulates jobs FirstJob to LastJob, inclusive, in this process, with up to NumWorlds fights at a time. Returns false if a world couldn't be set up */
+	static bool RunJobs(const FCombatSimulationConfig& Config, int32 FirstJob, int32 LastJob, int32 NumWorlds, TArray<FCombatSimulationResult>& OutResults);
+
+	/** Splits every job between worker processes, waits for them and gathers their results. Returns false if any worker failed */
+	static bool RunWorkers(const FString& ConfigFile, const FCombatSimulationConfig& Config, int32 NumWorkers, int32 WorldsPerWorker, const FString& Output, TArray<FCombatSimulationResult>& OutResults);
+
+	/** Sums the results for each parameter set, in the config's order */
+	static void Summarize(const FCombatSimulationConfig& Config, TConstArrayView<FCombatSimulationResult> Results, TArray<FCombatSimulationSummary>& OutSummaries);
+
+	/** Writes the results, and their summaries if there are any */
+	static bool SaveResults(const FString& Filename, TConstArrayView<FCombatSimulationResult> Results, TConstArrayView<FCombatSimulationSummary> Summaries);
+
+	/** Reads the results written by SaveResults, appending them */
+	static bool LoadResults(const FString& Filename, TArray<FCombatSimulationResult>& OutResults);
+
+	/** Logs a table of the summaries */
+	static void LogSummaries(TConstArrayView<FCombatSimulationSummary> Summaries);
+};
+
+#endif // !UE_BUILD_SHIPPING
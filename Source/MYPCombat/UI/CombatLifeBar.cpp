@@ -0,0 +1,34 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatLifeBar.h"
+#include "Components/ProgressBar.h"
+#include "MYP.h"
+
+void UCombatLifeBar::UpdateLifePercentage(float Percent)
+{
+	if (LifeBarFill)
+	{
+		LifeBarFill->SetPercent(Percent);
+	}
+
+	if (ShouldCallBlueprintEvents())
+	{
+		MYP_COUNT_BLUEPRINT_EVENT();
+		SetLifePercentage(Percent);
+	}
+}
+
+void UCombatLifeBar::UpdateBarColor(FLinearColor Color)
+{
+	if (LifeBarFill)
+	{
+		LifeBarFill->SetFillColorAndOpacity(Color);
+	}
+
+	if (ShouldCallBlueprintEvents())
+	{
+		MYP_COUNT_BLUEPRINT_EVENT();
+		SetBarColor(Color);
+	}
+}
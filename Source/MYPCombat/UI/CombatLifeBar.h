@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "CombatLifeBar.generated.h"
+
+class UProgressBar;
+
+/**
+ *  A basic life bar user widget.
+ *  If the widget has a progress bar named LifeBarFill, it's updated natively. Otherwise the Blueprint events are called.
+ */
+UCLASS(abstract)
+class UCombatLifeBar : public UUserWidget
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Progress bar driven natively, if the widget has one */
+	UPROPERTY(BlueprintReadOnly, Category="Life Bar", meta = (BindWidgetOptional))
+	TObjectPtr<UProgressBar> LifeBarFill;
+
+	/** If true, the Blueprint events are called even if the progress bar is updated natively */
+	UPROPERTY(EditAnywhere, Category="Life Bar")
+	bool bUseBlueprintEvents = false;
+
+public:
+
+	/** Updates the life bar to the provided 0-1 percentage value */
+	void UpdateLifePercentage(float Percent);
+
+	/** Updates the life bar fill color */
+	void UpdateBarColor(FLinearColor Color);
+
+protected:
+
+	/** Returns true if the Blueprint events need to be called */
+	bool ShouldCallBlueprintEvents() const { return bUseBlueprintEvents || !LifeBarFill; }
+
+	/** Sets the life bar to the provided 0-1 percentage value*/
+	UFUNCTION(BlueprintImplementableEvent, Category="Life Bar")
+	void SetLifePercentage(float Percent);
+
+	// Sets the life bar fill color
+	UFUNCTION(BlueprintImplementableEvent, Category="Life Bar")
+	void SetBarColor(FLinearColor Color);
+};
@@ -10,6 +10,6 @@ public class MYPEditorTarget : TargetRules
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_6;
-		ExtraModuleNames.Add("MYP");
+		ExtraModuleNames.AddRange(new string[] { "MYP", "MYPCombat", "MYPPlatforming", "MYPSideScrolling" });
 	}
 }
@@ -5,7 +5,7 @@
 #include "PlatformingCharacter.h"
 #include "Components/SkeletalMeshComponent.h"
 
-void UAnimNotify_EndDash::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+void UAnimNotify_EndDash::FireGameplayNotify(USkeletalMeshComponent* MeshComp)
 {
 	// cast the owner to the attacker interface
 	if (APlatformingCharacter* PlatformingCharacter = Cast<APlatformingCharacter>(MeshComp->GetOwner()))
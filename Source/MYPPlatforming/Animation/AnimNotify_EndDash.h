@@ -3,21 +3,21 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Animation/AnimNotifies/AnimNotify.h"
+#include "MYPGameplayAnimNotify.h"
 #include "AnimNotify_EndDash.generated.h"
 
 /**
  *  AnimNotify to finish the dash animation and restore player control
  */
 UCLASS()
-class UAnimNotify_EndDash : public UAnimNotify
+class UAnimNotify_EndDash : public UMYPGameplayAnimNotify
 {
 	GENERATED_BODY()
 	
 public:
 
-	/** Perform the Anim Notify */
-	virtual void Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
+	/** Perform the gameplay logic for the Anim Notify */
+	virtual void FireGameplayNotify(USkeletalMeshComponent* MeshComp) override;
 
 	/** Get the notify name */
 	virtual FString GetNotifyName_Implementation() const override;
@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class MYPPlatforming : ModuleRules
+{
+	public MYPPlatforming(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] {
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"InputCore",
+			"EnhancedInput",
+			"UMG",
+			"Slate",
+			"MYP"
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[] {
+			"Niagara"
+		});
+
+		// nothing outside this module includes its headers, so its folders stay private
+		PrivateIncludePaths.AddRange(new string[] {
+			"MYPPlatforming",
+			"MYPPlatforming/Animation"
+		});
+	}
+}
@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPBenchmark.h"
+
+#if MYP_WITH_BENCHMARKS
+
+#include "Engine/HitResult.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "PlatformingCharacter.h"
+
+namespace PlatformingBenchmarks
+{
+	static const TCHAR* CharacterClassPath = TEXT("/Game/Variant_Platforming/Blueprints/BP_PlatformingCharacter.BP_PlatformingCharacter_C");
+
+	static void Run(FMYPBenchmarkContext& Context)
+	{
+		Context.SpawnFloor();
+
+		const TSubclassOf<APlatformingCharacter> CharacterClass = Context.LoadBlueprintClass<APlatformingCharacter>(CharacterClassPath);
+
+		if (!CharacterClass)
+		{
+			return;
+		}
+
+		APlatformingCharacter* Character = Context.SpawnActor<APlatformingCharacter>(CharacterClass, FVector(0.0f, 0.0f, 100.0f));
+
+		if (!Character)
+		{
+			return;
+		}
+
+		// settle on the floor
+		for (int32 Frame = 0; Frame < 30; ++Frame)
+		{
+			Context.TickWorld();
+		}
+
+		// landing resets the double jump and turns the jump trails off, so every iteration takes the same path
+		const auto ResetJump = [Character]()
+		{
+			Character->StopJumping();
+			Character->Landed(FHitResult());
+		};
+
+		// a regular jump
+		Context.Measure(TEXT("MultiJump.Grounded"), [](){}, [Character]() { Character->DoJumpStart(); }, ResetJump);
+
+		// high in the air, past coyote time and away from any wall, so the wall jump sweep misses and the character double jumps
+		Character->SetActorLocation(FVector(0.0f, 0.0f, 5000.0f));
+		Character->GetCharacterMovement()->SetMovementMode(MOVE_Falling);
+
+		Context.TickWorld(0.25f);
+
+		Context.Measure(TEXT("MultiJump.Airborne"), [](){}, [Character]() { Character->DoJumpStart(); }, ResetJump);
+
+		Character->Destroy();
+	}
+
+	static FMYPBenchmarkSuite Suite(TEXT("Platforming"), &Run);
+}
+
+#endif // MYP_WITH_BENCHMARKS
@@ -10,18 +10,27 @@
 #include "Camera/CameraComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "EnhancedInputComponent.h"
-#include "TimerManager.h"
+#include "MYPTimerSubsystem.h"
 #include "Engine/LocalPlayer.h"
+#include "MYPGameplayTimelineComponent.h"
+#include "PlatformingTrailProfile.h"
+#include "NiagaraComponent.h"
+#include "MYPFXSubsystem.h"
+#include "MYPTickAudit.h"
+#include "MYP.h"
+
+MYP_AUDIT_TICK(APlatformingCharacter);
 
 APlatformingCharacter::APlatformingCharacter()
 {
- 	PrimaryActorTick.bCanEverTick = true;
+ 	PrimaryActorTick.bCanEverTick = false;
 
 	// initialize the flags
 	bHasWallJumped = false;
 	bHasDoubleJumped = false;
 	bHasDashed = false;
 	bIsDashing = false;
+	bJumpTrailsActive = false;
 
 	// bind the attack montage ended delegate
 	OnDashMontageEnded.BindUObject(this, &APlatformingCharacter::DashMontageEnded);
@@ -75,6 +84,9 @@ APlatformingCharacter::APlatformingCharacter()
 	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
 	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
 	FollowCamera->bUsePawnControlRotation = false;
+
+	// create the gameplay timeline
+	GameplayTimeline = CreateDefaultSubobject<UMYPGameplayTimelineComponent>(TEXT("GameplayTimeline"));
 }
 
 void APlatformingCharacter::Move(const FInputActionValue& Value)
@@ -138,12 +150,15 @@ void APlatformingCharacter::MultiJump()
 				LaunchCharacter(WallJumpImpulse, true, true);
 
 				// enable the jump trail
-				SetJumpTrailState(true);
+				UpdateJumpTrails(true);
 
 				// raise the wall jump flag to prevent an immediate second wall jump
 				bHasWallJumped = true;
 
-				GetWorld()->GetTimerManager().SetTimer(WallJumpTimer, this, &APlatformingCharacter::ResetWallJump, DelayBetweenWallJumps, false);
+				if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+				{
+					Timers->SetTimer(WallJumpTimer, this, &APlatformingCharacter::ResetWallJump, DelayBetweenWallJumps);
+				}
 			}
 			// no wall jump, try a double jump next
 			else
@@ -157,7 +172,7 @@ void APlatformingCharacter::MultiJump()
 					Jump();
 
 					// enable the jump trail
-					SetJumpTrailState(true);
+					UpdateJumpTrails(true);
 
 				// no coyote time jump
 				} else {
@@ -171,7 +186,7 @@ void APlatformingCharacter::MultiJump()
 						Jump();
 
 						// enable the jump trail
-						SetJumpTrailState(true);
+						UpdateJumpTrails(true);
 					}
 
 				}
@@ -187,7 +202,7 @@ void APlatformingCharacter::MultiJump()
 		Jump();
 
 		// activate the jump trail
-		SetJumpTrailState(true);
+		UpdateJumpTrails(true);
 	}
 }
 
@@ -248,7 +263,7 @@ void APlatformingCharacter::DoDash()
 	GetCharacterMovement()->Velocity = FVector::ZeroVector;
 
 	// enable the jump trails
-	SetJumpTrailState(true);
+	UpdateJumpTrails(true);
 
 	// play the dash montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
@@ -259,6 +274,9 @@ void APlatformingCharacter::DoDash()
 		if (MontageLength > 0.0f)
 		{
 			AnimInstance->Montage_SetEndDelegate(OnDashMontageEnded, DashMontage);
+
+			// drive the end dash notify from the timeline
+			GameplayTimeline->PlayMontage(DashMontage, GetMesh());
 		}
 	}
 }
@@ -275,8 +293,40 @@ void APlatformingCharacter::DoJumpEnd()
 	StopJumping();
 }
 
+void APlatformingCharacter::BotMove(float Right, float Forward)
+{
+	DoMove(Right, Forward);
+}
+
+void APlatformingCharacter::BotLook(float Yaw, float Pitch)
+{
+	DoLook(Yaw, Pitch);
+}
+
+void APlatformingCharacter::BotAction(FName Action, bool bPressed)
+{
+	if (Action == MYPBotActions::Jump)
+	{
+		if (bPressed)
+		{
+			DoJumpStart();
+		}
+		else
+		{
+			DoJumpEnd();
+		}
+	}
+	else if (Action == MYPBotActions::Dash && bPressed)
+	{
+		DoDash();
+	}
+}
+
 void APlatformingCharacter::DashMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 {
+	// stop driving the montage's gameplay notifies
+	GameplayTimeline->Stop(Montage);
+
 	// if the montage was interrupted, end the dash
 	if (bInterrupted)
 	{
@@ -299,7 +349,85 @@ void APlatformingCharacter::EndDash()
 		bHasDashed = false;
 
 		// deactivate the jump trails
-		SetJumpTrailState(false);
+		UpdateJumpTrails(false);
+	}
+}
+
+void APlatformingCharacter::UpdateJumpTrails(bool bEnabled)
+{
+	// landings and chained jumps mostly ask for the state the trails are already in
+	if (bJumpTrailsActive == bEnabled)
+	{
+		return;
+	}
+
+	bJumpTrailsActive = bEnabled;
+
+	if (TrailProfile && TrailProfile->TrailDataChannel)
+	{
+		// batch the trail samples with every other trail in the world
+		if (UMYPFXSubsystem* FX = UMYPFXSubsystem::Get(this))
+		{
+			if (bEnabled)
+			{
+				for (const FName& Socket : TrailProfile->TrailSockets)
+				{
+					JumpTrailHandles.Add(FX->StartTrail(GetMesh(), Socket, TrailProfile->TrailDataChannel, TrailProfile->TrailColor));
+				}
+			}
+			else
+			{
+				for (FMYPFXTrailHandle& Handle : JumpTrailHandles)
+				{
+					FX->StopTrail(Handle);
+				}
+
+				JumpTrailHandles.Reset();
+			}
+		}
+	}
+	else if (TrailProfile && TrailProfile->TrailSystem)
+	{
+		// attach the trails the first time they're needed, and keep them around afterwards
+		if (bEnabled && JumpTrails.IsEmpty())
+		{
+			for (const FName& Socket : TrailProfile->TrailSockets)
+			{
+				UNiagaraComponent* Trail = NewObject<UNiagaraComponent>(this);
+				Trail->SetAsset(TrailProfile->TrailSystem);
+				Trail->SetAutoActivate(false);
+				Trail->SetupAttachment(GetMesh(), Socket);
+				Trail->RegisterComponent();
+				Trail->SetVariableLinearColor(TrailProfile->ColorParameter, TrailProfile->TrailColor);
+
+				JumpTrails.Add(Trail);
+			}
+		}
+
+		for (UNiagaraComponent* Trail : JumpTrails)
+		{
+			if (bEnabled)
+			{
+				Trail->Activate(true);
+			}
+			else
+			{
+				// stop emitting, but let the existing trail fade out
+				Trail->Deactivate();
+			}
+		}
+	}
+
+	if (TrailProfile && bEnabled)
+	{
+		TrailProfile->TrailStartEffect.Play(this, GetActorLocation(), GetActorRotation());
+	}
+
+	// only call into Blueprint if it's been opted into, or if there's no profile to drive the trails
+	if (bUseBlueprintTrails || !TrailProfile)
+	{
+		MYP_COUNT_BLUEPRINT_EVENT();
+		SetJumpTrailState(bEnabled);
 	}
 }
 
@@ -313,14 +441,6 @@ bool APlatformingCharacter::HasWallJumped() const
 	return bHasWallJumped;
 }
 
-void APlatformingCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
-{
-	Super::EndPlay(EndPlayReason);
-
-	// clear the wall jump reset timer
-	GetWorld()->GetTimerManager().ClearTimer(WallJumpTimer);
-}
-
 void APlatformingCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	// Set up action bindings
@@ -352,7 +472,7 @@ void APlatformingCharacter::Landed(const FHitResult& Hit)
 	bHasDashed = false;
 
 	// deactivate the jump trail
-	SetJumpTrailState(false);
+	UpdateJumpTrails(false);
 }
 
 void APlatformingCharacter::OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode /*= 0*/)
@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "Animation/AnimInstance.h"
+#include "MYPTimerSubsystem.h"
+#include "MYPFXSubsystem.h"
+#include "MYPBotInput.h"
 #include "PlatformingCharacter.generated.h"
 
 
@@ -13,6 +16,9 @@ class UCameraComponent;
 class UInputAction;
 struct FInputActionValue;
 class UAnimMontage;
+class UMYPGameplayTimelineComponent;
+class UPlatformingTrailProfile;
+class UNiagaraComponent;
 
 /**
  *  An enhanced Third Person Character with the following functionality:
@@ -23,7 +29,7 @@ class UAnimMontage;
  *  - Dash
  */
 UCLASS(abstract)
-class APlatformingCharacter : public ACharacter
+class APlatformingCharacter : public ACharacter, public IMYPBotInput
 {
 	GENERATED_BODY()
 
@@ -34,6 +40,10 @@ class APlatformingCharacter : public ACharacter
 	/** Follow camera */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* FollowCamera;
+
+	/** Fires gameplay notifies from the dash montage independently of the animation update rate */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UMYPGameplayTimelineComponent* GameplayTimeline;
 	
 protected:
 
@@ -101,11 +111,27 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Input")
 	virtual void DoJumpEnd();
 
+	// ~begin MYPBotInput interface
+
+	/** Moves the character from a bot script */
+	virtual void BotMove(float Right, float Forward) override;
+
+	/** Turns the camera from a bot script */
+	virtual void BotLook(float Yaw, float Pitch) override;
+
+	/** Presses or releases jumps and dashes from a bot script */
+	virtual void BotAction(FName Action, bool bPressed) override;
+
+	// ~end MYPBotInput interface
+
 protected:
 
 	/** Called from a delegate when the dash montage ends */
 	void DashMontageEnded(UAnimMontage* Montage, bool bInterrupted);
 
+	/** Enables or disables the jump trails natively, and calls the Blueprint handler if needed */
+	void UpdateJumpTrails(bool bEnabled);
+
 	/** Passes control to Blueprint to enable or disable jump trails */
 	UFUNCTION(BlueprintImplementableEvent, Category="Platforming")
 	void SetJumpTrailState(bool bEnabled);
@@ -126,9 +152,6 @@ public:
 	bool HasWallJumped() const;
 
 public:	
-	
-	/** EndPlay cleanup */
-	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/** Sets up input action bindings */
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
@@ -146,9 +169,25 @@ protected:
 	uint8 bHasDoubleJumped : 1;
 	uint8 bHasDashed : 1;
 	uint8 bIsDashing : 1;
+	uint8 bJumpTrailsActive : 1;
+
+	/** Jump trail settings used to drive the trails natively */
+	UPROPERTY(EditAnywhere, Category="Trail")
+	TObjectPtr<UPlatformingTrailProfile> TrailProfile;
+
+	/** If true, the SetJumpTrailState Blueprint event is called on top of the trail profile. It's always called if there's no profile */
+	UPROPERTY(EditAnywhere, Category="Trail")
+	bool bUseBlueprintTrails = false;
+
+	/** Trail components, created the first time the trails are enabled */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UNiagaraComponent>> JumpTrails;
+
+	/** Batched trails running on the FX subsystem, one per socket */
+	TArray<FMYPFXTrailHandle> JumpTrailHandles;
 
 	/** timer for wall jump input reset */
-	FTimerHandle WallJumpTimer;
+	FMYPTimerHandle WallJumpTimer;
 
 	/** Dash montage ended delegate */
 	FOnMontageEnded OnDashMontageEnded;
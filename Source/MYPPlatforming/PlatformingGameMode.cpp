@@ -1,7 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 
-#include "Variant_Platforming/PlatformingGameMode.h"
+#include "PlatformingGameMode.h"
 
 APlatformingGameMode::APlatformingGameMode()
 {
@@ -1,10 +1,10 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 
-#include "Variant_Platforming/PlatformingPlayerController.h"
+#include "PlatformingPlayerController.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputMappingContext.h"
-#include "Kismet/GameplayStatics.h"
+#include "EngineUtils.h"
 #include "GameFramework/PlayerStart.h"
 #include "PlatformingCharacter.h"
 #include "Engine/LocalPlayer.h"
@@ -72,14 +72,13 @@ void APlatformingPlayerController::OnPossess(APawn* InPawn)
 
 void APlatformingPlayerController::OnPawnDestroyed(AActor* DestroyedActor)
 {
-	// find the player start
-	TArray<AActor*> ActorList;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), APlayerStart::StaticClass(), ActorList);
+	// find the first player start, without gathering every one of them into an array
+	TActorIterator<APlayerStart> PlayerStartIt(GetWorld());
 
-	if (ActorList.Num() > 0)
+	if (PlayerStartIt)
 	{
 		// spawn a character at the player start
-		const FTransform SpawnTransform = ActorList[0]->GetActorTransform();
+		const FTransform SpawnTransform = PlayerStartIt->GetActorTransform();
 
 		if (APlatformingCharacter* RespawnedCharacter = GetWorld()->SpawnActor<APlatformingCharacter>(CharacterClass, SpawnTransform))
 		{
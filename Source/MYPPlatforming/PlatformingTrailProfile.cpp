@@ -1,4 +1,4 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 
-#include "CombatAttacker.h"
+#include "PlatformingTrailProfile.h"
@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "MYPFeedbackEffect.h"
+#include "PlatformingTrailProfile.generated.h"
+
+class UNiagaraSystem;
+class UNiagaraDataChannelAsset;
+
+/**
+ *  Jump trail settings for a platforming character.
+ *  The trails are toggled natively on jumps, wall jumps, dashes and landings.
+ *  With a data channel, trail samples are batched through the MYP FX Subsystem. Otherwise a trail component is attached to each socket.
+ */
+UCLASS(BlueprintType)
+class UPlatformingTrailProfile : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Data channel the trail samples are written into, one per socket per frame. Takes priority over the trail system */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Trail")
+	TObjectPtr<UNiagaraDataChannelAsset> TrailDataChannel;
+
+	/** Trail particle system, attached to each trail socket when there's no data channel */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Trail")
+	TObjectPtr<UNiagaraSystem> TrailSystem;
+
+	/** Character mesh sockets to attach a trail to */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Trail")
+	TArray<FName> TrailSockets;
+
+	/** Color passed to the trail system */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Trail")
+	FLinearColor TrailColor = FLinearColor::White;
+
+	/** Name of the trail system's color user parameter */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Trail")
+	FName ColorParameter = FName(TEXT("Color"));
+
+	/** Played at the character's location whenever the trails turn on */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Trail")
+	FMYPFeedbackEffect TrailStartEffect;
+};
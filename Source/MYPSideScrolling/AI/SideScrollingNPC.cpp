@@ -3,23 +3,18 @@
 
 #include "SideScrollingNPC.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "TimerManager.h"
+#include "MYPTimerSubsystem.h"
+#include "MYPTickAudit.h"
+
+MYP_AUDIT_TICK(ASideScrollingNPC);
 
 ASideScrollingNPC::ASideScrollingNPC()
 {
- 	PrimaryActorTick.bCanEverTick = true;
+ 	PrimaryActorTick.bCanEverTick = false;
 
 	GetCharacterMovement()->MaxWalkSpeed = 150.0f;
 }
 
-void ASideScrollingNPC::EndPlay(EEndPlayReason::Type EndPlayReason)
-{
-	Super::EndPlay(EndPlayReason);
-
-	// clear the deactivation timer
-	GetWorld()->GetTimerManager().ClearTimer(DeactivationTimer);
-}
-
 void ASideScrollingNPC::Interaction(AActor* Interactor)
 {
 	// ignore if this NPC has already been deactivated
@@ -42,7 +37,10 @@ void ASideScrollingNPC::Interaction(AActor* Interactor)
 	LaunchCharacter(LaunchVector, true, true);
 
 	// set up a timer to schedule reactivation
-	GetWorld()->GetTimerManager().SetTimer(DeactivationTimer, this, &ASideScrollingNPC::ResetDeactivation, DeactivationTime, false);
+	if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+	{
+		Timers->SetTimer(DeactivationTimer, this, &ASideScrollingNPC::ResetDeactivation, DeactivationTime);
+	}
 }
 
 void ASideScrollingNPC::ResetDeactivation()
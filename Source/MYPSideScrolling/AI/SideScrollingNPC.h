@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "SideScrollingInteractable.h"
+#include "MYPTimerSubsystem.h"
 #include "SideScrollingNPC.generated.h"
 
 /**
@@ -38,18 +39,13 @@ public:
 	bool bDeactivated = false;
 
 	/** Timer to reactivate the NPC */
-	FTimerHandle DeactivationTimer;
+	FMYPTimerHandle DeactivationTimer;
 
 public:
 
 	/** Constructor */
 	ASideScrollingNPC();
 
-public:
-
-	/** Cleanup */
-	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
-
 public:
 
 //	~begin IInteractable interface 
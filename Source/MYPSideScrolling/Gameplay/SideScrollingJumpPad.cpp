@@ -6,11 +6,17 @@
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Components/SceneComponent.h"
+#include "MYPTickAudit.h"
+
+MYP_AUDIT_TICK(ASideScrollingJumpPad);
 
 ASideScrollingJumpPad::ASideScrollingJumpPad()
 {
 	PrimaryActorTick.bCanEverTick = false;
 
+	// nothing about the pad changes at runtime, so it doesn't replicate at all. Every machine launches the characters it simulates
+	bReplicates = false;
+
 	// create the root comp
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
 
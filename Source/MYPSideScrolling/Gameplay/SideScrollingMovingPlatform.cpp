@@ -0,0 +1,192 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingMovingPlatform.h"
+#include "Components/SceneComponent.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "MYPTickAudit.h"
+#include "MYP.h"
+
+MYP_AUDIT_TICK(ASideScrollingMovingPlatform);
+
+ASideScrollingMovingPlatform::ASideScrollingMovingPlatform()
+{
+	// only tick while a native move is running
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	// replicate the move state instead of the location. The platform stays dormant until an interaction starts or ends a move
+	bReplicates = true;
+	NetDormancy = DORM_Initial;
+
+	// create the root comp
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void ASideScrollingMovingPlatform::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// a Blueprint that implements Move to Target expects to move the platform itself
+	bUseBlueprintMovement |= GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(ASideScrollingMovingPlatform, BP_MoveToTarget));
+
+	// save the starting point for return trips
+	HomeLocation = GetActorLocation();
+
+	// clients joining after the platform moved find it at its target
+	if (bAtTarget && (!bMoving || bOneShot) && !bUseBlueprintMovement && !HasAuthority())
+	{
+		SetActorLocation(PlatformTarget);
+	}
+}
+
+void ASideScrollingMovingPlatform::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ASideScrollingMovingPlatform, bMoving, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ASideScrollingMovingPlatform, bAtTarget, Params);
+}
+
+void ASideScrollingMovingPlatform::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	MoveElapsed += DeltaSeconds;
+
+	const float Alpha = MoveDuration > 0.0f ? FMath::Clamp(MoveElapsed / MoveDuration, 0.0f, 1.0f) : 1.0f;
+
+	// ease in and out of the move
+	SetActorLocation(FMath::InterpEaseInOut(MoveStart, MoveEnd, Alpha, 2.0f));
+
+	// have we arrived?
+	if (Alpha >= 1.0f)
+	{
+		SetActorTickEnabled(false);
+
+		// clients only play the move out. The server decides where the platform ends up, and when it can move again
+		if (!HasAuthority())
+		{
+			return;
+		}
+
+		bAtTarget = !bAtTarget;
+
+		MARK_PROPERTY_DIRTY_FROM_NAME(ASideScrollingMovingPlatform, bAtTarget, this);
+		FlushNetDormancy();
+
+		ResetInteraction();
+	}
+}
+
+void ASideScrollingMovingPlatform::Interaction(AActor* Interactor)
+{
+	// the server runs the move and replicates it, so interactions are routed to it
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	// ignore interactions if we're already moving
+	if (bMoving)
+	{
+		return;
+	}
+
+	// raise the movement flag
+	SetMoving(true);
+
+	// pass control to BP for the actual movement if it's been opted into
+	if (bUseBlueprintMovement)
+	{
+		MYP_COUNT_BLUEPRINT_EVENT();
+		BP_MoveToTarget();
+		return;
+	}
+
+	StartMove();
+}
+
+void ASideScrollingMovingPlatform::StartMove()
+{
+	// move to the target, or back home if we're already there
+	MoveStart = GetActorLocation();
+	MoveEnd = bAtTarget ? HomeLocation : PlatformTarget;
+	MoveElapsed = 0.0f;
+
+	SetActorTickEnabled(true);
+}
+
+void ASideScrollingMovingPlatform::SetMoving(bool bNewMoving)
+{
+	bMoving = bNewMoving;
+
+	// wake the platform for the one update that carries the change
+	MARK_PROPERTY_DIRTY_FROM_NAME(ASideScrollingMovingPlatform, bMoving, this);
+	FlushNetDormancy();
+}
+
+void ASideScrollingMovingPlatform::OnRep_Moving()
+{
+	// Blueprint movement is left to the Blueprint, which may replicate it however it likes
+	if (bUseBlueprintMovement)
+	{
+		return;
+	}
+
+	// a one-shot platform keeps its moving flag once it has arrived, so a late joiner only needs it put at the target
+	if (bMoving && bOneShot && bAtTarget)
+	{
+		SetActorTickEnabled(false);
+
+		if (HasActorBegunPlay())
+		{
+			SetActorLocation(PlatformTarget);
+		}
+
+		return;
+	}
+
+	if (bMoving)
+	{
+		StartMove();
+	}
+	else
+	{
+		// the server got there first, stop where it says the platform is
+		SetActorTickEnabled(false);
+	}
+}
+
+void ASideScrollingMovingPlatform::OnRep_AtTarget()
+{
+	// snap to the server's end of the track, unless a move is playing or BeginPlay hasn't saved the home location yet
+	if (bUseBlueprintMovement || bMoving || !HasActorBegunPlay() || HasAuthority())
+	{
+		return;
+	}
+
+	SetActorLocation(bAtTarget ? PlatformTarget : HomeLocation);
+}
+
+void ASideScrollingMovingPlatform::ResetInteraction()
+{
+	// only the server resets the movement flag, clients get it replicated
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	// ignore if this is a one-shot platform
+	if (bOneShot)
+	{
+		return;
+	}
+
+	// reset the movement flag
+	SetMoving(false);
+}
@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SideScrollingInteractable.h"
+#include "SideScrollingMovingPlatform.generated.h"
+
+/**
+ *  Simple moving platform that can be triggered through interactions by other actors.
+ *  The platform moves natively to its target, and back to its starting point on the next interaction.
+ *  Blueprint movement through latent execution nodes can be opted into instead.
+ *  Only the moving and at target flags replicate. Clients play each move locally, so the platform stays net dormant while it travels.
+ */
+UCLASS(abstract)
+class ASideScrollingMovingPlatform : public AActor, public ISideScrollingInteractable
+{
+	GENERATED_BODY()
+	
+public:	
+	
+	/** Constructor */
+	ASideScrollingMovingPlatform();
+
+protected:
+
+	/** If this is true, the platform is mid-movement and will ignore further interactions */
+	UPROPERTY(ReplicatedUsing=OnRep_Moving)
+	bool bMoving = false;
+
+	/** Destination of the platform in world space */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Moving Platform")
+	FVector PlatformTarget;
+
+	/** Time for the platform to move to the destination */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Moving Platform", meta = (ClampMin = 0, ClampMax = 10, Units="s"))
+	float MoveDuration = 5.0f;
+
+	/** If this is true, the platform will only move once. */
+	UPROPERTY(EditAnywhere, Category="Moving Platform")
+	bool bOneShot = false;
+
+	/** If this is true, Move to Target is called and Blueprint code is responsible for moving the platform and resetting it. Set automatically for Blueprints that implement Move to Target */
+	UPROPERTY(EditAnywhere, Category="Moving Platform")
+	bool bUseBlueprintMovement = false;
+
+	/** World location the current move started from */
+	FVector MoveStart = FVector::ZeroVector;
+
+	/** World location the current move ends at */
+	FVector MoveEnd = FVector::ZeroVector;
+
+	/** Location the platform goes back to on its return trip */
+	FVector HomeLocation = FVector::ZeroVector;
+
+	/** Time spent on the current move */
+	float MoveElapsed = 0.0f;
+
+	/** If this is true, the platform is at its target and the next move takes it home */
+	UPROPERTY(ReplicatedUsing=OnRep_AtTarget)
+	bool bAtTarget = false;
+
+protected:
+
+	/** Initialization */
+	virtual void BeginPlay() override;
+
+	/** Registers the replicated movement state */
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Starts a native move to the target, or back home */
+	void StartMove();
+
+	/** Sets the moving flag, and sends it to clients */
+	void SetMoving(bool bNewMoving);
+
+	/** Starts or ends the move on clients */
+	UFUNCTION()
+	void OnRep_Moving();
+
+	/** Puts the platform where the server has it on clients that weren't there for the move */
+	UFUNCTION()
+	void OnRep_AtTarget();
+
+public:
+
+	/** Moves the platform while a native move is running */
+	virtual void Tick(float DeltaSeconds) override;
+
+// ~begin IInteractable interface 
+
+	/** Performs an interaction triggered by another actor */
+	virtual void Interaction(AActor* Interactor) override;
+
+// ~end IInteractable interface
+
+	/** Resets the interaction state. Called when a native move ends, and must be called from BP code when using Blueprint movement */
+	UFUNCTION(BlueprintCallable, Category="Moving Platform")
+	virtual void ResetInteraction();
+
+protected:
+
+	/** Allows Blueprint code to do the actual platform movement */
+	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category="Moving Platform", meta = (DisplayName="Move to Target"))
+	void BP_MoveToTarget();
+
+};
@@ -0,0 +1,126 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingPickup.h"
+#include "GameFramework/Character.h"
+#include "SideScrollingGameMode.h"
+#include "Components/SphereComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "MYPTickAudit.h"
+#include "MYP.h"
+
+MYP_AUDIT_TICK(ASideScrollingPickup);
+
+ASideScrollingPickup::ASideScrollingPickup()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// replicate the collected state, but keep the pickup dormant until it's collected
+	bReplicates = true;
+	NetDormancy = DORM_Initial;
+
+	// create the root comp
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	// create the bounding sphere
+	Sphere = CreateDefaultSubobject<USphereComponent>(TEXT("Collision"));
+	Sphere->SetupAttachment(RootComponent);
+
+	Sphere->SetSphereRadius(100.0f);
+
+	Sphere->SetCollisionObjectType(ECC_WorldDynamic);
+	Sphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	Sphere->SetCollisionResponseToAllChannels(ECR_Ignore);
+	Sphere->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
+
+	// add the overlap handler
+	OnActorBeginOverlap.AddDynamic(this, &ASideScrollingPickup::BeginOverlap);
+}
+
+void ASideScrollingPickup::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Blueprints written before the native feedback existed only implement On Picked Up, so keep calling it for them
+	bUseBlueprintPickup |= GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(ASideScrollingPickup, BP_OnPickedUp));
+}
+
+void ASideScrollingPickup::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
+{
+	// have we collided against a character?
+	if (ACharacter* OverlappedCharacter = Cast<ACharacter>(OtherActor))
+	{
+		// is this the player character?
+		if (OverlappedCharacter->IsPlayerControlled())
+		{
+			// get the game mode
+			if (ASideScrollingGameMode* GM = Cast<ASideScrollingGameMode>(GetWorld()->GetAuthGameMode()))
+			{
+				// tell the game mode to process a pickup
+				GM->ProcessPickup();
+
+				// disable collision so we don't get picked up again
+				SetActorEnableCollision(false);
+
+				// let the clients know
+				bCollected = true;
+
+				MARK_PROPERTY_DIRTY_FROM_NAME(ASideScrollingPickup, bCollected, this);
+				FlushNetDormancy();
+
+				// Call the BP handler if it's been opted into. It will be responsible for destroying the pickup
+				if (bUseBlueprintPickup)
+				{
+					MYP_COUNT_BLUEPRINT_EVENT();
+					BP_OnPickedUp();
+					return;
+				}
+
+				// otherwise play the feedback and remove the pickup ourselves
+				PickupFeedback.Play(this, GetActorLocation(), GetActorRotation());
+
+				// destroying right away would close the channel before the collected state goes out, so hide the pickup and let clients catch up
+				if (IsNetMode(NM_Standalone))
+				{
+					Destroy();
+				}
+				else
+				{
+					SetActorHiddenInGame(true);
+					SetLifeSpan(FMath::Max(CollectedLifeSpan, KINDA_SMALL_NUMBER));
+				}
+			}
+		}
+	}
+}
+
+void ASideScrollingPickup::OnRep_Collected()
+{
+	if (!bCollected)
+	{
+		return;
+	}
+
+	SetActorEnableCollision(false);
+
+	// Blueprint pickups play their effects on the server only, since their handler destroys the pickup
+	if (!bUseBlueprintPickup)
+	{
+		PickupFeedback.Play(this, GetActorLocation(), GetActorRotation());
+
+		SetActorHiddenInGame(true);
+	}
+}
+
+void ASideScrollingPickup::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ASideScrollingPickup, bCollected, Params);
+}
\ No newline at end of file
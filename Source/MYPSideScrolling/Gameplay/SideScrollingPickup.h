@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "MYPFeedbackEffect.h"
+#include "SideScrollingPickup.generated.h"
+
+class USphereComponent;
+
+/**
+ *  A simple side scrolling game pickup
+ *  Increments a counter on the GameMode
+ */
+UCLASS(abstract)
+class ASideScrollingPickup : public AActor
+{
+	GENERATED_BODY()
+	
+	/** Pickup bounding sphere */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
+	USphereComponent* Sphere;
+
+public:
+
+	/** Constructor */
+	ASideScrollingPickup();
+
+protected:
+
+	/** Effect and sound played natively when picked up */
+	UPROPERTY(EditAnywhere, Category="Pickup")
+	FMYPFeedbackEffect PickupFeedback;
+
+	/** If true, On Picked Up is called instead of playing the pickup feedback, and the Blueprint must destroy the pickup. Turned on at BeginPlay when the Blueprint implements On Picked Up */
+	UPROPERTY(EditAnywhere, Category="Pickup")
+	bool bUseBlueprintPickup = false;
+
+	/** Time a collected pickup is kept around hidden in networked games, so clients receive the collected state before it's destroyed */
+	UPROPERTY(EditAnywhere, Category="Pickup", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
+	float CollectedLifeSpan = 1.0f;
+
+	/** Set on the server when the pickup is collected. Pushed to clients once, the pickup stays dormant until then */
+	UPROPERTY(ReplicatedUsing=OnRep_Collected)
+	bool bCollected = false;
+
+	/** Initialization */
+	virtual void BeginPlay() override;
+
+	/** Handles pickup collision */
+	UFUNCTION()
+	void BeginOverlap(AActor* OverlappedActor, AActor* OtherActor);
+
+	/** Plays the pickup feedback on clients and hides the pickup */
+	UFUNCTION()
+	void OnRep_Collected();
+
+	/** Registers the replicated collected flag */
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Passes control to BP to play effects on pickup */
+	UFUNCTION(BlueprintImplementableEvent, Category="Pickup", meta = (DisplayName = "On Picked Up"))
+	void BP_OnPickedUp();
+};
@@ -6,10 +6,13 @@
 #include "Components/StaticMeshComponent.h"
 #include "Components/BoxComponent.h"
 #include "SideScrollingCharacter.h"
+#include "MYPTickAudit.h"
+
+MYP_AUDIT_TICK(ASideScrollingSoftPlatform);
 
 ASideScrollingSoftPlatform::ASideScrollingSoftPlatform()
 {
- 	PrimaryActorTick.bCanEverTick = true;
+ 	PrimaryActorTick.bCanEverTick = false;
 
 	// create the root component
 	RootComponent = Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class MYPSideScrolling : ModuleRules
+{
+	public MYPSideScrolling(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] {
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"InputCore",
+			"EnhancedInput",
+			"AIModule",
+			"StateTreeModule",
+			"GameplayStateTreeModule",
+			"UMG",
+			"Slate",
+			"MYP"
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "NetCore" });
+
+		// nothing outside this module includes its headers, so its folders stay private
+		PrivateIncludePaths.AddRange(new string[] {
+			"MYPSideScrolling",
+			"MYPSideScrolling/AI",
+			"MYPSideScrolling/Gameplay",
+			"MYPSideScrolling/Interfaces",
+			"MYPSideScrolling/UI"
+		});
+	}
+}
@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MYPBenchmark.h"
+
+#if MYP_WITH_BENCHMARKS
+
+#include "Engine/HitResult.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "SideScrollingCharacter.h"
+#include "SideScrollingCameraManager.h"
+
+namespace SideScrollingBenchmarks
+{
+	static const TCHAR* CharacterClassPath = TEXT("/Game/Variant_SideScrolling/Blueprints/BP_SideScrollingCharacter.BP_SideScrollingCharacter_C");
+	static const TCHAR* CameraManagerClassPath = TEXT("/Game/Variant_SideScrolling/Blueprints/BP_SideScrollingCameraManager.BP_SideScrollingCameraManager_C");
+
+	/** Both jump paths of the side scrolling character */
+	static void MeasureMultiJump(FMYPBenchmarkContext& Context, ASideScrollingCharacter* Character)
+	{
+		// landing resets the double jump, so every iteration takes the same path. The override is protected, so go through the base class
+		const auto ResetJump = [Character]()
+		{
+			Character->StopJumping();
+			static_cast<ACharacter*>(Character)->Landed(FHitResult());
+		};
+
+		// a regular jump
+		Context.Measure(TEXT("MultiJump.Grounded"), [](){}, [Character]() { Character->DoJumpStart(); }, ResetJump);
+
+		// high in the air and past coyote time, holding a direction so the wall jump trace runs and misses before the double jump
+		Character->SetActorLocation(FVector(0.0f, 0.0f, 5000.0f));
+		Character->GetCharacterMovement()->SetMovementMode(MOVE_Falling);
+		Character->DoMove(1.0f);
+
+		Context.TickWorld(0.25f);
+
+		Context.Measure(TEXT("MultiJump.Airborne"), [](){}, [Character]() { Character->DoJumpStart(); }, ResetJump);
+	}
+
+	/** Camera updates following a grounded and a falling character. The falling one traces for the ground */
+	static void MeasureCamera(FMYPBenchmarkContext& Context, UClass* CameraManagerClass, ASideScrollingCharacter* Character)
+	{
+		ASideScrollingCameraManager* CameraManager = Context.SpawnActor<ASideScrollingCameraManager>(CameraManagerClass, FVector::ZeroVector);
+
+		if (!CameraManager)
+		{
+			return;
+		}
+
+		FTViewTarget ViewTarget;
+		ViewTarget.Target = Character;
+
+		// the first update only sets the camera up
+		CameraManager->UpdateViewTarget(ViewTarget, 1.0f / 60.0f);
+
+		Character->GetCharacterMovement()->Velocity = FVector::ZeroVector;
+
+		Context.Measure(TEXT("Camera.UpdateViewTarget.Grounded"), [CameraManager, &ViewTarget]()
+		{
+			CameraManager->UpdateViewTarget(ViewTarget, 1.0f / 60.0f);
+		});
+
+		Character->GetCharacterMovement()->Velocity = FVector(0.0f, 0.0f, -500.0f);
+
+		Context.Measure(TEXT("Camera.UpdateViewTarget.Falling"), [CameraManager, &ViewTarget]()
+		{
+			CameraManager->UpdateViewTarget(ViewTarget, 1.0f / 60.0f);
+		});
+
+		CameraManager->Destroy();
+	}
+
+	static void Run(FMYPBenchmarkContext& Context)
+	{
+		Context.SpawnFloor();
+
+		const TSubclassOf<ASideScrollingCharacter> CharacterClass = Context.LoadBlueprintClass<ASideScrollingCharacter>(CharacterClassPath);
+		const TSubclassOf<ASideScrollingCameraManager> CameraManagerClass = Context.LoadBlueprintClass<ASideScrollingCameraManager>(CameraManagerClassPath);
+
+		if (!CharacterClass)
+		{
+			return;
+		}
+
+		ASideScrollingCharacter* Character = Context.SpawnActor<ASideScrollingCharacter>(CharacterClass, FVector(0.0f, 0.0f, 100.0f));
+
+		if (!Character)
+		{
+			return;
+		}
+
+		// settle on the floor
+		for (int32 Frame = 0; Frame < 30; ++Frame)
+		{
+			Context.TickWorld();
+		}
+
+		if (CameraManagerClass)
+		{
+			MeasureCamera(Context, CameraManagerClass, Character);
+		}
+
+		MeasureMultiJump(Context, Character);
+
+		Character->Destroy();
+	}
+
+	static FMYPBenchmarkSuite Suite(TEXT("SideScrolling"), &Run);
+}
+
+#endif // MYP_WITH_BENCHMARKS
@@ -12,11 +12,14 @@
 #include "Engine/World.h"
 #include "SideScrollingInteractable.h"
 #include "Kismet/KismetMathLibrary.h"
-#include "TimerManager.h"
+#include "MYPTimerSubsystem.h"
+#include "MYPTickAudit.h"
+
+MYP_AUDIT_TICK(ASideScrollingCharacter);
 
 ASideScrollingCharacter::ASideScrollingCharacter()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	// create the camera component
 	Camera = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera"));
@@ -59,14 +62,6 @@ ASideScrollingCharacter::ASideScrollingCharacter()
 	JumpMaxCount = 3;
 }
 
-void ASideScrollingCharacter::EndPlay(EEndPlayReason::Type EndPlayReason)
-{
-	Super::EndPlay(EndPlayReason);
-
-	// clear the wall jump timer
-	GetWorld()->GetTimerManager().ClearTimer(WallJumpTimer);
-}
-
 void ASideScrollingCharacter::SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent)
 {
 	Super::SetupPlayerInputComponent(PlayerInputComponent);
@@ -188,6 +183,13 @@ void ASideScrollingCharacter::DoJumpEnd()
 
 void ASideScrollingCharacter::DoInteract()
 {
+	// interactables change replicated state, so clients ask the server to interact for them
+	if (!HasAuthority())
+	{
+		ServerInteract();
+		return;
+	}
+
 	// do a sphere trace to look for interactive objects
 	FHitResult OutHit;
 
@@ -215,6 +217,11 @@ void ASideScrollingCharacter::DoInteract()
 	}
 }
 
+void ASideScrollingCharacter::ServerInteract_Implementation()
+{
+	DoInteract();
+}
+
 void ASideScrollingCharacter::MultiJump()
 {
 	// does the user want to drop to a lower platform?
@@ -265,7 +272,10 @@ void ASideScrollingCharacter::MultiJump()
 			bHasWallJumped = true;
 
 			// schedule wall jump lockout reset
-			GetWorld()->GetTimerManager().SetTimer(WallJumpTimer, this, &ASideScrollingCharacter::ResetWallJump, DelayBetweenWallJumps, false);
+			if (UMYPTimerSubsystem* Timers = UMYPTimerSubsystem::Get(this))
+			{
+				Timers->SetTimer(WallJumpTimer, this, &ASideScrollingCharacter::ResetWallJump, DelayBetweenWallJumps);
+			}
 
 			return;
 		}
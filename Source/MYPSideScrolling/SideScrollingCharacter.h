@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "MYPTimerSubsystem.h"
 #include "SideScrollingCharacter.generated.h"
 
 class UCameraComponent;
@@ -80,7 +81,7 @@ protected:
 	float MaxCoyoteTime = 0.16f;
 
 	/** Wall jump lockout timer */
-	FTimerHandle WallJumpTimer;
+	FMYPTimerHandle WallJumpTimer;
 
 	/** Last captured horizontal movement input value */
 	float ActionValueY = 0.0f;
@@ -104,9 +105,6 @@ public:
 
 protected:
 
-	/** Gameplay cleanup */
-	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
-
 	/** Initialize input action bindings */
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
@@ -154,6 +152,10 @@ public:
 
 protected:
 
+	/** Runs an interaction requested by the owning client on the server, which owns the interactables' state */
+	UFUNCTION(Server, Reliable)
+	void ServerInteract();
+
 	/** Handles advanced jump logic */
 	void MultiJump();
 
@@ -4,7 +4,7 @@
 #include "SideScrollingPlayerController.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputMappingContext.h"
-#include "Kismet/GameplayStatics.h"
+#include "EngineUtils.h"
 #include "GameFramework/PlayerStart.h"
 #include "SideScrollingCharacter.h"
 #include "Engine/LocalPlayer.h"
@@ -72,14 +72,13 @@ void ASideScrollingPlayerController::OnPossess(APawn* InPawn)
 
 void ASideScrollingPlayerController::OnPawnDestroyed(AActor* DestroyedActor)
 {
-	// find the player start
-	TArray<AActor*> ActorList;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), APlayerStart::StaticClass(), ActorList);
+	// find the first player start, without gathering every one of them into an array
+	TActorIterator<APlayerStart> PlayerStartIt(GetWorld());
 
-	if (ActorList.Num() > 0)
+	if (PlayerStartIt)
 	{
 		// spawn a character at the player start
-		const FTransform SpawnTransform = ActorList[0]->GetActorTransform();
+		const FTransform SpawnTransform = PlayerStartIt->GetActorTransform();
 
 		if (ASideScrollingCharacter* RespawnedCharacter = GetWorld()->SpawnActor<ASideScrollingCharacter>(CharacterClass, SpawnTransform))
 		{